@@ -0,0 +1,39 @@
+//
+// Collectives benchmark, shared by the e-core program(e_collective.c) and
+// host.c.
+//
+#ifndef COLLECTIVE_H_
+#define COLLECTIVE_H_
+
+#define COLL_BENCH_REPEAT (64) // back-to-back calls per measurement
+
+// Group shapes, one table row each. Shapes larger than the chip are skipped.
+#define COLL_BENCH_NUM_SHAPES (7)
+#define COLL_BENCH_SHAPES \
+	{{1, 1}, {1, 2}, {2, 2}, {2, 4}, {4, 4}, {4, 8}, {8, 8}}
+
+enum {
+	COLL_BENCH_BARRIER = 0,
+	COLL_BENCH_BROADCAST,
+	COLL_BENCH_REDUCE,
+	COLL_BENCH_ALLREDUCE,
+	COLL_BENCH_NUM_OPS,
+};
+
+// Words per broadcast/reduce, validateExp()'s (ave, min, max).
+#define COLL_BENCH_WORDS (3)
+
+typedef struct {
+	unsigned int rows, cols;
+	unsigned int clocks[COLL_BENCH_NUM_OPS]; // per call, on core (0, 0)
+	unsigned int errors; // wrong results, summed over the group
+} coll_bench_row_t;
+
+// Written by core (0, 0) at E_SHM_MSG_OFFSET, `done` last.
+typedef struct {
+	unsigned int num_rows;
+	unsigned int done;
+	coll_bench_row_t rows[COLL_BENCH_NUM_SHAPES];
+} coll_bench_result_t;
+
+#endif // COLLECTIVE_H_
@@ -0,0 +1,157 @@
+//
+// Collectives benchmark, e-core side. Runs on every core of the workgroup.
+//
+// For each group shape in COLL_BENCH_SHAPES that fits the chip, core (0, 0)
+// times COLL_BENCH_REPEAT back-to-back calls of e_coll_barrier(),
+// e_coll_broadcast(), e_coll_reduce() and e_coll_allreduce() over
+// COLL_BENCH_WORDS floats(../common/e_coll.h). Back-to-back reduces and
+// broadcasts overlap with each other as far as the acks allow, barrier and
+// all-reduce can't.
+//
+// Then every core checks broadcast, sum/min/max all-reduce and reduce
+// results against the closed form and the error counts are reduced onto core
+// (0, 0), which writes the table to shared DRAM(coll_bench_result_t).
+//
+#include <stdlib.h>
+
+#include "e_lib.h"
+
+#include "collective.h"
+#include "e_banks.h"
+#include "e_coll.h"
+#include "e_shm.h"
+
+static const unsigned int gShapes[COLL_BENCH_NUM_SHAPES][2] =
+	COLL_BENCH_SHAPES;
+
+static unsigned int clock_start(void)
+{
+	e_ctimer_set(E_CTIMER_0, E_CTIMER_MAX);
+	return e_ctimer_start(E_CTIMER_0, E_CTIMER_CLK);
+}
+
+static unsigned int clock_stop(unsigned int time_p)
+{
+	return time_p - e_ctimer_stop(E_CTIMER_0);
+}
+
+static unsigned int run_op(const e_coll_group_t *all,
+			   const e_coll_group_t *g, int op)
+{
+	float v[COLL_BENCH_WORDS] = {1.0f, 2.0f, 3.0f};
+	unsigned int time_p, r;
+
+	e_coll_barrier(all);
+	time_p = clock_start();
+	for (r = 0; r < COLL_BENCH_REPEAT; r++) {
+		switch (op) {
+		case COLL_BENCH_BARRIER:
+			e_coll_barrier(g);
+			break;
+		case COLL_BENCH_BROADCAST:
+			e_coll_broadcast(g, v, COLL_BENCH_WORDS);
+			break;
+		case COLL_BENCH_REDUCE:
+			e_coll_reduce(g, v, COLL_BENCH_WORDS, E_COLL_MAX);
+			break;
+		case COLL_BENCH_ALLREDUCE:
+			e_coll_allreduce(g, v, COLL_BENCH_WORDS, E_COLL_MAX);
+			break;
+		}
+	}
+	return clock_stop(time_p) / COLL_BENCH_REPEAT;
+}
+
+// Number of wrong results on this core.
+static unsigned int check(const e_coll_group_t *g)
+{
+	const int inside = (g->row < g->rows) && (g->col < g->cols);
+	const float n = (float)(g->rows * g->cols);
+	const float k = (float)(g->row * g->cols + g->col + 1);
+	const int root = (g->row == 0) && (g->col == 0);
+	float v[COLL_BENCH_WORDS];
+	unsigned int errors = 0;
+	int op, i;
+
+	for (i = 0; i < COLL_BENCH_WORDS; i++) {
+		v[i] = root ? (float)(i + 7) : 0.0f;
+	}
+	e_coll_broadcast(g, v, COLL_BENCH_WORDS);
+	for (i = 0; i < COLL_BENCH_WORDS; i++) {
+		errors += inside && (v[i] != (float)(i + 7));
+	}
+
+	for (op = E_COLL_SUM; op <= E_COLL_MAX; op++) {
+		float expect;
+
+		for (i = 0; i < COLL_BENCH_WORDS; i++) {
+			v[i] = k;
+		}
+		e_coll_allreduce(g, v, COLL_BENCH_WORDS, op);
+		expect = (op == E_COLL_SUM)   ? n * (n + 1.0f) * 0.5f
+			 : (op == E_COLL_MIN) ? 1.0f
+					      : n;
+		for (i = 0; i < COLL_BENCH_WORDS; i++) {
+			errors += inside && (v[i] != expect);
+		}
+	}
+
+	v[0] = k;
+	e_coll_reduce(g, v, 1, E_COLL_SUM);
+	errors += root && (v[0] != n * (n + 1.0f) * 0.5f);
+
+	return errors;
+}
+
+int main(void)
+{
+	coll_bench_result_t *res =
+		(coll_bench_result_t *)E_SHM_PTR(E_SHM_MSG_OFFSET);
+	const unsigned int rows = e_group_config.group_rows;
+	const unsigned int cols = e_group_config.group_cols;
+	const int root = (e_group_config.core_row == 0) &&
+			 (e_group_config.core_col == 0);
+	e_coll_group_t all, g;
+	unsigned int s;
+	int op;
+
+	e_coll_group(&all, rows, cols);
+	if (root) {
+		res->num_rows = 0;
+		res->done = 0;
+	}
+
+	for (s = 0; s < COLL_BENCH_NUM_SHAPES; s++) {
+		unsigned int clocks[COLL_BENCH_NUM_OPS];
+		float errors;
+
+		if ((gShapes[s][0] > rows) || (gShapes[s][1] > cols)) {
+			continue;
+		}
+		e_coll_group(&g, gShapes[s][0], gShapes[s][1]);
+
+		for (op = 0; op < COLL_BENCH_NUM_OPS; op++) {
+			clocks[op] = run_op(&all, &g, op);
+		}
+		errors = (float)check(&g);
+		e_coll_reduce(&all, &errors, 1, E_COLL_SUM);
+
+		if (root) {
+			coll_bench_row_t *row = &res->rows[res->num_rows];
+			row->rows = g.rows;
+			row->cols = g.cols;
+			for (op = 0; op < COLL_BENCH_NUM_OPS; op++) {
+				row->clocks[op] = clocks[op];
+			}
+			row->errors = (unsigned int)errors;
+			res->num_rows++;
+		}
+	}
+
+	e_coll_barrier(&all);
+	if (root) {
+		res->done = 1;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,134 @@
+//
+// HOST side of the collectives benchmark(e_collective.c).
+//
+// Clears the collectives mailbox of every core, runs the e-core side on the
+// whole chip and prints per-call clocks(and us) of barrier, broadcast, reduce
+// and all-reduce by group size. Next to them is what the host pays to gather
+// COLL_BENCH_WORDS floats from the same cores one e_read() at a time, which
+// is how results are aggregated without collectives.
+//
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <e-hal.h>
+
+#include "collective.h"
+#include "e_banks.h"
+#include "e_coll.h"
+#include "e_shm.h"
+
+#define HOST_REPEAT (64)
+#define CLOCK_MHZ (600.0)
+#define WAIT_DONE_MICROSECONDS (10000000)
+
+static double now_usec(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec * 1e-3;
+}
+
+// us to read and combine COLL_BENCH_WORDS floats from each core of the
+// rows x cols rectangle, best of HOST_REPEAT.
+static double host_gather(e_epiphany_t *dev, unsigned rows, unsigned cols)
+{
+	double best = 1e30;
+	float v[COLL_BENCH_WORDS], acc[COLL_BENCH_WORDS];
+	unsigned r, i, j, w;
+
+	for (r = 0; r < HOST_REPEAT; r++) {
+		double t0 = now_usec();
+		memset(acc, 0, sizeof(acc));
+		for (i = 0; i < rows; i++) {
+			for (j = 0; j < cols; j++) {
+				e_read(dev, i, j, E_MAILBOX_ADDR, v, sizeof(v));
+				for (w = 0; w < COLL_BENCH_WORDS; w++) {
+					acc[w] = (v[w] > acc[w]) ? v[w] : acc[w];
+				}
+			}
+		}
+		t0 = now_usec() - t0;
+		best = (t0 < best) ? t0 : best;
+	}
+	return best;
+}
+
+int main(int argc, char *argv[])
+{
+	static const char *names[COLL_BENCH_NUM_OPS] = {"barrier", "bcast",
+							"reduce", "allreduce"};
+	e_platform_t platform;
+	e_epiphany_t dev;
+	e_mem_t msg;
+	e_coll_mbox_t zero;
+	coll_bench_result_t *res;
+	double t0;
+	unsigned i, j, k;
+	int errors = 0;
+
+	e_init(NULL);
+	e_reset_system();
+	e_get_platform_info(&platform);
+
+	e_alloc(&msg, E_SHM_MSG_OFFSET, sizeof(coll_bench_result_t));
+	res = (coll_bench_result_t *)msg.base;
+	memset(res, 0, sizeof(*res));
+
+	e_open(&dev, 0, 0, platform.rows, platform.cols);
+	e_load_group((argc > 1) ? argv[1] : "e_collective.srec", &dev, 0, 0,
+		     platform.rows, platform.cols, E_FALSE);
+
+	// Local memory isn't cleared by the loader.
+	memset(&zero, 0, sizeof(zero));
+	for (i = 0; i < platform.rows; i++) {
+		for (j = 0; j < platform.cols; j++) {
+			e_write(&dev, i, j, E_COLL_ADDR, &zero, sizeof(zero));
+		}
+	}
+	e_start_group(&dev);
+
+	t0 = now_usec();
+	while (!res->done) {
+		if (now_usec() - t0 > WAIT_DONE_MICROSECONDS) {
+			fprintf(stderr, "??? collectives did not finish\n");
+			return EXIT_FAILURE;
+		}
+		usleep(1000);
+	}
+
+	fprintf(stderr, "[collective] %u x %u cores, %u words, clocks(us) per "
+			"call\n",
+		platform.rows, platform.cols, COLL_BENCH_WORDS);
+	fprintf(stderr, "%5s %5s |", "cores", "shape");
+	for (k = 0; k < COLL_BENCH_NUM_OPS; k++) {
+		fprintf(stderr, " %16s", names[k]);
+	}
+	fprintf(stderr, " | %11s\n", "host gather");
+	for (i = 0; (i < res->num_rows) && (i < COLL_BENCH_NUM_SHAPES); i++) {
+		const coll_bench_row_t *row = &res->rows[i];
+		char shape[16];
+
+		snprintf(shape, sizeof(shape), "%ux%u", row->rows, row->cols);
+		fprintf(stderr, "%5u %5s |", row->rows * row->cols, shape);
+		for (k = 0; k < COLL_BENCH_NUM_OPS; k++) {
+			fprintf(stderr, " %7u(%6.2fus)", row->clocks[k],
+				row->clocks[k] / CLOCK_MHZ);
+		}
+		fprintf(stderr, " | %9.2fus", host_gather(&dev, row->rows,
+							  row->cols));
+		if (row->errors) {
+			fprintf(stderr, " ??? %u wrong results", row->errors);
+			errors++;
+		}
+		fprintf(stderr, "\n");
+	}
+
+	e_close(&dev);
+	e_free(&msg);
+	e_finalize();
+
+	return errors ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,205 @@
+//
+// First-fit arena allocator over shared DRAM. See e_arena.h.
+//
+#include <string.h>
+
+#include "e_arena.h"
+
+static void insert_block(e_arena_t *arena, unsigned at,
+			 const e_arena_block_t *b)
+{
+	memmove(&arena->blocks[at + 1], &arena->blocks[at],
+		(arena->num_blocks - at) * sizeof(e_arena_block_t));
+	arena->blocks[at] = *b;
+	arena->num_blocks++;
+}
+
+static void remove_block(e_arena_t *arena, unsigned at)
+{
+	memmove(&arena->blocks[at], &arena->blocks[at + 1],
+		(arena->num_blocks - at - 1) * sizeof(e_arena_block_t));
+	arena->num_blocks--;
+}
+
+// Merges free block `at` with free neighbours. Returns the index of the
+// merged block.
+static unsigned merge_free(e_arena_t *arena, unsigned at)
+{
+	e_arena_block_t *b = &arena->blocks[at];
+
+	if ((at + 1 < arena->num_blocks) && !arena->blocks[at + 1].used) {
+		b->size += arena->blocks[at + 1].size;
+		remove_block(arena, at + 1);
+	}
+	if ((at > 0) && !arena->blocks[at - 1].used) {
+		arena->blocks[at - 1].size += b->size;
+		remove_block(arena, at);
+		at--;
+	}
+	return at;
+}
+
+// Marks block `at` free and merges it with free neighbours.
+static void release_block(e_arena_t *arena, unsigned at)
+{
+	e_arena_block_t *b = &arena->blocks[at];
+
+	arena->used -= b->size;
+	b->used = 0;
+	b->job = 0;
+	merge_free(arena, at);
+}
+
+int e_arena_init(e_arena_t *arena, uint32_t offset, uint32_t size)
+{
+	e_arena_block_t whole;
+
+	memset(arena, 0, sizeof(*arena));
+	if (e_alloc(&arena->mem, offset, size) != E_OK) {
+		return E_ERR;
+	}
+	arena->base = offset;
+	arena->size = size;
+
+	whole.off = 0;
+	whole.size = size;
+	whole.job = 0;
+	whole.used = 0;
+	insert_block(arena, 0, &whole);
+
+	return E_OK;
+}
+
+void e_arena_destroy(e_arena_t *arena)
+{
+	e_free(&arena->mem);
+	arena->num_blocks = 0;
+}
+
+int e_arena_alloc(e_arena_t *arena, uint32_t size, uint32_t align,
+		  uint32_t job, e_buf_t *buf)
+{
+	unsigned i;
+
+	// The address rounding below is a mask.
+	if ((align & (align - 1)) != 0) {
+		return E_ERR;
+	}
+	align = (align < E_ARENA_MIN_ALIGN) ? E_ARENA_MIN_ALIGN : align;
+	size = (size + E_ARENA_MIN_ALIGN - 1) & ~(E_ARENA_MIN_ALIGN - 1);
+	if (size == 0) {
+		size = E_ARENA_MIN_ALIGN;
+	}
+
+	for (i = 0; i < arena->num_blocks; i++) {
+		e_arena_block_t *b = &arena->blocks[i];
+		// Align the shared DRAM address, not the arena relative offset.
+		uint32_t addr = (arena->base + b->off + align - 1) & ~(align - 1);
+		uint32_t pad = addr - (arena->base + b->off);
+
+		if (b->used || (b->size < pad + size)) {
+			continue;
+		}
+		// Need up to two extra blocks for the head padding and the tail.
+		if (arena->num_blocks + 2 > E_ARENA_MAX_BLOCKS) {
+			return E_ERR;
+		}
+
+		b->used = 1;
+		b->job = job;
+		if (b->size > pad + size) {
+			e_arena_block_t tail = *b;
+			tail.off += pad + size;
+			tail.size -= pad + size;
+			tail.used = 0;
+			tail.job = 0;
+			b->size = pad + size;
+			insert_block(arena, i + 1, &tail);
+			merge_free(arena, i + 1);
+		}
+		// The padding goes back to the free list like a freed block,
+		// merged with a free predecessor.
+		if (pad > 0) {
+			e_arena_block_t head = arena->blocks[i];
+			head.size = pad;
+			head.used = 0;
+			head.job = 0;
+			arena->blocks[i].off += pad;
+			arena->blocks[i].size -= pad;
+			insert_block(arena, i, &head);
+			i = merge_free(arena, i) + 1;
+		}
+		b = &arena->blocks[i];
+
+		arena->used += size;
+		arena->peak = (arena->used > arena->peak) ? arena->used
+							  : arena->peak;
+
+		buf->ptr = (char *)arena->mem.base + b->off;
+		buf->off = arena->base + b->off;
+		buf->size = size;
+		return E_OK;
+	}
+
+	return E_ERR;
+}
+
+void e_arena_free(e_arena_t *arena, e_buf_t *buf)
+{
+	unsigned i;
+	uint32_t off = buf->off - arena->base;
+
+	for (i = 0; i < arena->num_blocks; i++) {
+		if (arena->blocks[i].used && (arena->blocks[i].off == off)) {
+			release_block(arena, i);
+			break;
+		}
+	}
+	buf->ptr = NULL;
+	buf->size = 0;
+}
+
+unsigned e_arena_free_job(e_arena_t *arena, uint32_t job)
+{
+	unsigned i = 0, n = 0;
+
+	while (i < arena->num_blocks) {
+		if (arena->blocks[i].used && (arena->blocks[i].job == job)) {
+			// Merging may shift blocks down, so rescan from the
+			// previous block.
+			release_block(arena, i);
+			i = (i > 0) ? i - 1 : 0;
+			n++;
+		} else {
+			i++;
+		}
+	}
+	return n;
+}
+
+void e_arena_get_stats(const e_arena_t *arena, e_arena_stats_t *stats)
+{
+	unsigned i;
+
+	memset(stats, 0, sizeof(*stats));
+	stats->size = arena->size;
+	stats->used = arena->used;
+	stats->peak = arena->peak;
+
+	for (i = 0; i < arena->num_blocks; i++) {
+		const e_arena_block_t *b = &arena->blocks[i];
+		if (b->used) {
+			stats->num_used++;
+		} else {
+			stats->num_free++;
+			stats->free_bytes += b->size;
+			if (b->size > stats->largest_free) {
+				stats->largest_free = b->size;
+			}
+		}
+	}
+	stats->fragmentation =
+	    stats->free_bytes
+		? 1.0f - (float)stats->largest_free / (float)stats->free_bytes
+		: 0.0f;
+}
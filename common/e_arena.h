@@ -0,0 +1,76 @@
+//
+// Arena allocator over the shared DRAM payload window(E_SHM_DATA_OFFSET).
+//
+// The whole window is mapped once with e_alloc(). Buffers are handed out as a
+// host pointer into the mapping plus the shared DRAM offset to put in an
+// e_cmd_t, so the host fills inputs and reads outputs in place without
+// e_read()/e_write().
+//
+// Block bookkeeping is kept on the host, never in shared DRAM. Each buffer is
+// tagged with a job id so everything belonging to one job can be released at
+// once with e_arena_free_job().
+//
+#ifndef E_ARENA_H_
+#define E_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <e-hal.h>
+
+#include "e_shm.h"
+
+#define E_ARENA_MAX_BLOCKS (1024)
+#define E_ARENA_MIN_ALIGN (8) // DMA friendly(doubleword)
+
+typedef struct {
+	uint32_t off; // offset from the arena start
+	uint32_t size;
+	uint32_t job;
+	int used;
+} e_arena_block_t;
+
+typedef struct {
+	e_mem_t mem;
+	uint32_t base; // shared DRAM offset of the arena
+	uint32_t size;
+	uint32_t used;
+	uint32_t peak;
+	unsigned num_blocks;
+	e_arena_block_t blocks[E_ARENA_MAX_BLOCKS]; // sorted by off
+} e_arena_t;
+
+typedef struct {
+	void *ptr;    // host pointer(inside the mapping)
+	uint32_t off; // shared DRAM offset, for e_cmd_t.src/dst
+	uint32_t size;
+} e_buf_t;
+
+typedef struct {
+	uint32_t size;
+	uint32_t used;
+	uint32_t peak;
+	uint32_t free_bytes;
+	uint32_t largest_free;
+	unsigned num_used;
+	unsigned num_free;
+	float fragmentation; // 1 - largest_free / free_bytes
+} e_arena_stats_t;
+
+// Maps [offset, offset + size) of shared DRAM. Returns E_OK or E_ERR.
+int e_arena_init(e_arena_t *arena, uint32_t offset, uint32_t size);
+void e_arena_destroy(e_arena_t *arena);
+
+// `align` is rounded up to E_ARENA_MIN_ALIGN and must be a power of 2.
+// Returns E_OK, or E_ERR when no free block is large enough or `align` is
+// not a power of 2.
+int e_arena_alloc(e_arena_t *arena, uint32_t size, uint32_t align,
+		  uint32_t job, e_buf_t *buf);
+void e_arena_free(e_arena_t *arena, e_buf_t *buf);
+
+// Frees every buffer tagged with `job`. Returns the number of buffers freed.
+unsigned e_arena_free_job(e_arena_t *arena, uint32_t job);
+
+void e_arena_get_stats(const e_arena_t *arena, e_arena_stats_t *stats);
+
+#endif // E_ARENA_H_
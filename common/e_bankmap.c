@@ -0,0 +1,184 @@
+//
+// Reports per-bank local memory usage of an e-core ELF.
+//
+//   $ e_bankmap e_fast_exp_test.elf kFmathExpTable gExpIn
+//
+// Prints bytes used in each 8KB bank by allocated sections, which bank every
+// listed symbol lives in, and how much of bank 3 is left for the stack above
+// the mailboxes. See e_banks.h for the intended layout.
+//
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "e_banks.h"
+
+#define NUM_BANKS (4)
+#define LOCAL_SIZE (NUM_BANKS * E_BANK_SIZE)
+
+#define SHF_ALLOC (0x2)
+#define SHT_SYMTAB (2)
+
+typedef struct {
+	unsigned char e_ident[16];
+	uint16_t e_type;
+	uint16_t e_machine;
+	uint32_t e_version;
+	uint32_t e_entry;
+	uint32_t e_phoff;
+	uint32_t e_shoff;
+	uint32_t e_flags;
+	uint16_t e_ehsize;
+	uint16_t e_phentsize;
+	uint16_t e_phnum;
+	uint16_t e_shentsize;
+	uint16_t e_shnum;
+	uint16_t e_shstrndx;
+} elf32_ehdr_t;
+
+typedef struct {
+	uint32_t sh_name;
+	uint32_t sh_type;
+	uint32_t sh_flags;
+	uint32_t sh_addr;
+	uint32_t sh_offset;
+	uint32_t sh_size;
+	uint32_t sh_link;
+	uint32_t sh_info;
+	uint32_t sh_addralign;
+	uint32_t sh_entsize;
+} elf32_shdr_t;
+
+typedef struct {
+	uint32_t st_name;
+	uint32_t st_value;
+	uint32_t st_size;
+	unsigned char st_info;
+	unsigned char st_other;
+	uint16_t st_shndx;
+} elf32_sym_t;
+
+static unsigned char *read_file(const char *filename, size_t *size)
+{
+	FILE *fp = fopen(filename, "rb");
+	unsigned char *buf;
+	long n;
+
+	if (!fp) {
+		return NULL;
+	}
+	fseek(fp, 0, SEEK_END);
+	n = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	buf = (unsigned char *)malloc(n);
+	if (fread(buf, 1, n, fp) != (size_t)n) {
+		free(buf);
+		buf = NULL;
+	}
+	fclose(fp);
+	*size = (size_t)n;
+	return buf;
+}
+
+// Adds [addr, addr + size) to the per-bank usage, splitting at bank borders.
+static void account(unsigned used[NUM_BANKS], uint32_t addr, uint32_t size)
+{
+	while ((size > 0) && (addr < LOCAL_SIZE)) {
+		unsigned bank = addr / E_BANK_SIZE;
+		uint32_t end = (bank + 1) * E_BANK_SIZE;
+		uint32_t n = (addr + size > end) ? end - addr : size;
+		used[bank] += n;
+		addr += n;
+		size -= n;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	unsigned char *elf;
+	size_t elf_size;
+	const elf32_ehdr_t *eh;
+	const elf32_shdr_t *sh;
+	const char *shstr;
+	unsigned used[NUM_BANKS] = {0, 0, 0, 0};
+	uint32_t bank3_top = E_COLL_ADDR + E_COLL_SIZE;
+	unsigned i, b;
+	int a;
+
+	if (argc < 2) {
+		fprintf(stderr, "Usage: %s file.elf [symbol ...]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	elf = read_file(argv[1], &elf_size);
+	if (!elf || (elf_size < sizeof(elf32_ehdr_t)) ||
+	    (memcmp(elf, "\177ELF", 4) != 0) || (elf[4] != 1 /* ELF32 */)) {
+		fprintf(stderr, "%s is not an ELF32 file.\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	eh = (const elf32_ehdr_t *)elf;
+	sh = (const elf32_shdr_t *)(elf + eh->e_shoff);
+	shstr = (const char *)(elf + sh[eh->e_shstrndx].sh_offset);
+
+	printf("%-20s %-8s %-8s bank\n", "section", "addr", "size");
+	for (i = 0; i < eh->e_shnum; i++) {
+		if (!(sh[i].sh_flags & SHF_ALLOC) || (sh[i].sh_size == 0) ||
+		    (sh[i].sh_addr >= LOCAL_SIZE)) {
+			continue;
+		}
+		account(used, sh[i].sh_addr, sh[i].sh_size);
+		printf("%-20s 0x%04x   %-8u %u\n", shstr + sh[i].sh_name,
+		       sh[i].sh_addr, sh[i].sh_size, sh[i].sh_addr / E_BANK_SIZE);
+
+		if ((sh[i].sh_addr >= 3 * E_BANK_SIZE) &&
+		    (sh[i].sh_addr + sh[i].sh_size > bank3_top)) {
+			bank3_top = sh[i].sh_addr + sh[i].sh_size;
+		}
+	}
+
+	printf("\nbank  range          used   free\n");
+	for (b = 0; b < NUM_BANKS; b++) {
+		printf("%u     0x%04x-0x%04x  %-6u %u\n", b, b * E_BANK_SIZE,
+		       (b + 1) * E_BANK_SIZE - 1, used[b], E_BANK_SIZE - used[b]);
+	}
+	printf("stack headroom(0x%04x-0x%04x) = %u bytes\n", bank3_top,
+	       LOCAL_SIZE, (bank3_top < LOCAL_SIZE) ? LOCAL_SIZE - bank3_top : 0);
+
+	// Pinned symbols.
+	for (i = 0; (argc > 2) && (i < eh->e_shnum); i++) {
+		const elf32_sym_t *syms;
+		const char *str;
+		unsigned k, nsyms;
+
+		if (sh[i].sh_type != SHT_SYMTAB) {
+			continue;
+		}
+		syms = (const elf32_sym_t *)(elf + sh[i].sh_offset);
+		nsyms = sh[i].sh_size / sizeof(elf32_sym_t);
+		str = (const char *)(elf + sh[sh[i].sh_link].sh_offset);
+
+		printf("\n%-24s %-8s %-8s bank\n", "symbol", "addr", "size");
+		for (a = 2; a < argc; a++) {
+			for (k = 0; k < nsyms; k++) {
+				if (strcmp(str + syms[k].st_name, argv[a]) == 0) {
+					break;
+				}
+			}
+			if (k == nsyms) {
+				printf("%-24s (not found)\n", argv[a]);
+			} else if (syms[k].st_value >= LOCAL_SIZE) {
+				printf("%-24s 0x%08x %-8u external\n", argv[a],
+				       syms[k].st_value, syms[k].st_size);
+			} else {
+				printf("%-24s 0x%04x   %-8u %u\n", argv[a],
+				       syms[k].st_value, syms[k].st_size,
+				       syms[k].st_value / E_BANK_SIZE);
+			}
+		}
+	}
+
+	free(elf);
+	return EXIT_SUCCESS;
+}
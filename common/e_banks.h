@@ -0,0 +1,65 @@
+//
+// Local memory bank plan for the e-core programs.
+//
+// Each core has 32KB of local memory in four 8KB banks. A bank serves one
+// access per cycle, so two loads dual-issued against the same bank(or a load
+// against the bank code is fetched from) stall. fast.ldf already provides
+// per-bank output sections(.data_bank0 .. .data_bank3), so we pin the hot
+// arrays there instead of letting .data/.bss pile up behind the code:
+//
+//   bank 0 0x0000-0x1fff : code, default .data/.bss
+//   bank 1 0x2000-0x3fff : E_BANK_TABLE(kFmathExpTable), E_BANK_WORK(BVH
+//                          node cache, path wave)
+//   bank 2 0x4000-0x5fff : E_BANK_NODES(local BVH nodes), E_BANK_DATA(ray
+//                          buffers, exp in/out chunks)
+//   bank 3 0x6000-0x7fff : mailbox at 0x6000, collectives mailbox right
+//                          behind it(e_coll.h, E_COLL_SIZE bytes), stack
+//                          grows down from 0x8000 towards them
+//
+// The exp table and the local BVH nodes sit in different banks. Banks 1 and 2
+// only hold 16KB, so the ray tracer's node cache and path wave fill up bank 1
+// behind the table(E_BANK_WORK): traversal loads nodes from bank 2 and the
+// cache, shading loads the table and the wave.
+//
+// Build with -DE_BANKS_PINNED=0 to get the default placement, for comparing
+// cycle counts. common/e_bankmap.c reports what actually landed in each bank.
+//
+// Usage:
+//   const unsigned int kTable[128] E_BANK_TABLE = { ... };
+//   static E_CORE_LOCAL float buf[256] E_BANK_DATA;
+//
+#ifndef E_BANKS_H_
+#define E_BANKS_H_
+
+#ifndef E_BANKS_PINNED
+#define E_BANKS_PINNED (1)
+#endif
+
+#define E_BANK_SIZE (0x2000)
+#define E_MAILBOX_ADDR (0x6000)
+#define E_MAILBOX_SIZE (16)
+#define E_COLL_ADDR (E_MAILBOX_ADDR + E_MAILBOX_SIZE)
+#define E_COLL_SIZE (0x100) // room reserved for e_coll_mbox_t
+
+#if E_BANKS_PINNED && defined(__epiphany__)
+#define E_BANK_TABLE SECTION(".data_bank1")
+#define E_BANK_WORK SECTION(".data_bank1")
+#define E_BANK_NODES SECTION(".data_bank2")
+#define E_BANK_DATA SECTION(".data_bank2")
+#else
+#define E_BANK_TABLE
+#define E_BANK_WORK
+#define E_BANK_NODES
+#define E_BANK_DATA
+#endif
+
+// Globals are per core on the chip, but shared between the threads which
+// emulate the cores under the host shim. Mark per-core work buffers with
+// E_CORE_LOCAL so the shim gives every core its own copy.
+#if defined(E_HOST_SHIM)
+#define E_CORE_LOCAL __thread
+#else
+#define E_CORE_LOCAL
+#endif
+
+#endif // E_BANKS_H_
@@ -0,0 +1,234 @@
+//
+// Ring-buffer command protocol between the host and persistent e-core kernels.
+//
+// Each core owns one e_cmdq_t in shared DRAM(E_SHM_CMDQ_OFFSET + index *
+// sizeof(e_cmdq_t)). It is a pair of single-producer/single-consumer rings:
+//
+//   cmd[]  : host -> core. Host writes cmd_head, core writes cmd_tail.
+//   cmpl[] : core -> host. Core writes cmpl_head, host writes cmpl_tail.
+//
+// Indices are free running and wrap with E_CMDQ_DEPTH - 1, so no atomics are
+// needed; each index has exactly one writer. The program is loaded once and
+// the core spins in e_cmdq_serve() until it receives E_CMD_QUIT.
+//
+// Job payloads are addressed by offset into shared DRAM(see e_shm.h), which
+// is valid on the host(e_mem_t.base + off), the e-core(E_SHM_PTR(off)) and
+// the host shim alike.
+//
+#ifndef E_CMDQ_H_
+#define E_CMDQ_H_
+
+#include <stdint.h>
+
+#include "e_shm.h"
+#include "e_trace.h"
+
+#define E_CMDQ_DEPTH (16) // must be power of 2
+#define E_CMDQ_MAGIC (0x51444d43) // "CMDQ"
+
+// Busy-wait between polls of cmd_head. Every poll is an external read, so
+// don't hammer the eLink when idle.
+#ifndef E_CMDQ_POLL_CLOCKS
+#define E_CMDQ_POLL_CLOCKS (256)
+#endif
+
+// Writes from a core to one destination are delivered in order on the eMesh,
+// so a compiler barrier is enough on the e-core side.
+#if defined(__epiphany__)
+#define E_CMDQ_BARRIER() __asm__ __volatile__("" ::: "memory")
+#else
+#define E_CMDQ_BARRIER() __sync_synchronize()
+#endif
+
+enum {
+	E_CMD_NOP = 0,
+	E_CMD_QUIT = 1,
+	E_CMD_EXP = 2,   // dst[i] = exp(src[i]), i < count
+	E_CMD_TRACE = 3, // trace `count` rays, arg[] = scene specific
+	E_CMD_SOFTMAX_STATS = 4, // dst[0..1] = online (max, sum) of src
+	E_CMD_SOFTMAX_SCALE = 5, // dst = exp(src - arg[0]) * arg[1](float bits)
+	E_CMD_EXP_STREAM = 6, // E_CMD_EXP, DMA double buffered
+	E_CMD_SOFTMAX_ROWS = 7, // `count` rows of arg[0] floats, arg[1] below
+};
+
+// arg[1] of E_CMD_SOFTMAX_ROWS.
+enum {
+	E_SOFTMAX_ROWS_3PASS = 0,  // dst row = softmax_n(src row)
+	E_SOFTMAX_ROWS_ONLINE = 1, // dst row = softmax_online_n(src row)
+	E_SOFTMAX_ROWS_LSE = 2,	   // dst[r] = logsumexp_n(src row r)
+};
+
+enum {
+	E_CMD_OK = 0,
+	E_CMD_EUNKNOWN = -1, // op not supported by the loaded program
+	E_CMD_EINVAL = -2,
+};
+
+typedef struct {
+	uint32_t op;
+	uint32_t seq; // echoed back in the completion
+	uint32_t src; // shared DRAM offset
+	uint32_t dst; // shared DRAM offset
+	uint32_t count;
+	uint32_t arg[3];
+} e_cmd_t; // 32 bytes
+
+typedef struct {
+	uint32_t seq;
+	int32_t status;
+	uint32_t clocks; // e-core clocks spent on the job
+	uint32_t coreid;
+} e_cmpl_t; // 16 bytes
+
+typedef struct {
+	volatile uint32_t magic; // set by the core once it is serving
+	volatile uint32_t cmd_head;
+	volatile uint32_t cmd_tail;
+	volatile uint32_t cmpl_head;
+	volatile uint32_t cmpl_tail;
+	uint32_t pad[3];
+	e_cmd_t cmd[E_CMDQ_DEPTH];
+	e_cmpl_t cmpl[E_CMDQ_DEPTH];
+} e_cmdq_t;
+
+// Host side
+
+static inline void e_cmdq_init(e_cmdq_t *q)
+{
+	q->magic = 0;
+	q->cmd_head = 0;
+	q->cmd_tail = 0;
+	q->cmpl_head = 0;
+	q->cmpl_tail = 0;
+	E_CMDQ_BARRIER();
+}
+
+static inline int e_cmdq_ready(const e_cmdq_t *q)
+{
+	return q->magic == E_CMDQ_MAGIC;
+}
+
+// Returns 0 on success, -1 when the ring is full.
+static inline int e_cmdq_post(e_cmdq_t *q, const e_cmd_t *cmd)
+{
+	uint32_t head = q->cmd_head;
+	if (head - q->cmd_tail >= E_CMDQ_DEPTH) {
+		return -1;
+	}
+	q->cmd[head & (E_CMDQ_DEPTH - 1)] = *cmd;
+	E_CMDQ_BARRIER();
+	q->cmd_head = head + 1;
+	return 0;
+}
+
+// Returns 1 and fills `out` when a completion is available, 0 otherwise.
+static inline int e_cmdq_reap(e_cmdq_t *q, e_cmpl_t *out)
+{
+	uint32_t tail = q->cmpl_tail;
+	if (tail == q->cmpl_head) {
+		return 0;
+	}
+	E_CMDQ_BARRIER();
+	*out = q->cmpl[tail & (E_CMDQ_DEPTH - 1)];
+	E_CMDQ_BARRIER();
+	q->cmpl_tail = tail + 1;
+	return 1;
+}
+
+// Number of posted jobs whose completion has not been reaped yet.
+static inline uint32_t e_cmdq_inflight(const e_cmdq_t *q)
+{
+	return q->cmd_head - q->cmpl_tail;
+}
+
+// e-core side
+
+// Returns the job status(E_CMD_OK, ...).
+typedef int (*e_cmdq_handler_t)(const e_cmd_t *cmd);
+
+// Needs e_lib.h(real or shim) to be included first.
+#if defined(__epiphany__) || defined(E_SHIM_E_LIB_H_)
+
+static inline e_cmdq_t *e_cmdq_self(void)
+{
+	unsigned index = e_group_config.core_row * e_group_config.group_cols +
+			 e_group_config.core_col;
+	return (e_cmdq_t *)E_SHM_PTR(E_SHM_CMDQ_OFFSET) + index;
+}
+
+// Serves jobs until E_CMD_QUIT. The command is copied to local memory before
+// the slot is released, so the handler never reads the ring.
+//
+// With E_TRACE, ctimer 1 is the free running trace clock(e_trace.h) and the
+// job clocks are taken from it.
+static inline void e_cmdq_serve(e_cmdq_t *q, e_cmdq_handler_t handler)
+{
+	const e_coreid_t coreid = e_get_coreid();
+	uint32_t tail = q->cmd_tail;
+	uint32_t done = q->cmpl_head;
+
+#if E_TRACE
+	e_trace_init();
+#endif
+	q->magic = E_CMDQ_MAGIC;
+
+	for (;;) {
+		e_cmd_t cmd;
+		e_cmpl_t cmpl;
+		unsigned t0, t1;
+
+		if (tail == q->cmd_head) {
+			// Keeps the trace clock running while idle.
+			E_TRACE_TICK();
+			e_wait(E_CTIMER_0, E_CMDQ_POLL_CLOCKS);
+			continue;
+		}
+		E_CMDQ_BARRIER();
+		cmd = q->cmd[tail & (E_CMDQ_DEPTH - 1)];
+		E_CMDQ_BARRIER();
+		q->cmd_tail = ++tail;
+		E_TRACE_INSTANT(E_TRACE_CLAIM, cmd.seq, 0);
+
+#if E_TRACE
+		t0 = e_trace_clock();
+#else
+		e_ctimer_set(E_CTIMER_1, E_CTIMER_MAX);
+		t0 = e_ctimer_start(E_CTIMER_1, E_CTIMER_CLK);
+#endif
+		E_TRACE_BEGIN(E_TRACE_KERNEL, cmd.op, cmd.seq);
+		if (cmd.op == E_CMD_QUIT || cmd.op == E_CMD_NOP) {
+			cmpl.status = E_CMD_OK;
+		} else {
+			cmpl.status = handler(&cmd);
+		}
+		E_TRACE_END(E_TRACE_KERNEL, cmd.op, cmd.seq);
+#if E_TRACE
+		t1 = e_trace_clock();
+		cmpl.clocks = t1 - t0;
+#else
+		t1 = e_ctimer_stop(E_CTIMER_1);
+		cmpl.clocks = t0 - t1;
+#endif
+
+		cmpl.seq = cmd.seq;
+		cmpl.coreid = coreid;
+
+		// Host reaps in order, so this only waits when it stopped
+		// reaping altogether.
+		while (done - q->cmpl_tail >= E_CMDQ_DEPTH) {
+			E_TRACE_TICK();
+			e_wait(E_CTIMER_0, E_CMDQ_POLL_CLOCKS);
+		}
+		q->cmpl[done & (E_CMDQ_DEPTH - 1)] = cmpl;
+		E_CMDQ_BARRIER();
+		q->cmpl_head = ++done;
+
+		if (cmd.op == E_CMD_QUIT) {
+			break;
+		}
+	}
+}
+
+#endif
+
+#endif // E_CMDQ_H_
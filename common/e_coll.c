@@ -0,0 +1,253 @@
+//
+// e-core side of e_coll.h.
+//
+#include "e_lib.h"
+
+#include "e_banks.h"
+#include "e_coll.h"
+#include "e_shm.h"
+#include "e_trace.h"
+
+// Posted remote writes arrive in order on the eMesh, the shim's threads need
+// a real fence. Spinning cores yield under the shim, there may be fewer host
+// CPUs than emulated cores.
+#if defined(E_HOST_SHIM)
+#include <sched.h>
+#define COLL_BARRIER() __sync_synchronize()
+#define COLL_PAUSE() sched_yield()
+#else
+#define COLL_BARRIER() __asm__ __volatile__("" ::: "memory")
+#define COLL_PAUSE() ((void)0)
+#endif
+
+// The mailbox has to fit below the stack, in the room e_banks.h reserves.
+typedef char coll_mbox_fits_t[(sizeof(e_coll_mbox_t) <= E_COLL_SIZE) ? 1 : -1];
+
+static E_CORE_LOCAL uint32_t tSeq;
+static E_CORE_LOCAL uint32_t tUpSent;
+static E_CORE_LOCAL uint32_t tDownSent[2 * E_COLL_MAX_LEVELS];
+
+static e_coll_mbox_t *coll_self(void)
+{
+	return (e_coll_mbox_t *)E_LOCAL_PTR(E_COLL_ADDR);
+}
+
+static e_coll_mbox_t *coll_peer(unsigned row, unsigned col)
+{
+	return (e_coll_mbox_t *)e_get_global_address(row, col, coll_self());
+}
+
+#if E_TRACE
+static uint32_t coll_coreid(unsigned row, unsigned col)
+{
+	return ((e_group_config.group_row + row) << 6) |
+	       (e_group_config.group_col + col);
+}
+#endif
+
+static unsigned lowbit_level(unsigned pos)
+{
+	unsigned l = 0;
+	while (!(pos & (1u << l))) {
+		l++;
+	}
+	return l;
+}
+
+static void combine(float *v, const volatile float *w, unsigned n, int op)
+{
+	unsigned i;
+
+	for (i = 0; i < n; i++) {
+		const float x = w[i];
+		switch (op) {
+		case E_COLL_SUM:
+			v[i] += x;
+			break;
+		case E_COLL_MIN:
+			v[i] = (x < v[i]) ? x : v[i];
+			break;
+		case E_COLL_MAX:
+			v[i] = (x > v[i]) ? x : v[i];
+			break;
+		}
+	}
+}
+
+static void slot_write(e_coll_slot_t *slot, const float *v, unsigned n,
+		       uint32_t seq)
+{
+	unsigned i;
+
+	for (i = 0; i < n; i++) {
+		slot->val[i] = v[i];
+	}
+	COLL_BARRIER();
+	slot->seq = seq;
+}
+
+static void slot_wait(const e_coll_slot_t *slot, uint32_t seq)
+{
+	while (slot->seq != seq) {
+		COLL_PAUSE();
+	}
+	COLL_BARRIER();
+}
+
+// (row, col) of position `pos` along dimension `dim`.
+static void coll_coords(const e_coll_group_t *g, unsigned dim, unsigned pos,
+			unsigned *row, unsigned *col)
+{
+	*row = dim ? pos : g->row;
+	*col = dim ? 0 : pos;
+}
+
+// Binomial reduce along one dimension. Returns 1 when this core handed its
+// value to the parent.
+static int reduce_dim(const e_coll_group_t *g, unsigned dim, float *v,
+		      unsigned n, int op, uint32_t seq)
+{
+	e_coll_mbox_t *self = coll_self();
+	const unsigned pos = dim ? g->row : g->col;
+	const unsigned len = dim ? g->rows : g->cols;
+	unsigned l, step, row, col;
+
+	for (l = 0, step = 1; step < len; l++, step <<= 1) {
+		const unsigned idx = dim * E_COLL_MAX_LEVELS + l;
+
+		if (pos & step) {
+			coll_coords(g, dim, pos - step, &row, &col);
+			while (self->up_ack != tUpSent) {
+				COLL_PAUSE();
+			}
+			slot_write(&coll_peer(row, col)->up[idx], v, n, seq);
+			tUpSent = seq;
+			E_TRACE_INSTANT(E_TRACE_SEND, coll_coreid(row, col),
+					seq);
+			return 1;
+		}
+		if (pos + step < len) {
+			coll_coords(g, dim, pos + step, &row, &col);
+			slot_wait(&self->up[idx], seq);
+			combine(v, self->up[idx].val, n, op);
+			coll_peer(row, col)->up_ack = seq;
+			E_TRACE_INSTANT(E_TRACE_RECV, coll_coreid(row, col),
+					seq);
+		}
+	}
+	return 0;
+}
+
+// Sends to the children along one dimension, the farthest first.
+static void broadcast_dim(const e_coll_group_t *g, unsigned dim,
+			  const float *v, unsigned n, uint32_t seq)
+{
+	e_coll_mbox_t *self = coll_self();
+	const unsigned pos = dim ? g->row : g->col;
+	const unsigned len = dim ? g->rows : g->cols;
+	unsigned l, step, row, col;
+
+	for (l = 0, step = 1; (step << 1) < len; l++, step <<= 1) {
+	}
+	for (;; l--, step >>= 1) {
+		const unsigned idx = dim * E_COLL_MAX_LEVELS + l;
+
+		if ((pos % (step << 1) == 0) && (pos + step < len)) {
+			coll_coords(g, dim, pos + step, &row, &col);
+			while (self->down_ack[idx] != tDownSent[idx]) {
+				COLL_PAUSE();
+			}
+			slot_write(&coll_peer(row, col)->down, v, n, seq);
+			tDownSent[idx] = seq;
+			E_TRACE_INSTANT(E_TRACE_SEND, coll_coreid(row, col),
+					seq);
+		}
+		if (l == 0) {
+			break;
+		}
+	}
+}
+
+static void coll_reduce(const e_coll_group_t *g, float *v, unsigned n, int op,
+			uint32_t seq)
+{
+	if (!reduce_dim(g, 0, v, n, op, seq) && (g->col == 0)) {
+		reduce_dim(g, 1, v, n, op, seq);
+	}
+}
+
+static void coll_broadcast(const e_coll_group_t *g, float *v, unsigned n,
+			   uint32_t seq)
+{
+	e_coll_mbox_t *self = coll_self();
+	unsigned i;
+
+	if (g->row || g->col) {
+		const unsigned dim = g->col ? 0 : 1;
+		const unsigned pos = dim ? g->row : g->col;
+		const unsigned l = lowbit_level(pos);
+		unsigned row, col;
+
+		coll_coords(g, dim, pos - (1u << l), &row, &col);
+		slot_wait(&self->down, seq);
+		for (i = 0; i < n; i++) {
+			v[i] = self->down.val[i];
+		}
+		coll_peer(row, col)->down_ack[dim * E_COLL_MAX_LEVELS + l] =
+			seq;
+		E_TRACE_INSTANT(E_TRACE_RECV, coll_coreid(row, col), seq);
+	}
+	if (g->col == 0) {
+		broadcast_dim(g, 1, v, n, seq);
+	}
+	broadcast_dim(g, 0, v, n, seq);
+}
+
+static int coll_outside(const e_coll_group_t *g)
+{
+	return (g->row >= g->rows) || (g->col >= g->cols);
+}
+
+void e_coll_group(e_coll_group_t *g, unsigned rows, unsigned cols)
+{
+	g->rows = rows;
+	g->cols = cols;
+	g->row = e_group_config.core_row;
+	g->col = e_group_config.core_col;
+}
+
+void e_coll_barrier(const e_coll_group_t *g)
+{
+	e_coll_allreduce(g, 0, 0, E_COLL_SUM);
+}
+
+void e_coll_broadcast(const e_coll_group_t *g, float *v, unsigned n)
+{
+	const uint32_t seq = ++tSeq;
+
+	n = (n > E_COLL_MAX_WORDS) ? E_COLL_MAX_WORDS : n;
+	if (!coll_outside(g)) {
+		coll_broadcast(g, v, n, seq);
+	}
+}
+
+void e_coll_reduce(const e_coll_group_t *g, float *v, unsigned n, int op)
+{
+	const uint32_t seq = ++tSeq;
+
+	n = (n > E_COLL_MAX_WORDS) ? E_COLL_MAX_WORDS : n;
+	if (!coll_outside(g)) {
+		coll_reduce(g, v, n, op, seq);
+	}
+}
+
+void e_coll_allreduce(const e_coll_group_t *g, float *v, unsigned n, int op)
+{
+	const uint32_t seq = ++tSeq;
+
+	n = (n > E_COLL_MAX_WORDS) ? E_COLL_MAX_WORDS : n;
+	if (!coll_outside(g)) {
+		coll_reduce(g, v, n, op, seq);
+		coll_broadcast(g, v, n, seq);
+	}
+}
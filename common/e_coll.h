@@ -0,0 +1,85 @@
+//
+// Collectives across the cores of a workgroup: barrier, broadcast, reduce and
+// all-reduce over a few floats, without going through the host.
+//
+// The tree is a binomial tree along each row to column 0, then along column
+// 0 to core (0, 0), so every edge is a straight line on the mesh and the
+// depth is log2(rows) + log2(cols). Reduce goes up the tree, broadcast comes
+// down it, all-reduce is both and barrier is an all-reduce of nothing.
+//
+// All traffic is remote writes into the receiver's e_coll_mbox_t at
+// E_COLL_ADDR(e_banks.h); a core only ever spins on its own local memory.
+// A message is the payload, then its sequence number, which is enough since
+// writes from one core to one destination are delivered in order. The
+// receiver acks every message, and a sender waits for the ack of the
+// previous message on the same edge before writing the next one, so a core
+// running ahead never overwrites a slot which hasn't been read.
+//
+// Every core of the workgroup has to make the same sequence of e_coll_*()
+// calls(that's what keeps the sequence numbers in step); cores outside the
+// group's rectangle return right away.
+//
+// The host zeroes the mailbox of every core before the group is started,
+// e.g. e_write() of sizeof(e_coll_mbox_t) zero bytes to E_COLL_ADDR.
+//
+// Usage:
+//   e_coll_group_t g;
+//   float v[3] = {err, err, err};
+//   e_coll_group(&g, e_group_config.group_rows, e_group_config.group_cols);
+//   e_coll_allreduce(&g, v, 1, E_COLL_SUM);
+//
+#ifndef E_COLL_H_
+#define E_COLL_H_
+
+#include <stdint.h>
+
+#include "e_banks.h"
+
+#define E_COLL_MAX_WORDS (4)
+#define E_COLL_MAX_LEVELS (3) // per dimension, up to 8 x 8 cores
+
+enum {
+	E_COLL_SUM = 0,
+	E_COLL_MIN = 1,
+	E_COLL_MAX = 2,
+};
+
+typedef struct {
+	volatile uint32_t seq; // written after val
+	uint32_t pad;
+	volatile float val[E_COLL_MAX_WORDS];
+} e_coll_slot_t; // 24 bytes
+
+// Slots and acks are indexed by dim * E_COLL_MAX_LEVELS + level, dim 0 is the
+// row phase, dim 1 the column phase.
+typedef struct {
+	e_coll_slot_t up[2 * E_COLL_MAX_LEVELS]; // from children
+	e_coll_slot_t down;			  // from the parent
+	volatile uint32_t up_ack;		  // parent read our up slot
+	volatile uint32_t down_ack[2 * E_COLL_MAX_LEVELS]; // children read down
+} e_coll_mbox_t;
+
+typedef struct {
+	unsigned rows, cols; // participating rectangle, from core (0, 0)
+	unsigned row, col;   // this core
+} e_coll_group_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// e-core side, e_coll.c. Needs e_lib.h(real or shim).
+void e_coll_group(e_coll_group_t *g, unsigned rows, unsigned cols);
+void e_coll_barrier(const e_coll_group_t *g);
+// v[0..n) of core (0, 0) to every core.
+void e_coll_broadcast(const e_coll_group_t *g, float *v, unsigned n);
+// v[0..n) combined element-wise with `op`, result on core (0, 0) only.
+void e_coll_reduce(const e_coll_group_t *g, float *v, unsigned n, int op);
+// Same, result on every core.
+void e_coll_allreduce(const e_coll_group_t *g, float *v, unsigned n, int op);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // E_COLL_H_
@@ -0,0 +1,130 @@
+//
+// Hardware event counters for the e-core test programs.
+//
+// ctimer 0 counts clocks while ctimer 1 counts one event, so a kernel is run
+// once per event mode(best of `repeat` runs each) and the counts are combined
+// into IPC and a stall breakdown. An empty run is measured the same way and
+// subtracted, which takes out the call and the timer start/stop.
+//
+// The host shim only emulates E_CTIMER_CLK, events read 0 there.
+//
+// Usage:
+//   static void run_exp4(void *arg) { fmath_exp4(out, in); }
+//
+//   e_prof_t prof;
+//   e_prof_run(&prof, run_exp4, NULL, E_PROF_REPEAT);
+//   e_prof_print(outbuf + strlen(outbuf), "fmath_exp4()", &prof);
+//
+#ifndef E_PROF_H_
+#define E_PROF_H_
+
+#include <stdio.h>
+
+// Default `repeat` for e_prof_run().
+#define E_PROF_REPEAT (8)
+
+enum {
+	E_PROF_IALU = 0,	// integer instructions issued
+	E_PROF_FPU,		// floating point instructions issued
+	E_PROF_DUAL,		// cycles issuing both
+	E_PROF_E1_STALLS,	// load stalls, local memory
+	E_PROF_RA_STALLS,	// register dependency stalls
+	E_PROF_EXT_LOAD_STALLS, // load stalls, external memory
+	E_PROF_NUM_EVENTS,
+};
+
+typedef struct {
+	unsigned int clocks;
+	unsigned int events[E_PROF_NUM_EVENTS];
+} e_prof_t;
+
+typedef void (*e_prof_fn_t)(void *arg);
+
+static inline void e_prof_nop(void *arg)
+{
+	(void)arg;
+}
+
+static inline void e_prof_measure(e_prof_t *p, e_prof_fn_t fn, void *arg,
+				  int repeat)
+{
+	static const e_ctimer_config_t kEProfModes[E_PROF_NUM_EVENTS] = {
+		E_CTIMER_IALU_INST, E_CTIMER_FPU_INST,	E_CTIMER_DUAL_INST,
+		E_CTIMER_E1_STALLS, E_CTIMER_RA_STALLS, E_CTIMER_EXT_LOAD_STALLS,
+	};
+	unsigned int clocks, count;
+	int k, r;
+
+	p->clocks = E_CTIMER_MAX;
+	for (k = 0; k < E_PROF_NUM_EVENTS; k++) {
+		p->events[k] = E_CTIMER_MAX;
+		for (r = 0; r < repeat; r++) {
+			e_ctimer_set(E_CTIMER_0, E_CTIMER_MAX);
+			e_ctimer_set(E_CTIMER_1, E_CTIMER_MAX);
+			e_ctimer_start(E_CTIMER_1, kEProfModes[k]);
+			e_ctimer_start(E_CTIMER_0, E_CTIMER_CLK);
+
+			fn(arg);
+
+			clocks = E_CTIMER_MAX - e_ctimer_stop(E_CTIMER_0);
+			count = E_CTIMER_MAX - e_ctimer_stop(E_CTIMER_1);
+			p->clocks = (clocks < p->clocks) ? clocks : p->clocks;
+			p->events[k] = (count < p->events[k]) ? count
+							      : p->events[k];
+		}
+	}
+}
+
+static inline void e_prof_run(e_prof_t *p, e_prof_fn_t fn, void *arg,
+			      int repeat)
+{
+	e_prof_t base;
+	int k;
+
+	e_prof_measure(&base, e_prof_nop, 0, repeat);
+	e_prof_measure(p, fn, arg, repeat);
+
+	p->clocks = (p->clocks > base.clocks) ? p->clocks - base.clocks : 0;
+	for (k = 0; k < E_PROF_NUM_EVENTS; k++) {
+		p->events[k] = (p->events[k] > base.events[k])
+				       ? p->events[k] - base.events[k]
+				       : 0;
+	}
+}
+
+// One line: clocks, IPC x100, stalls in % of clocks and what dominates.
+// Integers only, no float printf on the e-core.
+static inline int e_prof_print(char *buf, const char *name, const e_prof_t *p)
+{
+	const unsigned int c = p->clocks ? p->clocks : 1;
+	const unsigned int insts =
+		p->events[E_PROF_IALU] + p->events[E_PROF_FPU];
+	const unsigned int mem =
+		p->events[E_PROF_E1_STALLS] + p->events[E_PROF_EXT_LOAD_STALLS];
+	const unsigned int dep = p->events[E_PROF_RA_STALLS];
+	const unsigned int busy = (mem + dep < p->clocks) ? p->clocks - mem - dep
+							  : 0;
+	const char *bound = "issue-bound";
+
+	if (insts == 0) {
+		return sprintf(buf, "\"%s\": %u clocks, no event counters.\n",
+			       name, p->clocks);
+	}
+	if ((mem >= dep) && (mem > busy)) {
+		bound = "memory-bound";
+	} else if (dep > busy) {
+		bound = "dependency-bound";
+	}
+	return sprintf(buf,
+		       "\"%s\": %u clocks, IPC %u.%02u(ialu %u, fpu %u, dual "
+		       "%u), stalls: local load %u%%, ext. load %u%%, reg. "
+		       "dep. %u%% -> %s.\n",
+		       name, p->clocks, insts / c, insts * 100 / c % 100,
+		       p->events[E_PROF_IALU], p->events[E_PROF_FPU],
+		       p->events[E_PROF_DUAL],
+		       p->events[E_PROF_E1_STALLS] * 100 / c,
+		       p->events[E_PROF_EXT_LOAD_STALLS] * 100 / c,
+		       dep * 100 / c, bound);
+}
+
+#endif // E_PROF_H_
@@ -0,0 +1,224 @@
+//
+// Host runtime with warm restart, see e_rt.h.
+//
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "e_rt.h"
+
+#define RT_PING_SEQ (0xffffffffu)
+
+static double now_usec(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec * 1e-3;
+}
+
+// FNV-1a over the file, or over the path when it can't be read.
+static uint64_t image_key(const char *image)
+{
+	uint64_t h = 0xcbf29ce484222325ULL;
+	unsigned char buf[4096];
+	FILE *fp = fopen(image, "rb");
+	size_t n, i;
+
+	if (!fp) {
+		for (; *image; image++) {
+			h = (h ^ (unsigned char)*image) * 0x100000001b3ULL;
+		}
+		return h;
+	}
+	while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) {
+		for (i = 0; i < n; i++) {
+			h = (h ^ buf[i]) * 0x100000001b3ULL;
+		}
+	}
+	fclose(fp);
+	return h;
+}
+
+// Posts `op` to every core and reaps until each one has answered it, along
+// with whatever a previous owner left in flight. Returns 1 when all cores
+// answered within `usec`.
+static int rt_broadcast(e_rt_t *rt, uint32_t op, double usec)
+{
+	unsigned posted[E_RT_MAX_CORES], answered[E_RT_MAX_CORES];
+	const double t0 = now_usec();
+	unsigned k, left = rt->ncores;
+
+	memset(posted, 0, sizeof(posted));
+	memset(answered, 0, sizeof(answered));
+	for (k = 0; k < rt->ncores; k++) {
+		if (!e_cmdq_ready(&rt->queues[k])) {
+			return 0;
+		}
+	}
+
+	while (left) {
+		if (now_usec() - t0 > usec) {
+			return 0;
+		}
+		for (k = 0; k < rt->ncores; k++) {
+			e_cmpl_t cmpl;
+
+			if (!posted[k]) {
+				e_cmd_t cmd;
+				memset(&cmd, 0, sizeof(cmd));
+				cmd.op = op;
+				cmd.seq = RT_PING_SEQ;
+				posted[k] = (e_cmdq_post(&rt->queues[k], &cmd) ==
+					     0);
+			}
+			while (e_cmdq_reap(&rt->queues[k], &cmpl)) {
+				if (posted[k] && !answered[k] &&
+				    (cmpl.seq == RT_PING_SEQ)) {
+					answered[k] = 1;
+					left--;
+				}
+			}
+		}
+	}
+	return 1;
+}
+
+static int rt_wait_ready(e_rt_t *rt)
+{
+	const double t0 = now_usec();
+	unsigned k;
+
+	for (k = 0; k < rt->ncores; k++) {
+		while (!e_cmdq_ready(&rt->queues[k])) {
+			if (now_usec() - t0 > E_RT_READY_USEC) {
+				fprintf(stderr, "??? core %u did not start\n", k);
+				return E_ERR;
+			}
+		}
+	}
+	return E_OK;
+}
+
+// Undoes e_rt_open() up to and including e_open().
+static void rt_release(e_rt_t *rt)
+{
+	e_close(&rt->dev);
+	e_free(&rt->hmem);
+	e_free(&rt->qmem);
+	e_finalize();
+}
+
+int e_rt_open(e_rt_t *rt, const char *image)
+{
+	const double t0 = now_usec();
+	e_rt_header_t *hdr;
+	uint64_t key;
+	double t;
+	unsigned k;
+
+	memset(rt, 0, sizeof(*rt));
+
+	if (e_init(NULL) != E_OK) {
+		return E_ERR;
+	}
+	e_get_platform_info(&rt->platform);
+	rt->ncores = rt->platform.rows * rt->platform.cols;
+	rt->ncores = (rt->ncores > E_RT_MAX_CORES) ? E_RT_MAX_CORES
+						   : rt->ncores;
+	if (e_alloc(&rt->qmem, E_SHM_CMDQ_OFFSET,
+		    rt->ncores * sizeof(e_cmdq_t)) != E_OK) {
+		fprintf(stderr, "??? can't map the command queues\n");
+		e_finalize();
+		return E_ERR;
+	}
+	if (e_alloc(&rt->hmem, E_SHM_RT_OFFSET, sizeof(e_rt_header_t)) !=
+	    E_OK) {
+		fprintf(stderr, "??? can't map the runtime header\n");
+		e_free(&rt->qmem);
+		e_finalize();
+		return E_ERR;
+	}
+	if (e_open(&rt->dev, 0, 0, rt->platform.rows, rt->platform.cols) !=
+	    E_OK) {
+		fprintf(stderr, "??? can't open the workgroup\n");
+		e_free(&rt->hmem);
+		e_free(&rt->qmem);
+		e_finalize();
+		return E_ERR;
+	}
+	rt->queues = (e_cmdq_t *)rt->qmem.base;
+	rt->hdr = hdr = (e_rt_header_t *)rt->hmem.base;
+	key = image_key(image);
+	t = now_usec();
+	rt->init_usec = t - t0;
+
+	if ((hdr->magic == E_RT_MAGIC) && (hdr->image_key == key) &&
+	    (hdr->rows == rt->platform.rows) &&
+	    (hdr->cols == rt->platform.cols)) {
+		rt->warm = rt_broadcast(rt, E_CMD_NOP, E_RT_PING_USEC);
+		rt->ping_usec = now_usec() - t;
+		t = now_usec();
+	}
+
+	if (!rt->warm) {
+		// Whatever serves now goes away before the reset.
+		if (hdr->magic == E_RT_MAGIC) {
+			rt_broadcast(rt, E_CMD_QUIT, E_RT_PING_USEC);
+		}
+		hdr->magic = 0;
+		e_reset_system();
+		for (k = 0; k < rt->ncores; k++) {
+			e_cmdq_init(&rt->queues[k]);
+		}
+		rt->reset_usec = now_usec() - t;
+
+		t = now_usec();
+		if (e_load_group(image, &rt->dev, 0, 0, rt->platform.rows,
+				 rt->platform.cols, E_FALSE) != E_OK) {
+			fprintf(stderr, "??? can't load %s\n", image);
+			rt_release(rt);
+			return E_ERR;
+		}
+		rt->load_usec = now_usec() - t;
+
+		t = now_usec();
+		e_start_group(&rt->dev);
+		if (rt_wait_ready(rt) != E_OK) {
+			rt_release(rt);
+			return E_ERR;
+		}
+		rt->start_usec = now_usec() - t;
+
+		hdr->rows = rt->platform.rows;
+		hdr->cols = rt->platform.cols;
+		hdr->opens = 0;
+		hdr->image_key = key;
+		snprintf(hdr->image, sizeof(hdr->image), "%s", image);
+		E_CMDQ_BARRIER();
+		hdr->magic = E_RT_MAGIC;
+	}
+	hdr->opens++;
+	rt->open_usec = now_usec() - t0;
+
+	return E_OK;
+}
+
+void e_rt_close(e_rt_t *rt, int mode)
+{
+	if (mode == E_RT_STOP) {
+		rt_broadcast(rt, E_CMD_QUIT, E_RT_PING_USEC);
+		rt->hdr->magic = 0;
+	}
+	rt_release(rt);
+}
+
+int e_rt_call(e_rt_t *rt, unsigned core, const e_cmd_t *cmd, e_cmpl_t *cmpl)
+{
+	e_cmdq_t *q = &rt->queues[core];
+
+	while (e_cmdq_post(q, cmd) != 0) {
+	}
+	while (!e_cmdq_reap(q, cmpl)) {
+	}
+	return cmpl->status;
+}
@@ -0,0 +1,82 @@
+//
+// Long-lived host runtime for the persistent kernels(e_cmdq.h).
+//
+// e_rt_open() loads a kernel image once and records it in a header in shared
+// DRAM. e_rt_close(rt, E_RT_PARK) leaves the cores serving. Their poll loop
+// is the parked state. The next e_rt_open() of the same image, in this
+// process or a later one, finds the header and pings every core with
+// E_CMD_NOP. If they all answer, it attaches to the command queues as they
+// are: no e_reset_system(), no e_load_group(). Otherwise it stops whatever
+// is running with E_CMD_QUIT and loads cold.
+//
+// Relaunching a parked core on new input is one e_cmdq_post(), i.e. writing
+// the cmd_head flag the core polls.
+//
+// The image is identified by a hash of the file. Under the shim, where the
+// program is linked in and there may be no SREC, it is the hash of the path.
+//
+// Host side only.
+//
+#ifndef E_RT_H_
+#define E_RT_H_
+
+#include <stdint.h>
+
+#include <e-hal.h>
+
+#include "e_cmdq.h"
+
+#define E_RT_MAGIC (0x54524545) // "EERT"
+#define E_RT_MAX_CORES (64)
+#define E_RT_READY_USEC (1000000) // cold start, until every core serves
+#define E_RT_PING_USEC (100000)   // warm attach, until every core answers
+
+enum {
+	E_RT_STOP = 0, // E_CMD_QUIT to every core
+	E_RT_PARK = 1, // leave the cores serving for the next e_rt_open()
+};
+
+typedef struct {
+	volatile uint32_t magic;
+	uint32_t rows, cols;
+	volatile uint32_t opens; // e_rt_open() calls since the load
+	uint64_t image_key;
+	char image[48];
+} e_rt_header_t;
+
+typedef struct {
+	e_platform_t platform;
+	e_epiphany_t dev;
+	e_mem_t qmem, hmem;
+	e_cmdq_t *queues;
+	e_rt_header_t *hdr;
+	unsigned ncores;
+	int warm; // attached to parked cores
+
+	// us spent in the last e_rt_open(). Phases that were skipped are 0.
+	double init_usec;  // e_init() + e_open() + mappings
+	double ping_usec;  // warm check
+	double reset_usec; // stopping the old kernel + e_reset_system()
+	double load_usec;  // e_load_group()
+	double start_usec; // e_start_group() until every core serves
+	double open_usec;  // all of it
+} e_rt_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Returns E_OK, or E_ERR when the platform can't be opened, the image can't
+// be loaded or the cores did not come up. Nothing is left open on E_ERR.
+int e_rt_open(e_rt_t *rt, const char *image);
+void e_rt_close(e_rt_t *rt, int mode);
+
+// Posts `cmd` to `core` and spins until its completion. Returns the job
+// status.
+int e_rt_call(e_rt_t *rt, unsigned core, const e_cmd_t *cmd, e_cmpl_t *cmpl);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // E_RT_H_
@@ -0,0 +1,226 @@
+//
+// Host/e-core batch scheduler, see e_sched.h.
+//
+#include <sched.h>
+#include <string.h>
+#include <time.h>
+
+#include "e_sched.h"
+
+#define SCHED_EWMA (0.5) // weight of the last batch in the rates
+
+typedef struct {
+	e_sched_t *s;
+	pthread_t thread;
+	unsigned items;
+	double usec; // until its last chunk was done
+} sched_worker_t;
+
+static double now_usec(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec * 1e-3;
+}
+
+// Half of what is left times `rate`'s share of the total, rounded up to the
+// granule. A side without a rate yet counts as 1 item/us.
+static unsigned claim_size(const e_sched_t *s, unsigned rem, double rate)
+{
+	const double host = s->nthreads ? (s->host_rate > 0.0 ? s->host_rate
+							       : 1.0)
+					: 0.0;
+	const double core = s->ncores ? (s->core_rate > 0.0 ? s->core_rate
+							    : 1.0)
+				      : 0.0;
+	unsigned take = (unsigned)(0.5 * rem * rate / (host + core));
+
+	take = (take + s->granule - 1) / s->granule * s->granule;
+	return take ? take : s->granule;
+}
+
+static int claim_front(e_sched_t *s, unsigned *begin, unsigned *end)
+{
+	const double rate = (s->core_rate > 0.0 ? s->core_rate : 1.0) /
+			    s->ncores;
+	unsigned take;
+
+	pthread_mutex_lock(&s->lock);
+	take = claim_size(s, s->hi - s->lo, rate);
+	take = (take > s->max_job) ? s->max_job : take;
+	take = (take > s->hi - s->lo) ? s->hi - s->lo : take;
+	*begin = s->lo;
+	s->lo += take;
+	*end = s->lo;
+	pthread_mutex_unlock(&s->lock);
+
+	return take != 0;
+}
+
+// Back claims start on a granule, so the front ones stay aligned.
+static int claim_back(e_sched_t *s, unsigned *begin, unsigned *end)
+{
+	const double rate = (s->host_rate > 0.0 ? s->host_rate : 1.0) /
+			    s->nthreads;
+	unsigned take, b;
+
+	pthread_mutex_lock(&s->lock);
+	take = claim_size(s, s->hi - s->lo, rate);
+	b = (take < s->hi - s->lo) ? s->hi - take : s->lo;
+	b -= b % s->granule;
+	b = (b < s->lo) ? s->lo : b;
+	*begin = b;
+	*end = s->hi;
+	s->hi = b;
+	pthread_mutex_unlock(&s->lock);
+
+	return *end != *begin;
+}
+
+static void *host_worker(void *arg)
+{
+	sched_worker_t *w = (sched_worker_t *)arg;
+	const double t0 = now_usec();
+	unsigned begin, end;
+
+	while (claim_back(w->s, &begin, &end)) {
+		w->s->host_fn(w->s->ctx, begin, end);
+		w->items += end - begin;
+		w->usec = now_usec() - t0;
+	}
+	return NULL;
+}
+
+// Keeps every core's ring E_SCHED_INFLIGHT deep until the range is drained.
+// Returns the us until the last completion.
+static double dispatch(e_sched_t *s)
+{
+	const double t0 = now_usec();
+	double t_last = t0;
+	unsigned inflight = 0, begin, end, k;
+	int drained = 0;
+
+	while (!drained || inflight) {
+		int progress = 0;
+
+		for (k = 0; k < s->ncores; k++) {
+			e_cmpl_t cmpl;
+
+			while (!drained &&
+			       (e_cmdq_inflight(&s->queues[k]) <
+				E_SCHED_INFLIGHT)) {
+				e_cmd_t cmd;
+
+				if (!claim_front(s, &begin, &end)) {
+					drained = 1;
+					break;
+				}
+				memset(&cmd, 0, sizeof(cmd));
+				s->cmd_fn(s->ctx, &cmd, begin, end);
+				cmd.seq = s->core_jobs++;
+				e_cmdq_post(&s->queues[k], &cmd);
+				s->core_items += end - begin;
+				inflight++;
+				progress = 1;
+			}
+			while (e_cmdq_reap(&s->queues[k], &cmpl)) {
+				s->errors += (cmpl.status != E_CMD_OK);
+				inflight--;
+				t_last = now_usec();
+				progress = 1;
+			}
+		}
+		if (!progress) {
+			sched_yield();
+		}
+	}
+	return t_last - t0;
+}
+
+static double ewma(double old, double last)
+{
+	return (old > 0.0) ? (1.0 - SCHED_EWMA) * old + SCHED_EWMA * last
+			   : last;
+}
+
+void e_sched_init(e_sched_t *s, e_cmdq_t *queues, unsigned ncores,
+		  unsigned nthreads, e_sched_host_fn_t host_fn,
+		  e_sched_cmd_fn_t cmd_fn, void *ctx)
+{
+	memset(s, 0, sizeof(*s));
+	s->queues = queues;
+	s->ncores = ncores;
+	s->nthreads = (nthreads > E_SCHED_MAX_THREADS) ? E_SCHED_MAX_THREADS
+						       : nthreads;
+	s->granule = 16;
+	s->max_job = 4096;
+	s->host_fn = host_fn;
+	s->cmd_fn = cmd_fn;
+	s->ctx = ctx;
+	pthread_mutex_init(&s->lock, NULL);
+}
+
+void e_sched_destroy(e_sched_t *s)
+{
+	pthread_mutex_destroy(&s->lock);
+}
+
+int e_sched_run(e_sched_t *s, unsigned n)
+{
+	sched_worker_t workers[E_SCHED_MAX_THREADS];
+	const double t0 = now_usec();
+	double core_usec = 0.0, host_rate = 0.0;
+	unsigned k;
+
+	s->lo = 0;
+	s->hi = n;
+	s->host_items = 0;
+	s->core_items = 0;
+	s->core_jobs = 0;
+	s->errors = 0;
+
+	for (k = 0; k < s->nthreads; k++) {
+		memset(&workers[k], 0, sizeof(workers[k]));
+		workers[k].s = s;
+		pthread_create(&workers[k].thread, NULL, host_worker,
+			       &workers[k]);
+	}
+	if (s->ncores) {
+		core_usec = dispatch(s);
+	}
+	for (k = 0; k < s->nthreads; k++) {
+		pthread_join(workers[k].thread, NULL);
+		s->host_items += workers[k].items;
+		if (workers[k].usec > 0.0) {
+			host_rate += workers[k].items / workers[k].usec;
+		}
+	}
+	s->usec = now_usec() - t0;
+
+	// A side which got nothing this time keeps its old rate.
+	if (s->host_items) {
+		s->host_rate = ewma(s->host_rate, host_rate);
+	}
+	if (s->core_items && (core_usec > 0.0)) {
+		s->core_rate = ewma(s->core_rate, s->core_items / core_usec);
+	}
+	return s->errors;
+}
+
+void e_sched_calibrate(e_sched_t *s, unsigned n)
+{
+	const unsigned ncores = s->ncores, nthreads = s->nthreads;
+
+	s->host_rate = 0.0;
+	s->core_rate = 0.0;
+	if (nthreads) {
+		s->ncores = 0;
+		e_sched_run(s, n);
+		s->ncores = ncores;
+	}
+	if (ncores) {
+		s->nthreads = 0;
+		e_sched_run(s, n);
+		s->nthreads = nthreads;
+	}
+}
@@ -0,0 +1,83 @@
+//
+// Splits batches of independent items between host threads and the e-cores.
+//
+// A batch is the range [0, n). The e-cores claim chunks from the front, the
+// host threads from the back, until the two ends meet. Every claim is half
+// of what is left times the claimant's share of the total rate, clamped to
+// [granule, max_job] for the e-cores. So each side starts with its
+// proportional split, and chunks shrink towards the meeting point, where
+// whoever is faster simply claims more. The rates come from
+// e_sched_calibrate() and are updated from every batch, which rebalances
+// the next split.
+//
+// The e-cores are driven from the calling thread through the command queues
+// (e_cmdq.h), up to E_SCHED_INFLIGHT jobs per core. Items are referred to
+// by index only; the callbacks map a range to work:
+//
+//   host_fn(ctx, begin, end)      : process [begin, end) on the CPU
+//   cmd_fn(ctx, cmd, begin, end)  : fill op/src/dst/count/arg of a job for
+//                                   [begin, end)
+//
+// Host side only, needs pthreads.
+//
+#ifndef E_SCHED_H_
+#define E_SCHED_H_
+
+#include <pthread.h>
+
+#include "e_cmdq.h"
+
+#define E_SCHED_MAX_THREADS (4)
+#define E_SCHED_INFLIGHT (2) // jobs per core, one running + one queued
+
+typedef void (*e_sched_host_fn_t)(void *ctx, unsigned begin, unsigned end);
+typedef void (*e_sched_cmd_fn_t)(void *ctx, e_cmd_t *cmd, unsigned begin,
+				 unsigned end);
+
+typedef struct {
+	e_cmdq_t *queues;
+	unsigned ncores;    // 0 runs everything on the host
+	unsigned nthreads;  // host worker threads, 0 runs everything on e-cores
+	unsigned granule;   // claims are multiples of this(DMA alignment)
+	unsigned max_job;   // items per e-core job
+	e_sched_host_fn_t host_fn;
+	e_sched_cmd_fn_t cmd_fn;
+	void *ctx;
+
+	// Items per us, whole host / all e-cores. Set by e_sched_calibrate(),
+	// updated after every e_sched_run().
+	double host_rate;
+	double core_rate;
+
+	// Last batch
+	unsigned host_items;
+	unsigned core_items;
+	unsigned core_jobs;
+	double usec;
+	int errors; // failed e-core jobs
+
+	// Claim state, shared with the host threads during e_sched_run().
+	pthread_mutex_t lock;
+	unsigned lo, hi;
+} e_sched_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void e_sched_init(e_sched_t *s, e_cmdq_t *queues, unsigned ncores,
+		  unsigned nthreads, e_sched_host_fn_t host_fn,
+		  e_sched_cmd_fn_t cmd_fn, void *ctx);
+void e_sched_destroy(e_sched_t *s);
+
+// Times n items on the host threads alone, then on the e-cores alone.
+void e_sched_calibrate(e_sched_t *s, unsigned n);
+
+// Processes [0, n). Returns the number of failed e-core jobs.
+int e_sched_run(e_sched_t *s, unsigned n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // E_SCHED_H_
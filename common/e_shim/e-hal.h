@@ -0,0 +1,106 @@
+//
+// Host shim for the Epiphany host library(e-hal).
+//
+// Provides the subset of e-hal used by the host programs in this repo so they
+// can be built and run on a plain Linux/x86 box. e-cores are emulated with
+// pthreads, each running the e-core program's main() (renamed to
+// e_shim_core_main() with -Dmain=e_shim_core_main when building for the shim).
+//
+// Limitations:
+//   * Globals in the e-core program are shared between emulated cores, so
+//     kernels must keep per-core state on the stack or in E_LOCAL_PTR() memory.
+//   * Absolute local addresses(e.g. (unsigned *)0x6000) must go through
+//     E_LOCAL_PTR() in ../e_shm.h.
+//
+#ifndef E_SHIM_E_HAL_H_
+#define E_SHIM_E_HAL_H_
+
+#include <sys/types.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define E_SHIM_ROWS (4)
+#define E_SHIM_COLS (4)
+#define E_SHIM_LOCAL_SIZE (0x8000) // 32KB per core
+#define E_SHIM_SHM_SIZE (0x02000000) // 32MB external memory
+
+#define E_OK (0)
+#define E_ERR (-1)
+
+typedef enum {
+	E_FALSE = 0,
+	E_TRUE = 1,
+} e_bool_t;
+
+typedef enum {
+	E_NULL = 0,
+	E_EPI_PLATFORM,
+	E_EPI_CHIP,
+	E_EPI_GROUP,
+	E_EPI_CORE,
+	E_EXT_MEM,
+	E_MAPPING,
+	E_SHARED_MEM,
+} e_objtype_t;
+
+typedef struct {
+	e_objtype_t objtype;
+	int initialized;
+	unsigned row;
+	unsigned col;
+	unsigned rows;
+	unsigned cols;
+} e_platform_t;
+
+typedef struct {
+	e_objtype_t objtype;
+	unsigned num_cores;
+	unsigned base_coreid;
+	unsigned row;
+	unsigned col;
+	unsigned rows;
+	unsigned cols;
+} e_epiphany_t;
+
+typedef struct {
+	e_objtype_t objtype;
+	off_t ephy_base; // offset from the external memory base
+	size_t map_size;
+	void *mapped_base;
+	void *base; // host pointer to the buffer
+	size_t size;
+} e_mem_t;
+
+int e_init(char *hdf);
+int e_finalize(void);
+int e_reset_system(void);
+int e_get_platform_info(e_platform_t *platform);
+
+int e_alloc(e_mem_t *mbuf, off_t offset, size_t size);
+int e_free(e_mem_t *mbuf);
+
+int e_open(e_epiphany_t *dev, unsigned row, unsigned col, unsigned rows,
+	   unsigned cols);
+int e_close(e_epiphany_t *dev);
+
+// `dev` is either e_epiphany_t *(core local memory) or e_mem_t *.
+ssize_t e_read(void *dev, unsigned row, unsigned col, off_t from_addr,
+	       void *buf, size_t size);
+ssize_t e_write(void *dev, unsigned row, unsigned col, off_t to_addr,
+		const void *buf, size_t size);
+
+int e_load(const char *executable, e_epiphany_t *dev, unsigned row,
+	   unsigned col, e_bool_t start);
+int e_load_group(const char *executable, e_epiphany_t *dev, unsigned row,
+		 unsigned col, unsigned rows, unsigned cols, e_bool_t start);
+int e_start(e_epiphany_t *dev, unsigned row, unsigned col);
+int e_start_group(e_epiphany_t *dev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // E_SHIM_E_HAL_H_
@@ -0,0 +1,128 @@
+//
+// Host shim for the Epiphany device library(e_lib).
+//
+// Lets e-core programs be compiled with the host compiler and run as pthreads
+// under the e-hal shim(see e-hal.h in this directory).
+//
+// ctimer counts down in emulated 600MHz clocks derived from CLOCK_MONOTONIC,
+// so cycle counts are only meaningful relative to each other.
+//
+#ifndef E_SHIM_E_LIB_H_
+#define E_SHIM_E_LIB_H_
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef E_HOST_SHIM
+#define E_HOST_SHIM (1)
+#endif
+
+#define E_SHIM_CLOCK_MHZ (600)
+
+#define SECTION(x)
+
+typedef unsigned int e_coreid_t;
+
+typedef struct {
+	unsigned group_id;
+	unsigned group_row;
+	unsigned group_col;
+	unsigned group_rows;
+	unsigned group_cols;
+	unsigned core_row;
+	unsigned core_col;
+} e_group_config_t;
+
+e_group_config_t *e_shim_group_config(void);
+#define e_group_config (*e_shim_group_config())
+
+e_coreid_t e_get_coreid(void);
+void e_coords_from_coreid(e_coreid_t coreid, unsigned *row, unsigned *col);
+
+// Address of `ptr`, local to this core, in the local memory of core (row, col)
+// of the group. Pointers outside local memory are returned unchanged.
+void *e_get_global_address(unsigned row, unsigned col, const void *ptr);
+
+// Base of this core's emulated 32KB local memory and of the emulated
+// external memory. Use through E_LOCAL_PTR()/E_SHM_PTR() in ../e_shm.h.
+char *e_shim_local_base(void);
+char *e_shim_shm_base(void);
+
+typedef enum {
+	E_CTIMER_0 = 0,
+	E_CTIMER_1 = 1,
+} e_ctimer_id_t;
+
+typedef enum {
+	E_CTIMER_OFF = 0x0,
+	E_CTIMER_CLK = 0x1,
+	E_CTIMER_IDLE = 0x2,
+	E_CTIMER_IALU_INST = 0x4,
+	E_CTIMER_FPU_INST = 0x5,
+	E_CTIMER_DUAL_INST = 0x6,
+	E_CTIMER_E1_STALLS = 0x7,
+	E_CTIMER_RA_STALLS = 0x8,
+	E_CTIMER_EXT_FETCH_STALLS = 0xc,
+	E_CTIMER_EXT_LOAD_STALLS = 0xd,
+} e_ctimer_config_t;
+
+#define E_CTIMER_MAX (~0U)
+
+unsigned e_ctimer_get(e_ctimer_id_t timer);
+unsigned e_ctimer_set(e_ctimer_id_t timer, unsigned val);
+unsigned e_ctimer_start(e_ctimer_id_t timer, e_ctimer_config_t config);
+unsigned e_ctimer_stop(e_ctimer_id_t timer);
+void e_wait(e_ctimer_id_t timer, unsigned int clicks);
+
+int e_dma_copy(void *dst, void *src, size_t n);
+
+// DMA engine. The shim runs a transfer to completion inside e_dma_start(), so
+// e_dma_busy() is always 0 and the DMA/compute overlap is not emulated.
+// Descriptor chaining(E_DMA_CHAIN) is not supported.
+typedef enum {
+	E_DMA_0 = 0,
+	E_DMA_1 = 1,
+} e_dma_id_t;
+
+typedef enum {
+	E_DMA_ENABLE = (1 << 0),
+	E_DMA_MASTER = (1 << 1),
+	E_DMA_CHAIN = (1 << 2),
+	E_DMA_STARTUP = (1 << 3),
+	E_DMA_IRQEN = (1 << 4),
+	E_DMA_BYTE = (0 << 5),
+	E_DMA_HWORD = (1 << 5),
+	E_DMA_WORD = (2 << 5),
+	E_DMA_DWORD = (3 << 5),
+	E_DMA_MSGMODE = (1 << 10),
+	E_DMA_SHIFT_SRC_IN = (1 << 12),
+	E_DMA_SHIFT_DST_IN = (1 << 13),
+	E_DMA_SHIFT_SRC_OUT = (1 << 14),
+	E_DMA_SHIFT_DST_OUT = (1 << 15),
+} e_dma_config_t;
+
+typedef struct {
+	unsigned config;
+	unsigned inner_stride; // dst << 16 | src
+	unsigned count; // outer << 16 | inner
+	unsigned outer_stride; // dst << 16 | src
+	void *src_addr;
+	void *dst_addr;
+} e_dma_desc_t;
+
+void e_dma_set_desc(e_dma_id_t chan, unsigned config, e_dma_desc_t *next_desc,
+		    unsigned strd_i_src, unsigned strd_i_dst, unsigned count_i,
+		    unsigned count_o, unsigned strd_o_src, unsigned strd_o_dst,
+		    void *addr_src, void *addr_dst, e_dma_desc_t *desc);
+int e_dma_start(e_dma_desc_t *descriptor, e_dma_id_t chan);
+int e_dma_busy(e_dma_id_t chan);
+void e_dma_wait(e_dma_id_t chan);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // E_SHIM_E_LIB_H_
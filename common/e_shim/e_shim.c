@@ -0,0 +1,422 @@
+//
+// Host shim implementation of e-hal and e_lib.
+// See e-hal.h for how e-core programs are built against it.
+//
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "e-hal.h"
+#include "e_lib.h"
+
+#define E_SHIM_NUM_CORES (E_SHIM_ROWS * E_SHIM_COLS)
+
+// Parallella E16 coordinates of core (0, 0).
+#define E_SHIM_FIRST_ROW (32)
+#define E_SHIM_FIRST_COL (8)
+
+// Weak, so benchmarks that call e_lib directly from the host thread link
+// without a core program.
+extern int e_shim_core_main() __attribute__((weak));
+
+typedef struct {
+	unsigned start;
+	unsigned long long t0; // emulated clocks when the timer was (re)started
+	int running;
+} shim_ctimer_t;
+
+typedef struct {
+	e_group_config_t config;
+	shim_ctimer_t ctimer[2];
+	char *local;
+	volatile int running; // program started and not returned yet
+} shim_core_t;
+
+static unsigned char gShimShm[E_SHIM_SHM_SIZE];
+static unsigned char gShimLocal[E_SHIM_NUM_CORES][E_SHIM_LOCAL_SIZE];
+static shim_core_t gShimCores[E_SHIM_NUM_CORES];
+static __thread shim_core_t *tShimCore = NULL;
+static int gShimInitialized = 0;
+
+// Host thread(outside of any emulated core) sees core (0, 0). Benchmarks that
+// run e_lib code on the host thread may skip e_init().
+static shim_core_t *current_core(void)
+{
+	if (tShimCore) {
+		return tShimCore;
+	}
+	if (!gShimInitialized) {
+		e_init(NULL);
+	}
+	return &gShimCores[0];
+}
+
+static unsigned long long now_clocks(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec) *
+	       E_SHIM_CLOCK_MHZ / 1000;
+}
+
+//
+// e_lib
+//
+
+e_group_config_t *e_shim_group_config(void)
+{
+	return &current_core()->config;
+}
+
+e_coreid_t e_get_coreid(void)
+{
+	const e_group_config_t *c = &current_core()->config;
+	return ((c->group_row + c->core_row) << 6) |
+	       (c->group_col + c->core_col);
+}
+
+void e_coords_from_coreid(e_coreid_t coreid, unsigned *row, unsigned *col)
+{
+	*row = ((coreid >> 6) & 0x3f) - current_core()->config.group_row;
+	*col = (coreid & 0x3f) - current_core()->config.group_col;
+}
+
+void *e_get_global_address(unsigned row, unsigned col, const void *ptr)
+{
+	const shim_core_t *core = current_core();
+	const size_t addr = (size_t)((const char *)ptr - core->local);
+	if (addr >= E_SHIM_LOCAL_SIZE) {
+		return (void *)ptr;
+	}
+	return gShimLocal[row * E_SHIM_COLS + col] + addr;
+}
+
+char *e_shim_local_base(void)
+{
+	return current_core()->local;
+}
+
+char *e_shim_shm_base(void)
+{
+	return (char *)gShimShm;
+}
+
+unsigned e_ctimer_get(e_ctimer_id_t timer)
+{
+	shim_ctimer_t *t = &current_core()->ctimer[timer];
+	if (!t->running) {
+		return t->start;
+	}
+	return t->start - (unsigned)(now_clocks() - t->t0);
+}
+
+unsigned e_ctimer_set(e_ctimer_id_t timer, unsigned val)
+{
+	shim_ctimer_t *t = &current_core()->ctimer[timer];
+	t->start = val;
+	t->t0 = now_clocks();
+	return val;
+}
+
+unsigned e_ctimer_start(e_ctimer_id_t timer, e_ctimer_config_t config)
+{
+	shim_ctimer_t *t = &current_core()->ctimer[timer];
+	// Only the clock mode is emulated. Event modes never count.
+	t->running = (config == E_CTIMER_CLK);
+	t->t0 = now_clocks();
+	return t->start;
+}
+
+unsigned e_ctimer_stop(e_ctimer_id_t timer)
+{
+	shim_ctimer_t *t = &current_core()->ctimer[timer];
+	t->start = e_ctimer_get(timer);
+	t->running = 0;
+	return t->start;
+}
+
+void e_wait(e_ctimer_id_t timer, unsigned int clicks)
+{
+	const unsigned long long end = now_clocks() + clicks;
+	(void)timer;
+	// Give the CPU to the other emulated cores while polling.
+	while (now_clocks() < end) {
+		sched_yield();
+	}
+}
+
+int e_dma_copy(void *dst, void *src, size_t n)
+{
+	memcpy(dst, src, n);
+	return 0;
+}
+
+void e_dma_set_desc(e_dma_id_t chan, unsigned config, e_dma_desc_t *next_desc,
+		    unsigned strd_i_src, unsigned strd_i_dst, unsigned count_i,
+		    unsigned count_o, unsigned strd_o_src, unsigned strd_o_dst,
+		    void *addr_src, void *addr_dst, e_dma_desc_t *desc)
+{
+	(void)chan;
+	(void)next_desc;
+	desc->config = config;
+	desc->inner_stride = ((strd_i_dst & 0xffff) << 16) | (strd_i_src & 0xffff);
+	desc->count = ((count_o & 0xffff) << 16) | (count_i & 0xffff);
+	desc->outer_stride = ((strd_o_dst & 0xffff) << 16) | (strd_o_src & 0xffff);
+	desc->src_addr = addr_src;
+	desc->dst_addr = addr_dst;
+}
+
+// Same walk as the hardware: the inner stride is added after every element
+// but the last of a row, where the outer stride is added instead. Strides are
+// signed 16 bit.
+int e_dma_start(e_dma_desc_t *descriptor, e_dma_id_t chan)
+{
+	const unsigned size = 1u << ((descriptor->config >> 5) & 3);
+	const unsigned count_i = descriptor->count & 0xffff;
+	const unsigned count_o = descriptor->count >> 16;
+	const short strd_i_src = (short)(descriptor->inner_stride & 0xffff);
+	const short strd_i_dst = (short)(descriptor->inner_stride >> 16);
+	const short strd_o_src = (short)(descriptor->outer_stride & 0xffff);
+	const short strd_o_dst = (short)(descriptor->outer_stride >> 16);
+	const char *src = (const char *)descriptor->src_addr;
+	char *dst = (char *)descriptor->dst_addr;
+	unsigned i, j;
+
+	if ((unsigned)chan > E_DMA_1) {
+		return -1;
+	}
+	for (j = 0; j < count_o; j++) {
+		if (count_i && (strd_i_src == (short)size) &&
+		    (strd_i_dst == (short)size)) {
+			memcpy(dst, src, count_i * size);
+			src += (count_i - 1) * size + strd_o_src;
+			dst += (count_i - 1) * size + strd_o_dst;
+			continue;
+		}
+		for (i = 0; i < count_i; i++) {
+			memcpy(dst, src, size);
+			src += (i + 1 < count_i) ? strd_i_src : strd_o_src;
+			dst += (i + 1 < count_i) ? strd_i_dst : strd_o_dst;
+		}
+	}
+	return 0;
+}
+
+int e_dma_busy(e_dma_id_t chan)
+{
+	(void)chan;
+	return 0;
+}
+
+void e_dma_wait(e_dma_id_t chan)
+{
+	while (e_dma_busy(chan)) {
+	}
+}
+
+//
+// e-hal
+//
+
+int e_init(char *hdf)
+{
+	unsigned i;
+	(void)hdf;
+	for (i = 0; i < E_SHIM_NUM_CORES; i++) {
+		shim_core_t *core = &gShimCores[i];
+		// Like the chip, cores keep running across e_finalize()/e_init().
+		if (core->running) {
+			continue;
+		}
+		memset(core, 0, sizeof(*core));
+		core->config.group_row = E_SHIM_FIRST_ROW;
+		core->config.group_col = E_SHIM_FIRST_COL;
+		core->config.group_rows = E_SHIM_ROWS;
+		core->config.group_cols = E_SHIM_COLS;
+		core->config.core_row = i / E_SHIM_COLS;
+		core->config.core_col = i % E_SHIM_COLS;
+		core->local = (char *)gShimLocal[i];
+	}
+	gShimInitialized = 1;
+	return E_OK;
+}
+
+int e_finalize(void)
+{
+	gShimInitialized = 0;
+	return E_OK;
+}
+
+int e_reset_system(void)
+{
+	memset(gShimLocal, 0, sizeof(gShimLocal));
+	return E_OK;
+}
+
+int e_get_platform_info(e_platform_t *platform)
+{
+	platform->objtype = E_EPI_PLATFORM;
+	platform->initialized = gShimInitialized;
+	platform->row = E_SHIM_FIRST_ROW;
+	platform->col = E_SHIM_FIRST_COL;
+	platform->rows = E_SHIM_ROWS;
+	platform->cols = E_SHIM_COLS;
+	return E_OK;
+}
+
+int e_alloc(e_mem_t *mbuf, off_t offset, size_t size)
+{
+	if ((offset < 0) || ((size_t)offset + size > E_SHIM_SHM_SIZE)) {
+		return E_ERR;
+	}
+	mbuf->objtype = E_SHARED_MEM;
+	mbuf->ephy_base = offset;
+	mbuf->map_size = size;
+	mbuf->mapped_base = gShimShm + offset;
+	mbuf->base = gShimShm + offset;
+	mbuf->size = size;
+	return E_OK;
+}
+
+int e_free(e_mem_t *mbuf)
+{
+	mbuf->base = NULL;
+	mbuf->mapped_base = NULL;
+	return E_OK;
+}
+
+int e_open(e_epiphany_t *dev, unsigned row, unsigned col, unsigned rows,
+	   unsigned cols)
+{
+	if ((row + rows > E_SHIM_ROWS) || (col + cols > E_SHIM_COLS)) {
+		return E_ERR;
+	}
+	dev->objtype = E_EPI_GROUP;
+	dev->row = row;
+	dev->col = col;
+	dev->rows = rows;
+	dev->cols = cols;
+	dev->num_cores = rows * cols;
+	dev->base_coreid =
+	    ((E_SHIM_FIRST_ROW + row) << 6) | (E_SHIM_FIRST_COL + col);
+	return E_OK;
+}
+
+int e_close(e_epiphany_t *dev)
+{
+	dev->objtype = E_NULL;
+	return E_OK;
+}
+
+static char *access_ptr(void *dev, unsigned row, unsigned col, off_t addr,
+			size_t size)
+{
+	e_objtype_t type = *(e_objtype_t *)dev;
+	if (type == E_SHARED_MEM) {
+		e_mem_t *mem = (e_mem_t *)dev;
+		if ((addr < 0) || ((size_t)addr + size > mem->size)) {
+			return NULL;
+		}
+		return (char *)mem->base + addr;
+	} else if (type == E_EPI_GROUP) {
+		e_epiphany_t *d = (e_epiphany_t *)dev;
+		if ((row >= d->rows) || (col >= d->cols) || (addr < 0) ||
+		    ((size_t)addr + size > E_SHIM_LOCAL_SIZE)) {
+			return NULL;
+		}
+		return (char *)
+		    gShimLocal[(d->row + row) * E_SHIM_COLS + (d->col + col)] +
+		       addr;
+	}
+	return NULL;
+}
+
+ssize_t e_read(void *dev, unsigned row, unsigned col, off_t from_addr,
+	       void *buf, size_t size)
+{
+	char *p = access_ptr(dev, row, col, from_addr, size);
+	if (!p) {
+		return E_ERR;
+	}
+	__sync_synchronize();
+	memcpy(buf, p, size);
+	return (ssize_t)size;
+}
+
+ssize_t e_write(void *dev, unsigned row, unsigned col, off_t to_addr,
+		const void *buf, size_t size)
+{
+	char *p = access_ptr(dev, row, col, to_addr, size);
+	if (!p) {
+		return E_ERR;
+	}
+	memcpy(p, buf, size);
+	__sync_synchronize();
+	return (ssize_t)size;
+}
+
+int e_load(const char *executable, e_epiphany_t *dev, unsigned row,
+	   unsigned col, e_bool_t start)
+{
+	return e_load_group(executable, dev, row, col, 1, 1, start);
+}
+
+// The program is linked into the host binary, so loading only resets the
+// cores' local memory.
+int e_load_group(const char *executable, e_epiphany_t *dev, unsigned row,
+		 unsigned col, unsigned rows, unsigned cols, e_bool_t start)
+{
+	unsigned i, j;
+	(void)executable;
+	for (i = row; i < row + rows; i++) {
+		for (j = col; j < col + cols; j++) {
+			memset(gShimLocal[(dev->row + i) * E_SHIM_COLS +
+					  (dev->col + j)],
+			       0, E_SHIM_LOCAL_SIZE);
+			if (start) {
+				e_start(dev, i, j);
+			}
+		}
+	}
+	return E_OK;
+}
+
+static void *core_thread(void *arg)
+{
+	tShimCore = (shim_core_t *)arg;
+	if (e_shim_core_main) {
+		e_shim_core_main();
+	}
+	tShimCore->running = 0;
+	return NULL;
+}
+
+int e_start(e_epiphany_t *dev, unsigned row, unsigned col)
+{
+	pthread_t th;
+	shim_core_t *core =
+	    &gShimCores[(dev->row + row) * E_SHIM_COLS + (dev->col + col)];
+	core->running = 1;
+	if (pthread_create(&th, NULL, core_thread, core) != 0) {
+		core->running = 0;
+		return E_ERR;
+	}
+	pthread_detach(th);
+	return E_OK;
+}
+
+int e_start_group(e_epiphany_t *dev)
+{
+	unsigned i, j;
+	for (i = 0; i < dev->rows; i++) {
+		for (j = 0; j < dev->cols; j++) {
+			if (e_start(dev, i, j) != E_OK) {
+				return E_ERR;
+			}
+		}
+	}
+	return E_OK;
+}
@@ -0,0 +1,33 @@
+//
+// Address helpers shared by e-core programs, host programs and the host shim.
+//
+// External memory(shared DRAM) is addressed by offset from its base, the same
+// way e_alloc() does on the host. fast.ldf puts the "shared_dram" section at
+// offset _BufOffset(0x01000000), so the first 1MB from there is left to the
+// linker and everything else below is handed out by offset.
+//
+#ifndef E_SHM_H_
+#define E_SHM_H_
+
+// External memory base as seen from the e-cores.
+#define E_SHM_BASE (0x8e000000)
+#define E_SHM_SIZE (0x02000000)
+
+// Fixed layout inside the shared DRAM window.
+#define E_SHM_MSG_OFFSET (0x01000000) // "shared_dram" section(outbuf)
+#define E_SHM_CMDQ_OFFSET (0x01100000) // e_cmdq_t per core
+#define E_SHM_RT_OFFSET (0x01180000) // e_rt_header_t(e_rt.h)
+#define E_SHM_DATA_OFFSET (0x01200000) // job payloads
+#define E_SHM_TRACE_OFFSET (0x01f00000) // e_trace_ring_t per core(e_trace.h)
+#define E_SHM_TRACE_SIZE (E_SHM_SIZE - E_SHM_TRACE_OFFSET)
+#define E_SHM_DATA_SIZE (E_SHM_TRACE_OFFSET - E_SHM_DATA_OFFSET)
+
+#if defined(E_HOST_SHIM)
+#define E_SHM_PTR(off) ((void *)(e_shim_shm_base() + (off)))
+#define E_LOCAL_PTR(addr) ((void *)(e_shim_local_base() + (addr)))
+#else
+#define E_SHM_PTR(off) ((void *)(E_SHM_BASE + (off)))
+#define E_LOCAL_PTR(addr) ((void *)(addr))
+#endif
+
+#endif // E_SHM_H_
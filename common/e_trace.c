@@ -0,0 +1,74 @@
+//
+// e-core side of e_trace.h. Compiles to nothing unless E_TRACE is set.
+//
+#include "e_lib.h"
+
+#include "e_banks.h"
+#include "e_trace.h"
+
+#if E_TRACE
+
+static E_CORE_LOCAL e_trace_ring_t *tRing;
+static E_CORE_LOCAL unsigned int tIndex;
+static E_CORE_LOCAL uint32_t tCount;
+// Clocks before the last re-arm of ctimer 1.
+static E_CORE_LOCAL unsigned long long tBase;
+
+void e_trace_init(void)
+{
+	const unsigned index = e_group_config.core_row *
+				       e_group_config.group_cols +
+			       e_group_config.core_col;
+
+	tRing = (e_trace_ring_t *)E_SHM_PTR(E_SHM_TRACE_OFFSET) + index;
+	tIndex = 0;
+	tCount = 0;
+	tBase = 0;
+
+	tRing->coreid = e_get_coreid();
+	tRing->count = 0;
+	tRing->magic = E_TRACE_MAGIC;
+
+	e_ctimer_set(E_CTIMER_1, E_CTIMER_MAX);
+	e_ctimer_start(E_CTIMER_1, E_CTIMER_CLK);
+}
+
+// ctimer 1 counts down from E_CTIMER_MAX. It is re-armed once it is half way
+// down, so it never stops as long as it is read(an event, e_trace_clock() or
+// E_TRACE_TICK()) every ~3.5s.
+static unsigned long long trace_clock64(void)
+{
+	const unsigned v = e_ctimer_get(E_CTIMER_1);
+	const unsigned long long t = tBase + (E_CTIMER_MAX - v);
+
+	if (v < (E_CTIMER_MAX >> 1)) {
+		e_ctimer_set(E_CTIMER_1, E_CTIMER_MAX);
+		tBase = t;
+	}
+	return t;
+}
+
+uint32_t e_trace_clock(void)
+{
+	return (uint32_t)trace_clock64();
+}
+
+void e_trace_emit(unsigned int type, unsigned int phase, uint32_t arg,
+		  uint32_t arg2)
+{
+	const unsigned long long t = trace_clock64();
+	e_trace_event_t ev;
+
+	ev.time_lo = (uint32_t)t;
+	ev.time_hi = (uint16_t)(t >> 32);
+	ev.type = type;
+	ev.phase = phase;
+	ev.arg = arg;
+	ev.arg2 = arg2;
+
+	tRing->ev[tIndex] = ev;
+	tIndex = (tIndex + 1 == E_TRACE_RING) ? 0 : tIndex + 1;
+	tRing->count = ++tCount;
+}
+
+#endif // E_TRACE
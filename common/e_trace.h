@@ -0,0 +1,110 @@
+//
+// Per-core timeline tracing.
+//
+// Each core appends 16 byte events to its own ring in shared DRAM
+// (E_SHM_TRACE_OFFSET + index * sizeof(e_trace_ring_t)): one posted write
+// for the event and one for the count, no reads. When the ring is full the
+// oldest events are overwritten. After the run the host turns the rings into
+// a Chrome/Perfetto JSON trace with one track per core(e_trace_json.c).
+//
+// Events:
+//   E_TRACE_KERNEL  begin/end of a job handler, arg = op(e_cmdq_serve())
+//   E_TRACE_CLAIM   job taken from the command queue, arg = seq
+//   E_TRACE_DMA     issue(begin)/complete(end), arg = bytes, arg2 = channel
+//   E_TRACE_SEND    message written to another core, arg = its coreid
+//   E_TRACE_RECV    message arrived from another core, arg = its coreid
+//
+// Timestamps come from ctimer 1, free running from e_trace_init()(called by
+// e_cmdq_serve()), so kernels can't use ctimer 1 while tracing. Tracks are
+// aligned to within the skew of the core start times. The 32 bit counter is
+// extended in software whenever it is read, so a loop that can wait for
+// seconds without emitting events calls E_TRACE_TICK()(the idle poll of
+// e_cmdq_serve() does).
+//
+// Build with -DE_TRACE=1 and link e_trace.c into the e-core program. Without
+// it the E_TRACE_*() macros compile to nothing.
+//
+#ifndef E_TRACE_H_
+#define E_TRACE_H_
+
+#include <stdint.h>
+
+#include "e_shm.h"
+
+#ifndef E_TRACE
+#define E_TRACE (0)
+#endif
+
+#define E_TRACE_CLOCK_MHZ (600)
+#define E_TRACE_MAX_CORES (64)
+// 16KB per core with the header, 1MB for 64 cores.
+#define E_TRACE_RING (1023)
+#define E_TRACE_MAGIC (0x43525445) // "ETRC"
+
+enum {
+	E_TRACE_KERNEL = 0,
+	E_TRACE_CLAIM = 1,
+	E_TRACE_DMA = 2,
+	E_TRACE_SEND = 3,
+	E_TRACE_RECV = 4,
+};
+
+enum {
+	E_TRACE_PH_BEGIN = 0,
+	E_TRACE_PH_END = 1,
+	E_TRACE_PH_INSTANT = 2,
+};
+
+typedef struct {
+	uint32_t time_lo; // clocks since e_trace_init()
+	uint16_t time_hi;
+	uint8_t type;  // E_TRACE_*
+	uint8_t phase; // E_TRACE_PH_*
+	uint32_t arg;
+	uint32_t arg2;
+} e_trace_event_t; // 16 bytes
+
+typedef struct {
+	volatile uint32_t magic;
+	volatile uint32_t count; // events written, the ring holds the last ones
+	uint32_t coreid;
+	uint32_t pad;
+	e_trace_event_t ev[E_TRACE_RING];
+} e_trace_ring_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// e-core side, e_trace.c. Needs e_lib.h(real or shim).
+void e_trace_init(void);
+uint32_t e_trace_clock(void); // clocks since e_trace_init(), wraps
+void e_trace_emit(unsigned int type, unsigned int phase, uint32_t arg,
+		  uint32_t arg2);
+
+// Host side, e_trace_json.c. `rings` is the mapped E_SHM_TRACE_OFFSET
+// region. Returns 0 on success.
+void e_trace_clear(void *rings, unsigned ncores);
+int e_trace_write_json(const char *filename, const void *rings,
+		       unsigned ncores, unsigned cols, double clock_mhz);
+
+#ifdef __cplusplus
+}
+#endif
+
+#if E_TRACE
+#define E_TRACE_BEGIN(type, arg, arg2) \
+	e_trace_emit((type), E_TRACE_PH_BEGIN, (arg), (arg2))
+#define E_TRACE_END(type, arg, arg2) \
+	e_trace_emit((type), E_TRACE_PH_END, (arg), (arg2))
+#define E_TRACE_INSTANT(type, arg, arg2) \
+	e_trace_emit((type), E_TRACE_PH_INSTANT, (arg), (arg2))
+#define E_TRACE_TICK() ((void)e_trace_clock())
+#else
+#define E_TRACE_BEGIN(type, arg, arg2) ((void)0)
+#define E_TRACE_END(type, arg, arg2) ((void)0)
+#define E_TRACE_INSTANT(type, arg, arg2) ((void)0)
+#define E_TRACE_TICK() ((void)0)
+#endif
+
+#endif // E_TRACE_H_
@@ -0,0 +1,115 @@
+//
+// Host side of e_trace.h: per-core rings -> Chrome trace event JSON, opens in
+// chrome://tracing and https://ui.perfetto.dev.
+//
+// One process, one thread(track) per core named "core (row, col)". Kernels
+// are B/E slices, job claims and messages are instants, and DMA transfers are
+// async slices(b/e) per core and channel since they overlap the kernel.
+//
+#include <stdio.h>
+#include <string.h>
+
+#include "e_cmdq.h"
+#include "e_trace.h"
+
+static const char *const kOpNames[] = {
+	"nop",		 "quit",	  "exp",	 "trace",
+	"softmax_stats", "softmax_scale", "exp_stream",
+};
+
+void e_trace_clear(void *rings, unsigned ncores)
+{
+	memset(rings, 0, ncores * sizeof(e_trace_ring_t));
+}
+
+static void write_event(FILE *fp, unsigned tid, const e_trace_event_t *ev,
+			double us)
+{
+	static const char kPhase[3] = {'B', 'E', 'i'};
+	const char ph = kPhase[ev->phase % 3];
+
+	switch (ev->type) {
+	case E_TRACE_KERNEL:
+		if (ev->arg < sizeof(kOpNames) / sizeof(kOpNames[0])) {
+			fprintf(fp, "{\"name\":\"%s\"", kOpNames[ev->arg]);
+		} else {
+			fprintf(fp, "{\"name\":\"op %u\"", ev->arg);
+		}
+		fprintf(fp, ",\"cat\":\"kernel\",\"ph\":\"%c\"", ph);
+		break;
+	case E_TRACE_CLAIM:
+		fprintf(fp,
+			"{\"name\":\"claim\",\"cat\":\"cmdq\",\"ph\":\"i\","
+			"\"s\":\"t\",\"args\":{\"seq\":%u}",
+			ev->arg);
+		break;
+	case E_TRACE_DMA:
+		fprintf(fp,
+			"{\"name\":\"dma%u\",\"cat\":\"dma\",\"ph\":\"%c\","
+			"\"id\":%u,\"args\":{\"bytes\":%u}",
+			ev->arg2, (ph == 'B') ? 'b' : 'e', tid * 2 + ev->arg2,
+			ev->arg);
+		break;
+	case E_TRACE_SEND:
+	case E_TRACE_RECV:
+		fprintf(fp,
+			"{\"name\":\"%s\",\"cat\":\"msg\",\"ph\":\"i\","
+			"\"s\":\"t\",\"args\":{\"peer\":\"(%u, %u)\",\"arg\":%u}",
+			(ev->type == E_TRACE_SEND) ? "send" : "recv",
+			(ev->arg >> 6) & 0x3f, ev->arg & 0x3f, ev->arg2);
+		break;
+	default:
+		fprintf(fp, "{\"name\":\"event %u\",\"ph\":\"i\",\"s\":\"t\"",
+			ev->type);
+		break;
+	}
+	fprintf(fp, ",\"pid\":0,\"tid\":%u,\"ts\":%.3f}", tid, us);
+}
+
+int e_trace_write_json(const char *filename, const void *rings,
+		       unsigned ncores, unsigned cols, double clock_mhz)
+{
+	const e_trace_ring_t *ring = (const e_trace_ring_t *)rings;
+	FILE *fp = fopen(filename, "w");
+	unsigned k, i;
+
+	if (!fp) {
+		return -1;
+	}
+
+	fprintf(fp, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+	fprintf(fp, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,"
+		    "\"args\":{\"name\":\"epiphany\"}}");
+	for (k = 0; (k < ncores) && (k < E_TRACE_MAX_CORES); k++) {
+		const e_trace_ring_t *r = &ring[k];
+		const uint32_t count = r->count;
+		const uint32_t n = (count < E_TRACE_RING) ? count : E_TRACE_RING;
+		const uint32_t first = count - n;
+
+		if (r->magic != E_TRACE_MAGIC) {
+			continue;
+		}
+		fprintf(fp,
+			",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,"
+			"\"tid\":%u,\"args\":{\"name\":\"core (%u, %u)\"}}",
+			k, k / cols, k % cols);
+		if (count > E_TRACE_RING) {
+			fprintf(stderr,
+				"[e_trace] core (%u, %u): dropped %u oldest "
+				"events\n",
+				k / cols, k % cols, count - E_TRACE_RING);
+		}
+		for (i = 0; i < n; i++) {
+			const e_trace_event_t *ev =
+				&r->ev[(first + i) % E_TRACE_RING];
+			const unsigned long long t =
+				((unsigned long long)ev->time_hi << 32) |
+				ev->time_lo;
+			fprintf(fp, ",\n");
+			write_event(fp, k, ev, t / clock_mhz);
+		}
+	}
+	fprintf(fp, "\n]}\n");
+
+	return fclose(fp) ? -1 : 0;
+}
@@ -0,0 +1,158 @@
+//
+// Persistent exp kernel. Loaded once, then serves E_CMD_EXP(_STREAM) and
+// softmax jobs posted by host_server.c/host_softmax.c through the command
+// queue(../common/e_cmdq.h) until E_CMD_QUIT.
+//
+#include <stdlib.h>
+
+#include "e_lib.h"
+
+#include "e_banks.h"
+#include "e_cmdq.h"
+#include "fast_exp.h"
+
+// Floats per chunk copied into local memory. Multiple of 16 keeps every
+// tuned width off the scalar tail.
+#define EXP_CHUNK (256)
+
+static E_CORE_LOCAL float in[EXP_CHUNK] E_BANK_DATA;
+static E_CORE_LOCAL float out[EXP_CHUNK] E_BANK_DATA;
+
+static int exp_job(const e_cmd_t *cmd)
+{
+	const float *src = (const float *)E_SHM_PTR(cmd->src);
+	float *dst = (float *)E_SHM_PTR(cmd->dst);
+	unsigned int i;
+
+	for (i = 0; i < cmd->count; i += EXP_CHUNK) {
+		unsigned int n = cmd->count - i;
+		n = (n > EXP_CHUNK) ? EXP_CHUNK : n;
+
+		e_dma_copy(in, (void *)(src + i), n * sizeof(float));
+		exp_accurate_n(out, in, n);
+		e_dma_copy(dst + i, out, n * sizeof(float));
+	}
+
+	return E_CMD_OK;
+}
+
+// Large arrays: overlaps the external memory transfers with compute.
+static int exp_stream_job(const e_cmd_t *cmd)
+{
+	fmath_exp_stream((float *)E_SHM_PTR(cmd->dst),
+			 (const float *)E_SHM_PTR(cmd->src), (int)cmd->count);
+
+	return E_CMD_OK;
+}
+
+typedef union {
+	unsigned int i;
+	float f;
+} bits_t;
+
+// Online (max, sum) of one part of a softmax vector.
+static int softmax_stats_job(const e_cmd_t *cmd)
+{
+	const float *src = (const float *)E_SHM_PTR(cmd->src);
+	float *dst = (float *)E_SHM_PTR(cmd->dst);
+	float m = 0.0f, d = 0.0f;
+	unsigned int i;
+
+	if (cmd->count == 0) {
+		return E_CMD_EINVAL;
+	}
+
+	for (i = 0; i < cmd->count; i += EXP_CHUNK) {
+		unsigned int n = cmd->count - i;
+		n = (n > EXP_CHUNK) ? EXP_CHUNK : n;
+
+		e_dma_copy(in, (void *)(src + i), n * sizeof(float));
+		if (i == 0) {
+			m = in[0];
+		}
+		softmax_stats_n(&m, &d, in, n);
+	}
+	out[0] = m;
+	out[1] = d;
+	e_dma_copy(dst, out, 2 * sizeof(float));
+
+	return E_CMD_OK;
+}
+
+static int softmax_scale_job(const e_cmd_t *cmd)
+{
+	const float *src = (const float *)E_SHM_PTR(cmd->src);
+	float *dst = (float *)E_SHM_PTR(cmd->dst);
+	bits_t m, inv_d;
+	unsigned int i;
+
+	m.i = cmd->arg[0];
+	inv_d.i = cmd->arg[1];
+
+	for (i = 0; i < cmd->count; i += EXP_CHUNK) {
+		unsigned int n = cmd->count - i;
+		n = (n > EXP_CHUNK) ? EXP_CHUNK : n;
+
+		e_dma_copy(in, (void *)(src + i), n * sizeof(float));
+		softmax_scale_n(out, in, n, m.f, inv_d.f);
+		e_dma_copy(dst + i, out, n * sizeof(float));
+	}
+
+	return E_CMD_OK;
+}
+
+// Independent short rows, each one local: softmax_n(), softmax_online_n()
+// or logsumexp_n() per row.
+static int softmax_rows_job(const e_cmd_t *cmd)
+{
+	const float *src = (const float *)E_SHM_PTR(cmd->src);
+	float *dst = (float *)E_SHM_PTR(cmd->dst);
+	const unsigned int len = cmd->arg[0];
+	unsigned int r;
+
+	if ((len == 0) || (len > EXP_CHUNK) ||
+	    (cmd->arg[1] > E_SOFTMAX_ROWS_LSE)) {
+		return E_CMD_EINVAL;
+	}
+
+	for (r = 0; r < cmd->count; r++) {
+		e_dma_copy(in, (void *)(src + r * len), len * sizeof(float));
+		if (cmd->arg[1] == E_SOFTMAX_ROWS_LSE) {
+			dst[r] = logsumexp_n(in, len);
+			continue;
+		}
+		if (cmd->arg[1] == E_SOFTMAX_ROWS_3PASS) {
+			softmax_n(out, in, len);
+		} else {
+			softmax_online_n(out, in, len);
+		}
+		e_dma_copy(dst + r * len, out, len * sizeof(float));
+	}
+
+	return E_CMD_OK;
+}
+
+static int exp_server_handler(const e_cmd_t *cmd)
+{
+	switch (cmd->op) {
+	case E_CMD_EXP:
+		return exp_job(cmd);
+	case E_CMD_EXP_STREAM:
+		return exp_stream_job(cmd);
+	case E_CMD_SOFTMAX_STATS:
+		return softmax_stats_job(cmd);
+	case E_CMD_SOFTMAX_SCALE:
+		return softmax_scale_job(cmd);
+	case E_CMD_SOFTMAX_ROWS:
+		return softmax_rows_job(cmd);
+	default:
+		return E_CMD_EUNKNOWN;
+	}
+}
+
+int main(void)
+{
+	e_cmdq_serve(e_cmdq_self(), exp_server_handler);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,104 @@
+//
+// exp() over arrays in external memory, larger than local memory.
+//
+// Chunks are double buffered in bank 2: while chunk c is computed from
+// in[c & 1] into out[c & 1], DMA channel 0 loads chunk c + 1 into the other
+// input buffer and DMA channel 1 writes chunk c - 1 back. Once a chunk takes
+// longer to compute than to move, the loop runs at compute speed.
+//
+// E_CMD_EXP_STREAM in e_exp_server.c, host_server.c reports bytes/cycle and
+// elements/cycle.
+//
+#include "e_lib.h"
+
+#include "e_banks.h"
+#include "e_trace.h"
+#include "fast_exp.h"
+
+// Floats per chunk. 2 x (in + out) = 4KB of bank 2.
+#define STREAM_CHUNK (256)
+
+static E_CORE_LOCAL float in[2][STREAM_CHUNK] E_BANK_DATA;
+static E_CORE_LOCAL float out[2][STREAM_CHUNK] E_BANK_DATA;
+
+// A descriptor is read by the DMA engine while the transfer starts, one per
+// channel and only rewritten once the channel is idle.
+static E_CORE_LOCAL e_dma_desc_t desc[2];
+
+#if E_TRACE
+// Bytes in flight per channel, for the DMA complete event.
+static E_CORE_LOCAL unsigned int busy[2];
+#endif
+
+// Doubleword transfers when both ends are 8 byte aligned, words otherwise(an
+// odd-sized tail).
+static void stream_dma_start(e_dma_id_t chan, void *dst, const void *src,
+			     unsigned int n)
+{
+	const unsigned int bytes = n * sizeof(float);
+	unsigned int config = E_DMA_ENABLE | E_DMA_MASTER;
+	unsigned int size;
+
+	if ((((unsigned long)dst | (unsigned long)src | bytes) & 7) == 0) {
+		config |= E_DMA_DWORD;
+		size = 8;
+	} else {
+		config |= E_DMA_WORD;
+		size = 4;
+	}
+
+	e_dma_set_desc(chan, config, 0, size, size, bytes / size, 1, size,
+		       size, (void *)src, dst, &desc[chan]);
+#if E_TRACE
+	E_TRACE_BEGIN(E_TRACE_DMA, bytes, chan);
+	busy[chan] = bytes;
+#endif
+	e_dma_start(&desc[chan], chan);
+}
+
+static void stream_dma_wait(e_dma_id_t chan)
+{
+	e_dma_wait(chan);
+#if E_TRACE
+	if (busy[chan]) {
+		E_TRACE_END(E_TRACE_DMA, busy[chan], chan);
+		busy[chan] = 0;
+	}
+#endif
+}
+
+void fmath_exp_stream(float *y, const float *x, int n)
+{
+	const int nchunks = (n + STREAM_CHUNK - 1) / STREAM_CHUNK;
+	int c;
+
+	if (n <= 0) {
+		return;
+	}
+
+	stream_dma_start(E_DMA_0, in[0], x,
+			 (n < STREAM_CHUNK) ? n : STREAM_CHUNK);
+
+	for (c = 0; c < nchunks; c++) {
+		const int b = c & 1;
+		const int i = c * STREAM_CHUNK;
+		const int m = (n - i < STREAM_CHUNK) ? (n - i) : STREAM_CHUNK;
+
+		stream_dma_wait(E_DMA_0);
+		if (c + 1 < nchunks) {
+			const int i1 = i + STREAM_CHUNK;
+			const int m1 = (n - i1 < STREAM_CHUNK) ? (n - i1)
+							       : STREAM_CHUNK;
+			stream_dma_start(E_DMA_0, in[b ^ 1], x + i1, m1);
+		}
+
+		// out[b] was last written back for chunk c - 2, which finished
+		// before chunk c - 1 was started on the same channel.
+		exp_accurate_n(out[b], in[b], m);
+
+		stream_dma_wait(E_DMA_1);
+		stream_dma_start(E_DMA_1, y + i, out[b], m);
+	}
+
+	stream_dma_wait(E_DMA_1);
+}
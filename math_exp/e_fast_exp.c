@@ -5,11 +5,10 @@
 
 #include "e_lib.h"
 
-// GCC
-#define RESTRICT __restrict__
-
-extern float expapprox(float val);
-extern void expapprox4(float *RESTRICT dst, const float *src);
+#include "e_banks.h"
+#include "e_prof.h"
+#include "fast_exp.h"
+#include "fp16.h"
 
 //
 // -------------------------------------------------------------------------------------
@@ -32,6 +31,20 @@ extern void expapprox4(float *RESTRICT dst, const float *src);
 //  fmath_exp()  | scalar | 33 cycles
 //  fmath_exp4() | 4 SIMD | 18 cycles(74 in total)
 //
+//  fmath_exp*() are instantiations of fmath::Exp<table size, unroll, range
+//  check>(fmath_exp.hpp). `make sweep` times the whole grid.
+//
+//  Table-free fmath::PolyExp<degree>(Cody-Waite + minimax polynomial, no
+//  SRAM). Not measured on board yet, `make tune` prints the cycle counts.
+//
+//  degree       | 3      | 4      | 5      | 6
+//  max rel. diff| 7.5e-5 | 2.7e-6 | 2.2e-7 | 1.4e-7(float rounding bound,
+//                                 measured on the host over [-87.33, 88.72])
+//
+//  Integer-only fmath_exp_i(), fmath_exp4_i() and fmath_exp4_q16()(1 FPU op
+//  per element, see fmath_exp_i() below) are not measured on board yet,
+//  FMATH_EXP_TEST prints their cycle counts.
+//
 // 
 //  fmath_exp() is faster and more accurate than expapprox(), but with the cost of
 //  table buffer(512 byte ~ 4KB)
@@ -58,6 +71,16 @@ extern void expapprox4(float *RESTRICT dst, const float *src);
 //      8  (1KB)    | 3.263584e-07   | 0.000000e+00   | 1.651098e-06
 //      7  (512B)   | 1.233390e-06   | 0.000000e+00   | 3.771282e-06
 //
+//    * fmath_exp_h_n() fp16 in/out, [-8, 8]: max rel. diff = 4.8e-4(fp16
+//      rounding, measured on the host)
+//
+//    * fmath_exp_d()(fmath_exp_d.c, host only) tablesize = 11(16KB), cubic
+//      correction: [-700, 700] max rel. diff = 4.2e-16
+//
+//    * fmath_exp_i() tablesize = 7 + 7 fraction bits(512B + 512B)
+//
+//      [-87, 88] max rel. diff = 2.263240e-05(measured on the host)
+//
 //  - Note
 //    * -mfp-mode=truncate may loose some precison, but emits more optimal
 //    assembly.
@@ -74,10 +97,10 @@ extern void expapprox4(float *RESTRICT dst, const float *src);
 
 // base on fmath::exp https://github.com/herumi/fmath/blob/master/fmath.hpp
 
-#define FMATH_EXP_TABLE_SIZE	(7)
+// FMATH_EXP_TABLE_SIZE is set in fast_exp.h.
 
 #if (FMATH_EXP_TABLE_SIZE == 10)
-const unsigned int kFmathExpTable[1024] = {
+const unsigned int kFmathExpTable[1024] E_BANK_TABLE = {
   0x00000000, 0x00001630, 0x00002c64, 0x0000429c, 
   0x000058d8, 0x00006f17, 0x0000855b, 0x00009ba2, 
   0x0000b1ed, 0x0000c83c, 0x0000de8f, 0x0000f4e6, 
@@ -336,7 +359,7 @@ const unsigned int kFmathExpTable[1024] = {
   0x007f4ecb, 0x007f7b0d, 0x007fa756, 0x007fd3a7
 };
 #elif (FMATH_EXP_TABLE_SIZE == 8)
-const unsigned int kFmathExpTable[256] = {
+const unsigned int kFmathExpTable[256] E_BANK_TABLE = {
   0x00000000, 0x000058d8, 0x0000b1ed, 0x00010b41, 
   0x000164d2, 0x0001bea1, 0x000218af, 0x000272fc, 
   0x0002cd87, 0x00032850, 0x00038359, 0x0003dea1, 
@@ -403,7 +426,7 @@ const unsigned int kFmathExpTable[256] = {
   0x007d3e0c, 0x007dedd2, 0x007e9e11, 0x007f4ecb
 };
 #elif (FMATH_EXP_TABLE_SIZE == 7)
-const unsigned int kFmathExpTable[128] = {
+const unsigned int kFmathExpTable[128] E_BANK_TABLE = {
   0x00000000, 0x0000b1ed, 0x000164d2, 0x000218af, 
   0x0002cd87, 0x00038359, 0x00043a29, 0x0004f1f6, 
   0x0005aac3, 0x00066491, 0x00071f62, 0x0007db35, 
@@ -441,7 +464,118 @@ const unsigned int kFmathExpTable[128] = {
 #error invalid table size
 #endif
 
-inline unsigned int mask(int x)
+// Fraction table for fmath_exp_i(): 2^(i / (n * 128)) as float bits.
+// Generated with `fmath_exp_tablegen FMATH_EXP_TABLE_SIZE 7`.
+#define FMATH_EXP_FRAC_BITS	(7)
+
+#if (FMATH_EXP_TABLE_SIZE == 10)
+const unsigned int kFmathExpFracTable[128] E_BANK_TABLE = {
+  0x3f800000, 0x3f80002c, 0x3f800059, 0x3f800085, 
+  0x3f8000b1, 0x3f8000de, 0x3f80010a, 0x3f800137, 
+  0x3f800163, 0x3f80018f, 0x3f8001bc, 0x3f8001e8, 
+  0x3f800214, 0x3f800241, 0x3f80026d, 0x3f800299, 
+  0x3f8002c6, 0x3f8002f2, 0x3f80031f, 0x3f80034b, 
+  0x3f800377, 0x3f8003a4, 0x3f8003d0, 0x3f8003fc, 
+  0x3f800429, 0x3f800455, 0x3f800481, 0x3f8004ae, 
+  0x3f8004da, 0x3f800507, 0x3f800533, 0x3f80055f, 
+  0x3f80058c, 0x3f8005b8, 0x3f8005e4, 0x3f800611, 
+  0x3f80063d, 0x3f80066a, 0x3f800696, 0x3f8006c2, 
+  0x3f8006ef, 0x3f80071b, 0x3f800747, 0x3f800774, 
+  0x3f8007a0, 0x3f8007cd, 0x3f8007f9, 0x3f800825, 
+  0x3f800852, 0x3f80087e, 0x3f8008aa, 0x3f8008d7, 
+  0x3f800903, 0x3f80092f, 0x3f80095c, 0x3f800988, 
+  0x3f8009b5, 0x3f8009e1, 0x3f800a0d, 0x3f800a3a, 
+  0x3f800a66, 0x3f800a92, 0x3f800abf, 0x3f800aeb, 
+  0x3f800b18, 0x3f800b44, 0x3f800b70, 0x3f800b9d, 
+  0x3f800bc9, 0x3f800bf5, 0x3f800c22, 0x3f800c4e, 
+  0x3f800c7b, 0x3f800ca7, 0x3f800cd3, 0x3f800d00, 
+  0x3f800d2c, 0x3f800d59, 0x3f800d85, 0x3f800db1, 
+  0x3f800dde, 0x3f800e0a, 0x3f800e36, 0x3f800e63, 
+  0x3f800e8f, 0x3f800ebc, 0x3f800ee8, 0x3f800f14, 
+  0x3f800f41, 0x3f800f6d, 0x3f800f99, 0x3f800fc6, 
+  0x3f800ff2, 0x3f80101f, 0x3f80104b, 0x3f801077, 
+  0x3f8010a4, 0x3f8010d0, 0x3f8010fd, 0x3f801129, 
+  0x3f801155, 0x3f801182, 0x3f8011ae, 0x3f8011da, 
+  0x3f801207, 0x3f801233, 0x3f801260, 0x3f80128c, 
+  0x3f8012b8, 0x3f8012e5, 0x3f801311, 0x3f80133e, 
+  0x3f80136a, 0x3f801396, 0x3f8013c3, 0x3f8013ef, 
+  0x3f80141c, 0x3f801448, 0x3f801474, 0x3f8014a1, 
+  0x3f8014cd, 0x3f8014f9, 0x3f801526, 0x3f801552, 
+  0x3f80157f, 0x3f8015ab, 0x3f8015d7, 0x3f801604
+};
+#elif (FMATH_EXP_TABLE_SIZE == 8)
+const unsigned int kFmathExpFracTable[128] E_BANK_TABLE = {
+  0x3f800000, 0x3f8000b1, 0x3f800163, 0x3f800214, 
+  0x3f8002c6, 0x3f800377, 0x3f800429, 0x3f8004da, 
+  0x3f80058c, 0x3f80063d, 0x3f8006ef, 0x3f8007a0, 
+  0x3f800852, 0x3f800903, 0x3f8009b5, 0x3f800a66, 
+  0x3f800b18, 0x3f800bc9, 0x3f800c7b, 0x3f800d2c, 
+  0x3f800dde, 0x3f800e8f, 0x3f800f41, 0x3f800ff2, 
+  0x3f8010a4, 0x3f801155, 0x3f801207, 0x3f8012b8, 
+  0x3f80136a, 0x3f80141c, 0x3f8014cd, 0x3f80157f, 
+  0x3f801630, 0x3f8016e2, 0x3f801793, 0x3f801845, 
+  0x3f8018f6, 0x3f8019a8, 0x3f801a5a, 0x3f801b0b, 
+  0x3f801bbd, 0x3f801c6e, 0x3f801d20, 0x3f801dd2, 
+  0x3f801e83, 0x3f801f35, 0x3f801fe6, 0x3f802098, 
+  0x3f80214a, 0x3f8021fb, 0x3f8022ad, 0x3f80235f, 
+  0x3f802410, 0x3f8024c2, 0x3f802574, 0x3f802625, 
+  0x3f8026d7, 0x3f802789, 0x3f80283a, 0x3f8028ec, 
+  0x3f80299d, 0x3f802a4f, 0x3f802b01, 0x3f802bb3, 
+  0x3f802c64, 0x3f802d16, 0x3f802dc8, 0x3f802e79, 
+  0x3f802f2b, 0x3f802fdd, 0x3f80308e, 0x3f803140, 
+  0x3f8031f2, 0x3f8032a4, 0x3f803355, 0x3f803407, 
+  0x3f8034b9, 0x3f80356a, 0x3f80361c, 0x3f8036ce, 
+  0x3f803780, 0x3f803831, 0x3f8038e3, 0x3f803995, 
+  0x3f803a47, 0x3f803af8, 0x3f803baa, 0x3f803c5c, 
+  0x3f803d0e, 0x3f803dc0, 0x3f803e71, 0x3f803f23, 
+  0x3f803fd5, 0x3f804087, 0x3f804138, 0x3f8041ea, 
+  0x3f80429c, 0x3f80434e, 0x3f804400, 0x3f8044b2, 
+  0x3f804563, 0x3f804615, 0x3f8046c7, 0x3f804779, 
+  0x3f80482b, 0x3f8048dd, 0x3f80498e, 0x3f804a40, 
+  0x3f804af2, 0x3f804ba4, 0x3f804c56, 0x3f804d08, 
+  0x3f804db9, 0x3f804e6b, 0x3f804f1d, 0x3f804fcf, 
+  0x3f805081, 0x3f805133, 0x3f8051e5, 0x3f805297, 
+  0x3f805349, 0x3f8053fa, 0x3f8054ac, 0x3f80555e, 
+  0x3f805610, 0x3f8056c2, 0x3f805774, 0x3f805826
+};
+#elif (FMATH_EXP_TABLE_SIZE == 7)
+const unsigned int kFmathExpFracTable[128] E_BANK_TABLE = {
+  0x3f800000, 0x3f800163, 0x3f8002c6, 0x3f800429, 
+  0x3f80058c, 0x3f8006ef, 0x3f800852, 0x3f8009b5, 
+  0x3f800b18, 0x3f800c7b, 0x3f800dde, 0x3f800f41, 
+  0x3f8010a4, 0x3f801207, 0x3f80136a, 0x3f8014cd, 
+  0x3f801630, 0x3f801793, 0x3f8018f6, 0x3f801a5a, 
+  0x3f801bbd, 0x3f801d20, 0x3f801e83, 0x3f801fe6, 
+  0x3f80214a, 0x3f8022ad, 0x3f802410, 0x3f802574, 
+  0x3f8026d7, 0x3f80283a, 0x3f80299d, 0x3f802b01, 
+  0x3f802c64, 0x3f802dc8, 0x3f802f2b, 0x3f80308e, 
+  0x3f8031f2, 0x3f803355, 0x3f8034b9, 0x3f80361c, 
+  0x3f803780, 0x3f8038e3, 0x3f803a47, 0x3f803baa, 
+  0x3f803d0e, 0x3f803e71, 0x3f803fd5, 0x3f804138, 
+  0x3f80429c, 0x3f804400, 0x3f804563, 0x3f8046c7, 
+  0x3f80482b, 0x3f80498e, 0x3f804af2, 0x3f804c56, 
+  0x3f804db9, 0x3f804f1d, 0x3f805081, 0x3f8051e5, 
+  0x3f805349, 0x3f8054ac, 0x3f805610, 0x3f805774, 
+  0x3f8058d8, 0x3f805a3c, 0x3f805ba0, 0x3f805d03, 
+  0x3f805e67, 0x3f805fcb, 0x3f80612f, 0x3f806293, 
+  0x3f8063f7, 0x3f80655b, 0x3f8066bf, 0x3f806823, 
+  0x3f806987, 0x3f806aeb, 0x3f806c4f, 0x3f806db3, 
+  0x3f806f17, 0x3f80707c, 0x3f8071e0, 0x3f807344, 
+  0x3f8074a8, 0x3f80760c, 0x3f807770, 0x3f8078d4, 
+  0x3f807a39, 0x3f807b9d, 0x3f807d01, 0x3f807e65, 
+  0x3f807fca, 0x3f80812e, 0x3f808292, 0x3f8083f7, 
+  0x3f80855b, 0x3f8086bf, 0x3f808824, 0x3f808988, 
+  0x3f808aec, 0x3f808c51, 0x3f808db5, 0x3f808f1a, 
+  0x3f80907e, 0x3f8091e2, 0x3f809347, 0x3f8094ab, 
+  0x3f809610, 0x3f809774, 0x3f8098d9, 0x3f809a3e, 
+  0x3f809ba2, 0x3f809d07, 0x3f809e6b, 0x3f809fd0, 
+  0x3f80a135, 0x3f80a299, 0x3f80a3fe, 0x3f80a563, 
+  0x3f80a6c7, 0x3f80a82c, 0x3f80a991, 0x3f80aaf5, 
+  0x3f80ac5a, 0x3f80adbf, 0x3f80af24, 0x3f80b089
+};
+#endif
+
+static inline unsigned int mask(int x)
 {
 	return (1U << x) - 1;
 }
@@ -451,142 +585,8 @@ typedef union {
 	unsigned int i;
 } fi;
 
-float fmath_exp(float x) 
-{
-	const int s = FMATH_EXP_TABLE_SIZE;
-	const int n = 1 << s; 
-	const float a0 = n / logf(2.0);
-	const float b0 = logf(2.0) / n;
-	const float magic = (1 << 23) + (1 << 22); // to round
-
-	float t = x * a0;
-	t += magic;
-	fi fi;
-	fi.f = t;
-	t = x - (t - magic) * b0;
-	int u = ((fi.i + (127 << s)) >> s) << 23;
-	unsigned int v = fi.i & mask(s);
-	fi.i = u | kFmathExpTable[v];
-	return (1.0f + t) * fi.f;
-}
-
-void fmath_exp4(float* RESTRICT y, const float* RESTRICT x) 
-{
-	const int s = FMATH_EXP_TABLE_SIZE;
-	const int n = 1 << s; 
-	const float a0 = n / logf(2.0);
-	const float b0 = logf(2.0) / n;
-	const float magic = (1 << 23) + (1 << 22); // to round
-
-	float t0 = x[0] * a0;
-	float t1 = x[1] * a0;
-	float t2 = x[2] * a0;
-	float t3 = x[3] * a0;
-	t0 += magic;
-	t1 += magic;
-	t2 += magic;
-	t3 += magic;
-	fi fi0, fi1, fi2, fi3;
-	fi0.f = t0;
-	fi1.f = t1;
-	fi2.f = t2;
-	fi3.f = t3;
-	t0 = x[0] - (t0 - magic) * b0;
-	t1 = x[1] - (t1 - magic) * b0;
-	t2 = x[2] - (t2 - magic) * b0;
-	t3 = x[3] - (t3 - magic) * b0;
-	int u0 = ((fi0.i + (127 << s)) >> s) << 23;
-	int u1 = ((fi1.i + (127 << s)) >> s) << 23;
-	int u2 = ((fi2.i + (127 << s)) >> s) << 23;
-	int u3 = ((fi3.i + (127 << s)) >> s) << 23;
-	unsigned int v0 = fi0.i & mask(s);
-	unsigned int v1 = fi1.i & mask(s);
-	unsigned int v2 = fi2.i & mask(s);
-	unsigned int v3 = fi3.i & mask(s);
-	fi0.i = u0 | kFmathExpTable[v0];
-	fi1.i = u1 | kFmathExpTable[v1];
-	fi2.i = u2 | kFmathExpTable[v2];
-	fi3.i = u3 | kFmathExpTable[v3];
-	y[0] = (1.0f + t0) * fi0.f;
-	y[1] = (1.0f + t1) * fi1.f;
-	y[2] = (1.0f + t2) * fi2.f;
-	y[3] = (1.0f + t3) * fi3.f;
-}
-
-void fmath_exp8(float* y, const float* x) 
-{
-	const int s = FMATH_EXP_TABLE_SIZE;
-	const int n = 1 << s; 
-	const float a0 = n / logf(2.0);
-	const float b0 = logf(2.0) / n;
-	const float magic = (1 << 23) + (1 << 22); // to round
-
-	float t0 = x[0] * a0;
-	float t1 = x[1] * a0;
-	float t2 = x[2] * a0;
-	float t3 = x[3] * a0;
-	float t4 = x[4] * a0;
-	float t5 = x[5] * a0;
-	float t6 = x[6] * a0;
-	float t7 = x[7] * a0;
-	t0 += magic;
-	t1 += magic;
-	t2 += magic;
-	t3 += magic;
-	t4 += magic;
-	t5 += magic;
-	t6 += magic;
-	t7 += magic;
-	fi fi0, fi1, fi2, fi3, fi4, fi5, fi6, fi7;
-	fi0.f = t0;
-	fi1.f = t1;
-	fi2.f = t2;
-	fi3.f = t3;
-	fi4.f = t4;
-	fi5.f = t5;
-	fi6.f = t6;
-	fi7.f = t7;
-	t0 = x[0] - (t0 - magic) * b0;
-	t1 = x[1] - (t1 - magic) * b0;
-	t2 = x[2] - (t2 - magic) * b0;
-	t3 = x[3] - (t3 - magic) * b0;
-	t4 = x[3] - (t4 - magic) * b0;
-	t5 = x[5] - (t5 - magic) * b0;
-	t6 = x[6] - (t6 - magic) * b0;
-	t7 = x[7] - (t7 - magic) * b0;
-	int u0 = ((fi0.i + (127 << s)) >> s) << 23;
-	int u1 = ((fi1.i + (127 << s)) >> s) << 23;
-	int u2 = ((fi2.i + (127 << s)) >> s) << 23;
-	int u3 = ((fi3.i + (127 << s)) >> s) << 23;
-	int u4 = ((fi4.i + (127 << s)) >> s) << 23;
-	int u5 = ((fi5.i + (127 << s)) >> s) << 23;
-	int u6 = ((fi6.i + (127 << s)) >> s) << 23;
-	int u7 = ((fi7.i + (127 << s)) >> s) << 23;
-	unsigned int v0 = fi0.i & mask(s);
-	unsigned int v1 = fi1.i & mask(s);
-	unsigned int v2 = fi2.i & mask(s);
-	unsigned int v3 = fi3.i & mask(s);
-	unsigned int v4 = fi3.i & mask(s);
-	unsigned int v5 = fi5.i & mask(s);
-	unsigned int v6 = fi6.i & mask(s);
-	unsigned int v7 = fi7.i & mask(s);
-	fi0.i = u0 | kFmathExpTable[v0];
-	fi1.i = u1 | kFmathExpTable[v1];
-	fi2.i = u2 | kFmathExpTable[v2];
-	fi3.i = u3 | kFmathExpTable[v3];
-	fi4.i = u4 | kFmathExpTable[v4];
-	fi5.i = u5 | kFmathExpTable[v5];
-	fi6.i = u6 | kFmathExpTable[v6];
-	fi7.i = u7 | kFmathExpTable[v7];
-	y[0] = (1.0f + t0) * fi0.f;
-	y[1] = (1.0f + t1) * fi1.f;
-	y[2] = (1.0f + t2) * fi2.f;
-	y[3] = (1.0f + t3) * fi3.f;
-	y[4] = (1.0f + t4) * fi4.f;
-	y[5] = (1.0f + t5) * fi5.f;
-	y[6] = (1.0f + t6) * fi6.f;
-	y[7] = (1.0f + t7) * fi7.f;
-}
+// fmath_exp(), fmath_exp4() and fmath_exp8() are instantiated from the
+// fmath::Exp<> template in fmath_exp.cc.
 
 // Based on http://gallium.inria.fr/blog/fast-vectorizable-math-approx/
 
@@ -701,6 +701,164 @@ void expapprox4(float *RESTRICT dst, const float *RESTRICT src)
 	dst[3] = xu_3.f * (c0 + b3 * (c1 + b3 * (c2 + b3 * (c3 + b3 * c4))));
 }
 
+//
+// -------------------------------------------------------------------------------------
+// Integer-only exp.
+//
+// Argument reduction, table lookup and exponent assembly run on the IALU and
+// the only FPU instruction is the final multiply, so it can dual-issue next to
+// float heavy code. x is converted to Q22 fixed point with integer ops,
+// multiplied by log2(e) with shifts and adds, rounded, and split into
+//
+//   k : integer part                        -> exponent bits
+//   v : next FMATH_EXP_TABLE_SIZE bits      -> kFmathExpTable(mantissa)
+//   f : next FMATH_EXP_FRAC_BITS bits       -> kFmathExpFracTable(multiplier)
+//
+// exp(x) = 2^k * 2^(v / n) * 2^(f / (n * m)). The relative error is bounded by
+// ln(2) / (2 * n * m), 2.1e-5 for 7 + 7 bits. Results saturate to the
+// smallest normal / largest finite float outside of [-87.3, 88.7](incl.
+// -inf/+inf), NaN comes back as a quiet NaN.
+//
+// fmath_exp_q16()/fmath_exp_q24() take and return Q16/Q24 fixed point and
+// skip the float decode. Results saturate to 0x7fffffff(exp(x) >= 32768 for
+// Q16, >= 128 for Q24).
+//
+
+#define FMATH_EXP_Q	(22)
+#define FMATH_EXP_Q_MAX	(150 << FMATH_EXP_Q) // |x| >= 150 is out of range anyway
+// Bounds of y = x * log2(e) in Q22, so that k + 127 is a normal exponent.
+#define FMATH_EXP_Q_YMIN	(-(126 << FMATH_EXP_Q))
+#define FMATH_EXP_Q_YMAX	((128 << FMATH_EXP_Q) - 1)
+
+static inline int fmath_exp_clamp_q22(int q)
+{
+	q = (q > FMATH_EXP_Q_MAX) ? FMATH_EXP_Q_MAX : q;
+	q = (q < -FMATH_EXP_Q_MAX) ? -FMATH_EXP_Q_MAX : q;
+	return q;
+}
+
+// float bits -> Q22, integer ops only.
+static inline int fmath_exp_float_to_q22(unsigned int bits)
+{
+	const int e = (int)((bits >> 23) & 0xff) - 127;
+	const int m = (int)((bits & 0x7fffff) | 0x800000);
+	const int shift = e - 1; // m * 2^(e - 23) in Q22
+	int q;
+
+	if (shift >= 0) {
+		q = m << ((shift > 7) ? 7 : shift);
+	} else {
+		q = m >> ((-shift > 31) ? 31 : -shift);
+	}
+	q = fmath_exp_clamp_q22(q);
+	return (bits & 0x80000000) ? -q : q;
+}
+
+// Q22 float value -> exp() as float. One FPU multiply.
+static inline float fmath_exp_i_q22(int q)
+{
+	const int s = FMATH_EXP_TABLE_SIZE;
+	const int m = FMATH_EXP_FRAC_BITS;
+	fi e, f;
+	int y, k;
+	unsigned int v, u;
+
+	// y = q * log2(e), signed-digit shift-and-add(error < 2e-8).
+	y = q + (q >> 1) - (q >> 4) + (q >> 8) + (q >> 10) + (q >> 12) +
+	    (q >> 14) + (q >> 17) - (q >> 21) - (q >> 23);
+
+	// Round to nearest table entry, keep the exponent in normal range.
+	y += 1 << (FMATH_EXP_Q - s - m - 1);
+	y = (y < FMATH_EXP_Q_YMIN) ? FMATH_EXP_Q_YMIN : y;
+	y = (y > FMATH_EXP_Q_YMAX) ? FMATH_EXP_Q_YMAX : y;
+
+	k = y >> FMATH_EXP_Q;
+	v = (y >> (FMATH_EXP_Q - s)) & mask(s);
+	u = (y >> (FMATH_EXP_Q - s - m)) & mask(m);
+
+	e.i = ((k + 127) << 23) | kFmathExpTable[v];
+	f.i = kFmathExpFracTable[u];
+	return e.f * f.f;
+}
+
+// Positive float -> Qn, integer ops only. Saturates to 0x7fffffff.
+static inline int fmath_exp_float_to_q(float x, int n)
+{
+	fi b;
+	int e, m, shift;
+
+	b.f = x;
+	e = (int)((b.i >> 23) & 0xff) - 127;
+	m = (int)((b.i & 0x7fffff) | 0x800000);
+	shift = e - 23 + n;
+	if (shift > 7) {
+		return 0x7fffffff;
+	}
+	if (shift >= 0) {
+		return m << shift;
+	}
+	return m >> ((-shift > 31) ? 31 : -shift);
+}
+
+// The decode reads NaN as a huge magnitude, put the (quieted) NaN back with
+// a select on the input bits.
+static inline float fmath_exp_i_bits(unsigned int bits)
+{
+	fi r;
+	r.f = fmath_exp_i_q22(fmath_exp_float_to_q22(bits));
+	r.i = ((bits & 0x7fffffff) > 0x7f800000) ? (bits | 0x00400000) : r.i;
+	return r.f;
+}
+
+float fmath_exp_i(float x)
+{
+	fi b;
+	b.f = x;
+	return fmath_exp_i_bits(b.i);
+}
+
+void fmath_exp4_i(float *RESTRICT y, const float *RESTRICT x)
+{
+	fi b0, b1, b2, b3;
+	b0.f = x[0];
+	b1.f = x[1];
+	b2.f = x[2];
+	b3.f = x[3];
+	y[0] = fmath_exp_i_bits(b0.i);
+	y[1] = fmath_exp_i_bits(b1.i);
+	y[2] = fmath_exp_i_bits(b2.i);
+	y[3] = fmath_exp_i_bits(b3.i);
+}
+
+int fmath_exp_q16(int x)
+{
+	x = (x > (150 << 16)) ? (150 << 16) : x;
+	x = (x < -(150 << 16)) ? -(150 << 16) : x;
+	// Q16 -> Q22, a multiply since x may be negative.
+	return fmath_exp_float_to_q(fmath_exp_i_q22(x * 64), 16);
+}
+
+int fmath_exp_q24(int x)
+{
+	return fmath_exp_float_to_q(fmath_exp_i_q22(x >> 2), 24);
+}
+
+void fmath_exp4_q16(int *RESTRICT y, const int *RESTRICT x)
+{
+	y[0] = fmath_exp_q16(x[0]);
+	y[1] = fmath_exp_q16(x[1]);
+	y[2] = fmath_exp_q16(x[2]);
+	y[3] = fmath_exp_q16(x[3]);
+}
+
+void fmath_exp4_q24(int *RESTRICT y, const int *RESTRICT x)
+{
+	y[0] = fmath_exp_q24(x[0]);
+	y[1] = fmath_exp_q24(x[1]);
+	y[2] = fmath_exp_q24(x[2]);
+	y[3] = fmath_exp_q24(x[3]);
+}
+
 //
 // -------------------------------------------------------------------------------------
 //
@@ -853,6 +1011,49 @@ void validateFmathExp(float retDiff[3], float beginValue, float endValue)
 	retDiff[2] = maxDiff;
 }
 
+void validateFmathExpI(float retDiff[3], float beginValue, float endValue)
+{
+	int n = WAIT_MICROSECONDS / 250 / TEST_NUM; // 250 = emprically found value.
+	union {
+		int i;
+		float f;
+	} bv, ev, it;
+	bv.f = beginValue;
+	ev.f = endValue;
+	float step = (endValue - beginValue) / n;
+
+	it.i = bv.i;
+	int count = 0;
+	volatile float minDiff = 0.0f;
+	volatile float maxDiff = 0.0f;
+	volatile float aveDiff = 0.0f;
+	// for (; it.i < ev.i; it.i++) { // <-- e-gcc can't compile this loop
+	// ...
+	float f = beginValue;
+	for (f = beginValue; f < endValue; f += step) {
+
+		float ref = expf(f);
+		float ret = fmath_exp_i(f);
+		float diff = fabsf(ref - ret) / ref;
+
+		if (count == 0) {
+			minDiff = diff;
+			maxDiff = diff;
+		} else {
+			minDiff = (minDiff > diff) ? diff : minDiff;
+			maxDiff = (maxDiff < diff) ? diff : maxDiff;
+		}
+		aveDiff += diff;
+		count++;
+	}
+
+	aveDiff /= (float)count;
+
+	retDiff[0] = aveDiff;
+	retDiff[1] = minDiff;
+	retDiff[2] = maxDiff;
+}
+
 void validateFmathExp4(float retDiff[3], float beginValue, float endValue)
 {
 	int n = WAIT_MICROSECONDS / 250 / TEST_NUM; // 250 = emprically found value.
@@ -905,7 +1106,32 @@ void validateFmathExp4(float retDiff[3], float beginValue, float endValue)
 	retDiff[2] = maxDiff;
 }
 
+// Local arrays for timing fmath_exp4() over a buffer. With E_BANKS_PINNED they
+// live in bank 2, away from the code(bank 0) and kFmathExpTable(bank 1).
+#define BANK_BENCH_N (256)
+float gBankBenchIn[BANK_BENCH_N] E_BANK_DATA;
+float gBankBenchOut[BANK_BENCH_N] E_BANK_DATA;
+
 char outbuf[4096] SECTION("shared_dram");
+
+// Event counters(../common/e_prof.h) over the local arrays above.
+static void prof_fmath_exp4(void *arg)
+{
+	int i;
+	(void)arg;
+	for (i = 0; i < BANK_BENCH_N; i += 4) {
+		fmath_exp4(gBankBenchOut + i, gBankBenchIn + i);
+	}
+}
+
+static void prof_expapprox4(void *arg)
+{
+	int i;
+	(void)arg;
+	for (i = 0; i < BANK_BENCH_N; i += 4) {
+		expapprox4(gBankBenchOut + i, gBankBenchIn + i);
+	}
+}
 int main(void)
 {
 	e_coreid_t coreid;
@@ -1061,6 +1287,231 @@ int main(void)
 						 "%d).\n",
 			temp, temp / 4);
 	}
+	if (1) { // fmath_exp4 over a local array
+		for (i = 0; i < BANK_BENCH_N; i++) {
+			gBankBenchIn[i] = in_exp + 0.01f * i;
+		}
+
+		e_ctimer_set(E_CTIMER_1, E_CTIMER_MAX);
+		e_ctimer_start(E_CTIMER_1, E_CTIMER_CLK);
+		time_p = e_ctimer_get(E_CTIMER_1);
+
+		for (i = 0; i < BANK_BENCH_N; i += 4) {
+			fmath_exp4(gBankBenchOut + i, gBankBenchIn + i);
+		}
+
+		time_c = e_ctimer_get(E_CTIMER_1);
+		e_ctimer_stop(E_CTIMER_1);
+
+		temp = time_p - time_c - time_compare;
+
+		sprintf(outbuf + strlen(outbuf),
+			"\nThe clock cycle count for \"fmath_exp4()\" over %d "
+			"floats(banks pinned = %d) is %d (/%d = %d).\n",
+			BANK_BENCH_N, E_BANKS_PINNED, temp, BANK_BENCH_N,
+			temp / BANK_BENCH_N);
+	}
+	if (1) { // IPC and stalls over the same array
+		e_prof_t prof;
+
+		sprintf(outbuf + strlen(outbuf),
+			"\nEvent counters over %d floats, best of %d:\n",
+			BANK_BENCH_N, E_PROF_REPEAT);
+		e_prof_run(&prof, prof_fmath_exp4, NULL, E_PROF_REPEAT);
+		e_prof_print(outbuf + strlen(outbuf), "fmath_exp4()", &prof);
+		e_prof_run(&prof, prof_expapprox4, NULL, E_PROF_REPEAT);
+		e_prof_print(outbuf + strlen(outbuf), "expapprox4()", &prof);
+	}
+
+	if (1) { // fmath_exp_i
+		e_ctimer_set(E_CTIMER_1, E_CTIMER_MAX);
+		e_ctimer_start(E_CTIMER_1, E_CTIMER_CLK);
+		time_p = e_ctimer_get(E_CTIMER_1);
+
+		volatile float ret = fmath_exp_i(in_exp);
+
+		time_c = e_ctimer_get(E_CTIMER_1);
+		e_ctimer_stop(E_CTIMER_1);
+
+		temp = time_p - time_c - time_compare;
+
+		sprintf(outbuf + strlen(outbuf),
+			"\nThe clock cycle count for \"fmath_exp_i()\" is %d.\n",
+			temp);
+	}
+
+	if (1) { // fmath_exp4_i
+		e_ctimer_set(E_CTIMER_1, E_CTIMER_MAX);
+		e_ctimer_start(E_CTIMER_1, E_CTIMER_CLK);
+		time_p = e_ctimer_get(E_CTIMER_1);
+
+		fmath_exp4_i(out_exp_arr, in_exp_arr);
+
+		time_c = e_ctimer_get(E_CTIMER_1);
+		e_ctimer_stop(E_CTIMER_1);
+
+		// prevent compiler dead code optimization
+		volatile float ret = out_exp_arr[0] + out_exp_arr[1] +
+				     out_exp_arr[2] + out_exp_arr[3];
+
+		temp = time_p - time_c - time_compare;
+
+		sprintf(outbuf + strlen(outbuf), "\nThe clock cycle count for "
+						 "\"fmath_exp4_i()\" is %d (/4 = "
+						 "%d).\n",
+			temp, temp / 4);
+	}
+
+	if (1) { // fmath_exp4_q16
+		int in_q16[4], out_q16[4];
+		for (i = 0; i < 4; i++) {
+			in_q16[i] = (int)(in_exp_arr[i] * 65536.0f);
+		}
+
+		e_ctimer_set(E_CTIMER_1, E_CTIMER_MAX);
+		e_ctimer_start(E_CTIMER_1, E_CTIMER_CLK);
+		time_p = e_ctimer_get(E_CTIMER_1);
+
+		fmath_exp4_q16(out_q16, in_q16);
+
+		time_c = e_ctimer_get(E_CTIMER_1);
+		e_ctimer_stop(E_CTIMER_1);
+
+		// prevent compiler dead code optimization
+		volatile int ret = out_q16[0] + out_q16[1] + out_q16[2] +
+				   out_q16[3];
+
+		temp = time_p - time_c - time_compare;
+
+		sprintf(outbuf + strlen(outbuf), "\nThe clock cycle count for "
+						 "\"fmath_exp4_q16()\" is %d (/4 "
+						 "= %d).\n",
+			temp, temp / 4);
+	}
+
+	if (1) { // fmath_exp4_safe
+		e_ctimer_set(E_CTIMER_1, E_CTIMER_MAX);
+		e_ctimer_start(E_CTIMER_1, E_CTIMER_CLK);
+		time_p = e_ctimer_get(E_CTIMER_1);
+
+		fmath_exp4_safe(out_exp_arr, in_exp_arr);
+
+		time_c = e_ctimer_get(E_CTIMER_1);
+		e_ctimer_stop(E_CTIMER_1);
+
+		// prevent compiler dead code optimization
+		volatile float ret = out_exp_arr[0] + out_exp_arr[1] +
+				     out_exp_arr[2] + out_exp_arr[3];
+
+		temp = time_p - time_c - time_compare;
+
+		sprintf(outbuf + strlen(outbuf), "\nThe clock cycle count for "
+						 "\"fmath_exp4_safe()\" is %d (/4 "
+						 "= %d).\n",
+			temp, temp / 4);
+	}
+
+	if (1) { // fmath_exp_n special values
+		// NaN, +inf, -inf, 100, -100, 88.7, -87.5, 0
+		const unsigned int special[8] = {0x7fc00000, 0x7f800000,
+						 0xff800000, 0x42c80000,
+						 0xc2c80000, 0x42b16666,
+						 0xc2af0000, 0x00000000};
+		const unsigned int expected[8] = {0x7fc00000, 0x7f800000, 0,
+						  0x7f800000, 0, 0,
+						  0, 0x3f800000};
+		fi sx[8], sy[8];
+		int ok = 1;
+
+		for (i = 0; i < 8; i++) {
+			sx[i].i = special[i];
+		}
+		fmath_exp_n(&sy[0].f, &sx[0].f, 8);
+		for (i = 0; i < 8; i++) {
+			if (i == 5) { // exp(88.7) = 3.29e38, finite
+				ok &= (sy[i].i > 0x7f700000) &&
+				      (sy[i].i < 0x7f800000);
+			} else if (i == 7) {
+				ok &= (sy[i].i == expected[i]);
+			} else {
+				ok &= ((sy[i].i & 0x7fc00000) == expected[i]);
+			}
+		}
+
+		sprintf(outbuf + strlen(outbuf),
+			"\n\"fmath_exp_n()\" NaN/inf/saturation check: %s\n",
+			ok ? "OK" : "FAILED");
+	}
+
+	if (1) { // fmath_exp_i/fmath_exp4_i special values
+		// NaN, -NaN, +inf, -inf, 100, -100, 0, 1
+		const unsigned int special[8] = {0x7fc00000, 0xffc00001,
+						 0x7f800000, 0xff800000,
+						 0x42c80000, 0xc2c80000,
+						 0x00000000, 0x3f800000};
+		fi sx[8], sy[8];
+		int ok = 1;
+
+		for (i = 0; i < 8; i++) {
+			sx[i].i = special[i];
+		}
+		fmath_exp4_i(&sy[0].f, &sx[0].f);
+		fmath_exp4_i(&sy[4].f, &sx[4].f);
+		for (i = 0; i < 8; i++) {
+			const unsigned int b = sy[i].i & 0x7fffffff;
+			if (i < 2) { // quiet NaN
+				ok &= (b > 0x7f800000) && (sy[i].i & 0x00400000);
+			} else if ((i == 2) || (i == 4)) { // largest finite range
+				ok &= (b > 0x7f000000) && (b < 0x7f800000);
+			} else if ((i == 3) || (i == 5)) { // smallest normal range
+				ok &= (b >= 0x00800000) && (b < 0x01000000);
+			} else if (i == 6) {
+				ok &= (sy[i].i == 0x3f800000);
+			} else { // e
+				ok &= (sy[i].f > 2.7182f) && (sy[i].f < 2.7184f);
+			}
+		}
+		sy[0].f = fmath_exp_i(sx[0].f);
+		ok &= ((sy[0].i & 0x7fc00000) == 0x7fc00000);
+
+		sprintf(outbuf + strlen(outbuf),
+			"\n\"fmath_exp_i()\" NaN/inf/saturation check: %s\n",
+			ok ? "OK" : "FAILED");
+	}
+
+	if (1) { // fmath_exp_h_n over a local array(fp16 in/out)
+		unsigned short *hin = (unsigned short *)gBankBenchIn;
+		unsigned short *hout = (unsigned short *)gBankBenchOut;
+		float maxDiff = 0.0f;
+
+		for (i = 0; i < BANK_BENCH_N; i++) {
+			hin[i] = fp16_from_float(-8.0f + 0.0625f * i);
+		}
+
+		e_ctimer_set(E_CTIMER_1, E_CTIMER_MAX);
+		e_ctimer_start(E_CTIMER_1, E_CTIMER_CLK);
+		time_p = e_ctimer_get(E_CTIMER_1);
+
+		fmath_exp_h_n(hout, hin, BANK_BENCH_N);
+
+		time_c = e_ctimer_get(E_CTIMER_1);
+		e_ctimer_stop(E_CTIMER_1);
+
+		temp = time_p - time_c - time_compare;
+
+		for (i = 0; i < BANK_BENCH_N; i++) {
+			float ref = expf(fp16_to_float(hin[i]));
+			float diff = fabsf(fp16_to_float(hout[i]) - ref) / ref;
+			maxDiff = (diff > maxDiff) ? diff : maxDiff;
+		}
+
+		sprintf(outbuf + strlen(outbuf),
+			"\nThe clock cycle count for \"fmath_exp_h_n()\" over %d "
+			"halfs is %d (/%d = %d), max rel. diff = %d e-6.\n",
+			BANK_BENCH_N, temp, BANK_BENCH_N, temp / BANK_BENCH_N,
+			(int)(maxDiff * 1.0e6f));
+	}
+
 	// Validation
 	{
 		float diffs[3];
@@ -1068,6 +1519,7 @@ int main(void)
 		//validateExp4(diffs, -3.0f, 3.0f);
 		//validateFmathExp(diffs, -30.0f, 30.0f);
 		//validateFmathExp4(diffs, -30.0f, 30.0f);
+		//validateFmathExpI(diffs, -30.0f, 30.0f);
 
 		mailbox[0] = 1;
 		mailbox[1] = *((unsigned int *)&diffs[0]); // ave
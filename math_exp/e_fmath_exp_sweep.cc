@@ -0,0 +1,168 @@
+//
+// Benchmark sweep over the fmath::Exp<> parameter grid(fmath_exp.hpp):
+//
+//   table size  : 7(512B), 8(1KB), 10(4KB)
+//   unroll      : 1, 2, 4, 8, 16
+//   range check : NoRangeCheck, ClampRange, SafeRange
+//
+// Each variant evaluates SWEEP_N floats from local memory. Cycle counts are
+// the best of SWEEP_REPEAT runs, the relative error is against expf() over
+// [-30, 30]. Build with FMATH_EXP_TABLE_SIZE=10, the 8 and 7 bit tables are
+// every 4th/8th entry of the 10 bit table.
+//
+// Results go to outbuf like e_fast_exp.c, run with `./test
+// e_fmath_exp_sweep.srec`. `make sweep_shim` builds the same sweep for the
+// host CPU, where the wider unrolls are picked up by the auto vectorizer.
+//
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include "e_lib.h"
+#ifdef __cplusplus
+}
+#endif
+
+#include "e_banks.h"
+#include "e_shm.h"
+#include "fmath_exp.hpp"
+
+#if (FMATH_EXP_TABLE_SIZE != 10)
+#error "e_fmath_exp_sweep needs FMATH_EXP_TABLE_SIZE=10"
+#endif
+
+#define SWEEP_N (256)
+#ifdef E_HOST_SHIM
+#define SWEEP_REPEAT (64)
+#else
+#define SWEEP_REPEAT (4)
+#endif
+
+static unsigned int gTable8[1 << 8] E_BANK_TABLE;
+static unsigned int gTable7[1 << 7] E_BANK_TABLE;
+
+float gSweepIn[SWEEP_N] E_BANK_DATA;
+float gSweepOut[SWEEP_N] E_BANK_DATA;
+float gSweepRef[SWEEP_N] E_BANK_DATA;
+
+char outbuf[4096] SECTION("shared_dram");
+
+static unsigned int gTimeCompare;
+
+template <int S, int W, class Range>
+static unsigned int sweep_one(const unsigned int *table, float *maxDiff)
+{
+	unsigned int best = E_CTIMER_MAX;
+	unsigned int time_p, time_c;
+	int r, i;
+
+	for (r = 0; r < SWEEP_REPEAT; r++) {
+		e_ctimer_set(E_CTIMER_1, E_CTIMER_MAX);
+		e_ctimer_start(E_CTIMER_1, E_CTIMER_CLK);
+		time_p = e_ctimer_get(E_CTIMER_1);
+
+		for (i = 0; i < SWEEP_N; i += W) {
+			fmath::Exp<S, W, Range>::eval(gSweepOut + i,
+						      gSweepIn + i, table);
+		}
+
+		time_c = e_ctimer_get(E_CTIMER_1);
+		e_ctimer_stop(E_CTIMER_1);
+
+		time_p = time_p - time_c - gTimeCompare;
+		best = (time_p < best) ? time_p : best;
+	}
+
+	*maxDiff = 0.0f;
+	for (i = 0; i < SWEEP_N; i++) {
+		float diff = fabsf(gSweepOut[i] - gSweepRef[i]) / gSweepRef[i];
+		*maxDiff = (diff > *maxDiff) ? diff : *maxDiff;
+	}
+
+	return best;
+}
+
+// One output line: cycles/element x100 for every unroll width, then the max.
+// rel. diff in units of 1e-8(no float printf on the e-core).
+template <int S, class Range>
+static void sweep_row(const char *rangeName, const unsigned int *table)
+{
+	unsigned int c[5];
+	float d;
+
+	c[0] = sweep_one<S, 1, Range>(table, &d);
+	c[1] = sweep_one<S, 2, Range>(table, &d);
+	c[2] = sweep_one<S, 4, Range>(table, &d);
+	c[3] = sweep_one<S, 8, Range>(table, &d);
+	c[4] = sweep_one<S, 16, Range>(table, &d);
+
+	sprintf(outbuf + strlen(outbuf), "%5d | %-5s |", S, rangeName);
+	for (int k = 0; k < 5; k++) {
+		unsigned int x100 = c[k] * 100 / SWEEP_N;
+		sprintf(outbuf + strlen(outbuf), " %4d.%02d", x100 / 100,
+			x100 % 100);
+	}
+	sprintf(outbuf + strlen(outbuf), " | %6d\n", (int)(d * 1.0e8f));
+}
+
+#ifdef E_HOST_SHIM
+extern "C"
+#endif
+int main(void)
+{
+	unsigned *mailbox;
+	unsigned int time_p, time_c;
+	int i;
+
+	mailbox = (unsigned *)E_LOCAL_PTR(E_MAILBOX_ADDR);
+	mailbox[0] = 0;
+	mailbox[1] = 0xFFFFFFFF;
+	mailbox[2] = 0xFFFFFFFF;
+	mailbox[3] = 0xFFFFFFFF;
+	sprintf(outbuf, "");
+
+	// Get time waste on functions
+	e_ctimer_set(E_CTIMER_0, E_CTIMER_MAX);
+	time_p = e_ctimer_start(E_CTIMER_0, E_CTIMER_CLK);
+	time_c = e_ctimer_get(E_CTIMER_0);
+	e_ctimer_stop(E_CTIMER_0);
+	gTimeCompare = time_p - time_c;
+
+	for (i = 0; i < (1 << 8); i++) {
+		gTable8[i] = kFmathExpTable[i << 2];
+	}
+	for (i = 0; i < (1 << 7); i++) {
+		gTable7[i] = kFmathExpTable[i << 3];
+	}
+	for (i = 0; i < SWEEP_N; i++) {
+		gSweepIn[i] = -30.0f + 60.0f * (float)i / (float)SWEEP_N;
+		gSweepRef[i] = expf(gSweepIn[i]);
+	}
+
+	sprintf(outbuf + strlen(outbuf),
+		"\nfmath::Exp<> cycles/element over %d floats\n"
+		"table | range |     x1      x2      x4      x8     x16 | "
+		"max rel. diff(1e-8)\n",
+		SWEEP_N);
+	sweep_row<10, fmath::NoRangeCheck>("none", kFmathExpTable);
+	sweep_row<10, fmath::ClampRange>("clamp", kFmathExpTable);
+	sweep_row<10, fmath::SafeRange>("safe", kFmathExpTable);
+	sweep_row<8, fmath::NoRangeCheck>("none", gTable8);
+	sweep_row<8, fmath::ClampRange>("clamp", gTable8);
+	sweep_row<8, fmath::SafeRange>("safe", gTable8);
+	sweep_row<7, fmath::NoRangeCheck>("none", gTable7);
+	sweep_row<7, fmath::ClampRange>("clamp", gTable7);
+	sweep_row<7, fmath::SafeRange>("safe", gTable7);
+
+#ifdef E_HOST_SHIM
+	fputs(outbuf, stdout);
+#endif
+
+	mailbox[0] = 1;
+
+	return EXIT_SUCCESS;
+}
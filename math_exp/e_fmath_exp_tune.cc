@@ -0,0 +1,266 @@
+//
+// Build-time auto-tuner for exp_fast_n()/exp_accurate_n().
+//
+// Times every kernel/width pair of fmath::Kernel<>(fmath_exp.hpp) over
+// TUNE_N floats in local memory, measures the max. rel. diff against expf()
+// over the whole non-saturating range [TUNE_MIN_X, TUNE_MAX_X], and prints
+// the header with the fastest pair within each accuracy tier. `make tune`
+// runs it on the e-core(through ./test) and writes fmath_exp_tuned.h,
+// `make tune_shim` runs it on the host CPU and writes fmath_exp_tuned_shim.h.
+// mailbox[0] goes to 1 once outbuf holds the whole header.
+//
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include "e_lib.h"
+#ifdef __cplusplus
+}
+#endif
+
+#include "e_banks.h"
+#include "e_shm.h"
+#include "fmath_exp.hpp"
+
+#define TUNE_N (256)
+#define TUNE_NUM_KERNELS (15)
+#ifdef E_HOST_SHIM
+#define TUNE_REPEAT (256)
+#else
+#define TUNE_REPEAT (4)
+#endif
+
+// Accuracy is checked on TUNE_ACC_CHUNKS x TUNE_N points spread over the
+// range, exp() of anything outside saturates to 0 or +inf. The expf()
+// reference(~140K clocks each on the e-core) is computed once into shared
+// DRAM.
+#define TUNE_ACC_CHUNKS (64)
+#define TUNE_ACC_N (TUNE_ACC_CHUNKS * TUNE_N)
+#define TUNE_MIN_X (-87.33f)
+#define TUNE_MAX_X (88.72f)
+
+// Accuracy tiers, see fast_exp.h.
+#define TUNE_FAST_MAX_DIFF (1.0e-5f)
+#define TUNE_ACCURATE_MAX_DIFF (5.0e-6f)
+
+#ifdef E_HOST_SHIM
+#define TUNE_MAKE "make tune_shim"
+#define TUNE_GUARD "FMATH_EXP_TUNED_SHIM_H_"
+#else
+#define TUNE_MAKE "make tune"
+#define TUNE_GUARD "FMATH_EXP_TUNED_H_"
+#endif
+
+#if defined(__epiphany__)
+#define TUNE_TARGET "epiphany"
+#elif defined(__aarch64__)
+#define TUNE_TARGET "aarch64"
+#elif defined(__arm__)
+#define TUNE_TARGET "arm"
+#elif defined(__x86_64__)
+#define TUNE_TARGET "x86_64"
+#else
+#define TUNE_TARGET "unknown"
+#endif
+
+typedef struct {
+	const char *name;
+	int kernel;
+	int width;
+	unsigned int clocks; // per TUNE_N floats
+	float maxDiff;
+} tune_result_t;
+
+float gTuneIn[TUNE_N] E_BANK_DATA;
+float gTuneOut[TUNE_N] E_BANK_DATA;
+
+char outbuf[4096] SECTION("shared_dram");
+float gTuneRef[TUNE_ACC_N] SECTION("shared_dram");
+
+static unsigned int gTimeCompare;
+
+// Timing input, the range most callers use.
+static void tune_input(void)
+{
+	int i;
+	for (i = 0; i < TUNE_N; i++) {
+		gTuneIn[i] = -30.0f + 60.0f * (float)i / (float)TUNE_N;
+	}
+}
+
+// Chunk k of the accuracy input, gTuneRef[k * TUNE_N..] holds its expf().
+static void tune_acc_input(int k)
+{
+	int i;
+	for (i = 0; i < TUNE_N; i++) {
+		gTuneIn[i] = TUNE_MIN_X + (TUNE_MAX_X - TUNE_MIN_X) *
+						  (float)(k * TUNE_N + i) /
+						  (float)(TUNE_ACC_N - 1);
+	}
+}
+
+template <int K, int W>
+static void tune_one(tune_result_t *r, const char *name)
+{
+	unsigned int time_p, time_c;
+	int k, i;
+
+	r->name = name;
+	r->kernel = K;
+	r->width = W;
+	r->clocks = E_CTIMER_MAX;
+	for (k = 0; k < TUNE_REPEAT; k++) {
+		e_ctimer_set(E_CTIMER_1, E_CTIMER_MAX);
+		e_ctimer_start(E_CTIMER_1, E_CTIMER_CLK);
+		time_p = e_ctimer_get(E_CTIMER_1);
+
+		for (i = 0; i < TUNE_N; i += W) {
+			fmath::Kernel<K, W>::eval(gTuneOut + i, gTuneIn + i);
+		}
+
+		time_c = e_ctimer_get(E_CTIMER_1);
+		e_ctimer_stop(E_CTIMER_1);
+
+		time_p = time_p - time_c - gTimeCompare;
+		r->clocks = (time_p < r->clocks) ? time_p : r->clocks;
+	}
+
+	r->maxDiff = 0.0f;
+	for (k = 0; k < TUNE_ACC_CHUNKS; k++) {
+		const float *ref = gTuneRef + k * TUNE_N;
+
+		tune_acc_input(k);
+		for (i = 0; i < TUNE_N; i += W) {
+			fmath::Kernel<K, W>::eval(gTuneOut + i, gTuneIn + i);
+		}
+		for (i = 0; i < TUNE_N; i++) {
+			float diff = fabsf(gTuneOut[i] - ref[i]) / ref[i];
+			r->maxDiff = (diff > r->maxDiff) ? diff : r->maxDiff;
+		}
+	}
+	tune_input();
+}
+
+// Fastest result within maxDiff. Falls back to the fastest of the most
+// accurate ones if no kernel qualifies.
+static const tune_result_t *tune_pick(const tune_result_t *r, int n,
+				      float maxDiff)
+{
+	const tune_result_t *best = NULL;
+	const tune_result_t *closest = &r[0];
+	int i;
+
+	for (i = 0; i < n; i++) {
+		if ((r[i].maxDiff <= maxDiff) &&
+		    ((best == NULL) || (r[i].clocks < best->clocks))) {
+			best = &r[i];
+		}
+		closest = (r[i].maxDiff < closest->maxDiff) ? &r[i] : closest;
+	}
+	return best ? best : tune_pick(r, n, closest->maxDiff);
+}
+
+// Clocks x100 / element and max. rel. diff x1e-8, no float printf on the
+// e-core.
+static void print_result(const char *prefix, const tune_result_t *r)
+{
+	unsigned int x100 = r->clocks * 100 / TUNE_N;
+	sprintf(outbuf + strlen(outbuf),
+		"%s%-14s x%-2d %4d.%02d clocks/elem, max rel. diff %d e-8\n",
+		prefix, r->name, r->width, x100 / 100, x100 % 100,
+		(int)(r->maxDiff * 1.0e8f));
+}
+
+static void print_tier(const char *tier, const tune_result_t *r)
+{
+	sprintf(outbuf + strlen(outbuf),
+		"#define FMATH_EXP_%s_KERNEL (%d)\n"
+		"#define FMATH_EXP_%s_WIDTH (%d)\n",
+		tier, r->kernel, tier, r->width);
+}
+
+#ifdef E_HOST_SHIM
+extern "C"
+#endif
+int main(void)
+{
+	tune_result_t r[TUNE_NUM_KERNELS];
+	const tune_result_t *fast, *accurate;
+	unsigned *mailbox;
+	unsigned int time_p, time_c;
+	int i, k;
+
+	mailbox = (unsigned *)E_LOCAL_PTR(E_MAILBOX_ADDR);
+	mailbox[0] = 0;
+	mailbox[1] = 0xFFFFFFFF;
+	mailbox[2] = 0xFFFFFFFF;
+	mailbox[3] = 0xFFFFFFFF;
+	sprintf(outbuf, "");
+
+	// Get time waste on functions
+	e_ctimer_set(E_CTIMER_0, E_CTIMER_MAX);
+	time_p = e_ctimer_start(E_CTIMER_0, E_CTIMER_CLK);
+	time_c = e_ctimer_get(E_CTIMER_0);
+	e_ctimer_stop(E_CTIMER_0);
+	gTimeCompare = time_p - time_c;
+
+	for (k = 0; k < TUNE_ACC_CHUNKS; k++) {
+		tune_acc_input(k);
+		for (i = 0; i < TUNE_N; i++) {
+			gTuneRef[k * TUNE_N + i] = expf(gTuneIn[i]);
+		}
+	}
+	tune_input();
+
+	tune_one<FMATH_EXP_KERNEL_EXPAPPROX, 1>(&r[0], "expapprox");
+	tune_one<FMATH_EXP_KERNEL_EXPAPPROX, 4>(&r[1], "expapprox");
+	tune_one<FMATH_EXP_KERNEL_FMATH, 1>(&r[2], "fmath");
+	tune_one<FMATH_EXP_KERNEL_FMATH, 2>(&r[3], "fmath");
+	tune_one<FMATH_EXP_KERNEL_FMATH, 4>(&r[4], "fmath");
+	tune_one<FMATH_EXP_KERNEL_FMATH, 8>(&r[5], "fmath");
+	tune_one<FMATH_EXP_KERNEL_FMATH, 16>(&r[6], "fmath");
+	tune_one<FMATH_EXP_KERNEL_POLY(3), 4>(&r[7], "poly3");
+	tune_one<FMATH_EXP_KERNEL_POLY(3), 8>(&r[8], "poly3");
+	tune_one<FMATH_EXP_KERNEL_POLY(4), 4>(&r[9], "poly4");
+	tune_one<FMATH_EXP_KERNEL_POLY(4), 8>(&r[10], "poly4");
+	tune_one<FMATH_EXP_KERNEL_POLY(5), 4>(&r[11], "poly5");
+	tune_one<FMATH_EXP_KERNEL_POLY(5), 8>(&r[12], "poly5");
+	tune_one<FMATH_EXP_KERNEL_POLY(6), 4>(&r[13], "poly6");
+	tune_one<FMATH_EXP_KERNEL_POLY(6), 8>(&r[14], "poly6");
+
+	fast = tune_pick(r, TUNE_NUM_KERNELS, TUNE_FAST_MAX_DIFF);
+	accurate = tune_pick(r, TUNE_NUM_KERNELS, TUNE_ACCURATE_MAX_DIFF);
+
+	sprintf(outbuf + strlen(outbuf),
+		"#ifndef " TUNE_GUARD "\n"
+		"#define " TUNE_GUARD "\n"
+		"//\n"
+		"// Generated by e_fmath_exp_tune.cc(" TUNE_MAKE ") on " TUNE_TARGET
+		".\n"
+		"//\n");
+	for (i = 0; i < TUNE_NUM_KERNELS; i++) {
+		print_result("//   ", &r[i]);
+	}
+	sprintf(outbuf + strlen(outbuf), "//\n");
+	sprintf(outbuf + strlen(outbuf), "#define FMATH_EXP_TUNED_TARGET \"%s\"\n"
+					 "#define FMATH_EXP_TUNED_TABLE_SIZE (%d)\n",
+		TUNE_TARGET, FMATH_EXP_TABLE_SIZE);
+	sprintf(outbuf + strlen(outbuf), "\n");
+	print_result("// fast: ", fast);
+	print_tier("FAST", fast);
+	print_result("// accurate: ", accurate);
+	print_tier("ACCURATE", accurate);
+	sprintf(outbuf + strlen(outbuf), "\n#endif // " TUNE_GUARD "\n");
+
+#ifdef E_HOST_SHIM
+	fputs(outbuf, stdout);
+#endif
+
+	mailbox[0] = 1;
+
+	return EXIT_SUCCESS;
+}
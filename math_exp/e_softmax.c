@@ -0,0 +1,188 @@
+//
+// Softmax and log-sum-exp over float vectors, built on fmath_exp4().
+//
+//  softmax_n()        : 3 passes. max, exp + sum, scale.
+//  softmax_online_n() : 2 passes. Running max/sum in one pass(rescaling the
+//                       sum whenever the max grows), then exp + scale.
+//  logsumexp_n()      : 1 pass(online max/sum) + one logf().
+//
+// softmax_stats_n()/softmax_scale_n() are the two halves of the online
+// variant, so a long vector can be split across cores: each core reduces its
+// part to (max, sum), partial results are merged with softmax_stats_merge(),
+// then every core scales its part with the global (max, 1/sum).
+//
+// fmath_exp() has no range check, so exp() arguments are clamped to
+// SOFTMAX_EXP_MIN. Elements more than 87 below the max come out as ~1e-38
+// instead of 0.
+//
+#include <math.h>
+#include <float.h>
+
+#include "fast_exp.h"
+
+#define SOFTMAX_EXP_MIN (-87.0f)
+
+static inline float clamp_arg(float x)
+{
+	return (x < SOFTMAX_EXP_MIN) ? SOFTMAX_EXP_MIN : x;
+}
+
+static inline float max2(float a, float b)
+{
+	return (a > b) ? a : b;
+}
+
+static float max_n(const float *x, int n)
+{
+	float m0 = x[0], m1 = x[0], m2 = x[0], m3 = x[0];
+	int i;
+
+	for (i = 0; i + 4 <= n; i += 4) {
+		m0 = max2(m0, x[i + 0]);
+		m1 = max2(m1, x[i + 1]);
+		m2 = max2(m2, x[i + 2]);
+		m3 = max2(m3, x[i + 3]);
+	}
+	for (; i < n; i++) {
+		m0 = max2(m0, x[i]);
+	}
+	return max2(max2(m0, m1), max2(m2, m3));
+}
+
+// y[i] = exp(x[i] - m), returns sum of y[i].
+static float exp_sum_n(float *RESTRICT y, const float *RESTRICT x, int n,
+		       float m)
+{
+	float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+	int i;
+
+	for (i = 0; i + 4 <= n; i += 4) {
+		float t[4];
+		t[0] = clamp_arg(x[i + 0] - m);
+		t[1] = clamp_arg(x[i + 1] - m);
+		t[2] = clamp_arg(x[i + 2] - m);
+		t[3] = clamp_arg(x[i + 3] - m);
+		fmath_exp4(y + i, t);
+		s0 += y[i + 0];
+		s1 += y[i + 1];
+		s2 += y[i + 2];
+		s3 += y[i + 3];
+	}
+	for (; i < n; i++) {
+		y[i] = fmath_exp(clamp_arg(x[i] - m));
+		s0 += y[i];
+	}
+	return (s0 + s1) + (s2 + s3);
+}
+
+void softmax_stats_n(float *m, float *d, const float *x, int n)
+{
+	float mm = *m;
+	float dd = *d;
+	int i;
+
+	for (i = 0; i + 4 <= n; i += 4) {
+		float t[4], e[4];
+		float bm = max2(max2(x[i + 0], x[i + 1]),
+				max2(x[i + 2], x[i + 3]));
+
+		// Rescale the running sum only when the max grows, which is
+		// rare after the first few blocks.
+		if (bm > mm) {
+			dd *= fmath_exp(clamp_arg(mm - bm));
+			mm = bm;
+		}
+		t[0] = clamp_arg(x[i + 0] - mm);
+		t[1] = clamp_arg(x[i + 1] - mm);
+		t[2] = clamp_arg(x[i + 2] - mm);
+		t[3] = clamp_arg(x[i + 3] - mm);
+		fmath_exp4(e, t);
+		dd += (e[0] + e[1]) + (e[2] + e[3]);
+	}
+	for (; i < n; i++) {
+		if (x[i] > mm) {
+			dd *= fmath_exp(clamp_arg(mm - x[i]));
+			mm = x[i];
+		}
+		dd += fmath_exp(clamp_arg(x[i] - mm));
+	}
+
+	*m = mm;
+	*d = dd;
+}
+
+void softmax_stats_merge(float *m, float *d, float m1, float d1)
+{
+	if (m1 > *m) {
+		*d = *d * fmath_exp(clamp_arg(*m - m1)) + d1;
+		*m = m1;
+	} else {
+		*d += d1 * fmath_exp(clamp_arg(m1 - *m));
+	}
+}
+
+void softmax_scale_n(float *RESTRICT y, const float *RESTRICT x, int n, float m,
+		     float inv_d)
+{
+	int i;
+
+	for (i = 0; i + 4 <= n; i += 4) {
+		float t[4];
+		t[0] = clamp_arg(x[i + 0] - m);
+		t[1] = clamp_arg(x[i + 1] - m);
+		t[2] = clamp_arg(x[i + 2] - m);
+		t[3] = clamp_arg(x[i + 3] - m);
+		fmath_exp4(y + i, t);
+		y[i + 0] *= inv_d;
+		y[i + 1] *= inv_d;
+		y[i + 2] *= inv_d;
+		y[i + 3] *= inv_d;
+	}
+	for (; i < n; i++) {
+		y[i] = fmath_exp(clamp_arg(x[i] - m)) * inv_d;
+	}
+}
+
+void softmax_n(float *RESTRICT y, const float *RESTRICT x, int n)
+{
+	float m, inv_d;
+	int i;
+
+	if (n <= 0) {
+		return;
+	}
+
+	m = max_n(x, n);
+	inv_d = 1.0f / exp_sum_n(y, x, n, m);
+	for (i = 0; i < n; i++) {
+		y[i] *= inv_d;
+	}
+}
+
+void softmax_online_n(float *RESTRICT y, const float *RESTRICT x, int n)
+{
+	float m, d;
+
+	if (n <= 0) {
+		return;
+	}
+
+	m = x[0];
+	d = 0.0f;
+	softmax_stats_n(&m, &d, x, n);
+	softmax_scale_n(y, x, n, m, 1.0f / d);
+}
+
+float logsumexp_n(const float *x, int n)
+{
+	float m, d;
+
+	if (n <= 0) {
+		return -FLT_MAX;
+	}
+
+	m = x[0];
+	d = 0.0f;
+	softmax_stats_n(&m, &d, x, n);
+	return m + logf(d);
+}
@@ -0,0 +1,92 @@
+//
+// Fast approximate exp() kernels. See e_fast_exp.c for cycle counts and
+// accuracy.
+//
+#ifndef FAST_EXP_H_
+#define FAST_EXP_H_
+
+// GCC
+#define RESTRICT __restrict__
+
+// log2 of the fmath_exp() table size. 10(4KB), 8(1KB) or 7(512B).
+#ifndef FMATH_EXP_TABLE_SIZE
+#define FMATH_EXP_TABLE_SIZE (7)
+#endif
+
+// 1: fmath_exp()..fmath_exp16() saturate and propagate NaN like
+// fmath_exp_n(), for a few cycles per element.
+#ifndef FMATH_EXP_SAFE
+#define FMATH_EXP_SAFE (0)
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// e_fast_exp.c
+extern const unsigned int kFmathExpTable[];
+
+// fmath_exp.cc
+float fmath_exp(float x);
+void fmath_exp4(float *RESTRICT y, const float *RESTRICT x);
+void fmath_exp8(float *RESTRICT y, const float *RESTRICT x);
+void fmath_exp16(float *RESTRICT y, const float *RESTRICT x);
+// Any input: +inf above 88.72, 0 below -87.33(no denormals), NaN stays NaN.
+// Branch-free.
+void fmath_exp4_safe(float *RESTRICT y, const float *RESTRICT x);
+void fmath_exp_n(float *RESTRICT y, const float *RESTRICT x, int n);
+// IEEE half in/out(fp16.h), computed in float. Saturates like fmath_exp_n().
+void fmath_exp_h_n(unsigned short *RESTRICT y,
+		   const unsigned short *RESTRICT x, int n);
+
+// fmath_exp_d.c, host only(16KB table). Same saturation as fmath_exp_n().
+double fmath_exp_d(double x);
+void fmath_exp_d_n(double *RESTRICT y, const double *RESTRICT x, int n);
+
+// fmath_exp_dispatch.cc. Kernel and unroll width per target are picked by
+// `make tune`(fmath_exp_tuned.h, `make tune_shim` and fmath_exp_tuned_shim.h
+// for the host shim). n need not be a multiple of the width. Any input
+// saturates like fmath_exp_n(), the max rel. diff holds over
+// [-87.33, 88.72], the range with a normal float result.
+//   fast     : max rel. diff <= 1e-5
+//   accurate : max rel. diff <= 5e-6
+void exp_fast_n(float *RESTRICT y, const float *RESTRICT x, int n);
+void exp_accurate_n(float *RESTRICT y, const float *RESTRICT x, int n);
+
+// fmath_exp_host.cc, host only. Same range and saturation as exp_fast_n(),
+// max rel. diff <= 5e-6.
+void exp_host_n(float *RESTRICT y, const float *RESTRICT x, int n);
+
+// e_exp_stream.c, e-core only. x and y in external memory, any n. DMA double
+// buffered through local memory, uses both DMA channels.
+void fmath_exp_stream(float *y, const float *x, int n);
+
+float expapprox(float val);
+void expapprox4(float *RESTRICT dst, const float *RESTRICT src);
+
+// Integer-only variants. Only the final multiply runs on the FPU.
+float fmath_exp_i(float x);
+void fmath_exp4_i(float *RESTRICT y, const float *RESTRICT x);
+int fmath_exp_q16(int x); // Q16 in, Q16 out
+int fmath_exp_q24(int x); // Q24 in, Q24 out
+void fmath_exp4_q16(int *RESTRICT y, const int *RESTRICT x);
+void fmath_exp4_q24(int *RESTRICT y, const int *RESTRICT x);
+
+// e_softmax.c
+void softmax_n(float *RESTRICT y, const float *RESTRICT x, int n);
+void softmax_online_n(float *RESTRICT y, const float *RESTRICT x, int n);
+float logsumexp_n(const float *x, int n);
+
+// Split softmax: reduce parts with softmax_stats_n()(start with m = x[0],
+// d = 0), merge with softmax_stats_merge(), then scale with
+// softmax_scale_n(y, x, n, m, 1 / d).
+void softmax_stats_n(float *m, float *d, const float *x, int n);
+void softmax_stats_merge(float *m, float *d, float m1, float d1);
+void softmax_scale_n(float *RESTRICT y, const float *RESTRICT x, int n, float m,
+		     float inv_d);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FAST_EXP_H_
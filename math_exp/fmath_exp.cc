@@ -0,0 +1,79 @@
+//
+// C entry points for the table based exp(), instantiated from fmath::Exp<>
+// (fmath_exp.hpp) with the FMATH_EXP_TABLE_SIZE table from e_fast_exp.c.
+//
+// fmath_exp()..fmath_exp16() have no range check(input must be within
+// [-87.3, 88.7]) unless built with FMATH_EXP_SAFE=1. fmath_exp4_safe() and
+// fmath_exp_n() always saturate to 0/+inf and propagate NaN, as does
+// fmath_exp_h_n()(fp16 in/out, float inside).
+//
+#include "fmath_exp.hpp"
+#include "fp16.h"
+
+#if FMATH_EXP_SAFE
+typedef fmath::SafeRange FmathExpRange;
+#else
+typedef fmath::NoRangeCheck FmathExpRange;
+#endif
+
+extern "C" float fmath_exp(float x)
+{
+	float y;
+	fmath::Exp<FMATH_EXP_TABLE_SIZE, 1, FmathExpRange>::eval(&y, &x,
+								 kFmathExpTable);
+	return y;
+}
+
+extern "C" void fmath_exp4(float *RESTRICT y, const float *RESTRICT x)
+{
+	fmath::Exp<FMATH_EXP_TABLE_SIZE, 4, FmathExpRange>::eval(y, x,
+								 kFmathExpTable);
+}
+
+extern "C" void fmath_exp8(float *RESTRICT y, const float *RESTRICT x)
+{
+	fmath::Exp<FMATH_EXP_TABLE_SIZE, 8, FmathExpRange>::eval(y, x,
+								 kFmathExpTable);
+}
+
+extern "C" void fmath_exp16(float *RESTRICT y, const float *RESTRICT x)
+{
+	fmath::Exp<FMATH_EXP_TABLE_SIZE, 16, FmathExpRange>::eval(y, x,
+								 kFmathExpTable);
+}
+
+extern "C" void fmath_exp4_safe(float *RESTRICT y, const float *RESTRICT x)
+{
+	fmath::Exp<FMATH_EXP_TABLE_SIZE, 4, fmath::SafeRange>::eval(
+		y, x, kFmathExpTable);
+}
+
+extern "C" void fmath_exp_n(float *RESTRICT y, const float *RESTRICT x, int n)
+{
+	fmath::Exp<FMATH_EXP_TABLE_SIZE, 4, fmath::SafeRange>::eval_n(
+		y, x, n, kFmathExpTable);
+}
+
+extern "C" void fmath_exp_h_n(unsigned short *RESTRICT y,
+			      const unsigned short *RESTRICT x, int n)
+{
+	float xf[4], yf[4];
+	int i = 0, k;
+
+	for (; i + 4 <= n; i += 4) {
+		for (k = 0; k < 4; k++) {
+			xf[k] = fp16_to_float(x[i + k]);
+		}
+		fmath::Exp<FMATH_EXP_TABLE_SIZE, 4, fmath::SafeRange>::eval(
+			yf, xf, kFmathExpTable);
+		for (k = 0; k < 4; k++) {
+			y[i + k] = fp16_from_float(yf[k]);
+		}
+	}
+	for (; i < n; i++) {
+		xf[0] = fp16_to_float(x[i]);
+		fmath::Exp<FMATH_EXP_TABLE_SIZE, 1, fmath::SafeRange>::eval(
+			yf, xf, kFmathExpTable);
+		y[i] = fp16_from_float(yf[0]);
+	}
+}
@@ -0,0 +1,279 @@
+//
+// Table based exp() as a template over table size, unroll width and range
+// check policy. Every fmath_exp*() variant is an instantiation of
+// fmath::Exp<>, see fmath_exp.cc for the C entry points and
+// e_fmath_exp_sweep.cc for a benchmark over the parameter grid.
+//
+// base on fmath::exp https://github.com/herumi/fmath/blob/master/fmath.hpp
+//
+#ifndef FMATH_EXP_HPP_
+#define FMATH_EXP_HPP_
+
+#include "fast_exp.h"
+#include "fmath_exp_poly.h"
+
+namespace fmath {
+
+union Fi {
+	float f;
+	unsigned int i;
+};
+
+// Range policies. apply() conditions the input, fix() patches the result
+// given the original input.
+
+// Caller guarantees x is within [-87.3, 88.7]. Out of range input wraps the
+// exponent bits.
+struct NoRangeCheck {
+	static inline float apply(float x) { return x; }
+	static inline float fix(float x, float y) { return y; }
+};
+
+// Clamp to the range where the exponent assembly is valid(2^k with k in
+// [-126, 127] for PolyExp<>). Compiles to two conditional moves with -mcmove.
+// Only exact within the clamp: x in (88.3, 88.72] gives exp(88.3), use
+// SafeRange for the top of the float range.
+struct ClampRange {
+	static inline float apply(float x)
+	{
+		x = (x < -87.3f) ? -87.3f : x;
+		x = (x > 88.3f) ? 88.3f : x;
+		return x;
+	}
+	static inline float fix(float x, float y) { return y; }
+};
+
+// IEEE style saturation with selects only(no branches, vectorizes):
+//
+//   x > 88.72283(incl. +inf) -> +inf
+//   x < -87.33(incl. -inf)   -> 0, results never go denormal
+//   NaN                      -> quiet NaN
+//
+// Inputs above 88 are evaluated as exp(x - c) * exp(c), c = 0.69140625(exact
+// subtraction), so 2^k stays finite up to FLT_MAX. The checks use the integer bits, so they hold with
+// -ffast-math(-ffinite-math-only) too.
+struct SafeRange {
+	static inline float apply(float x)
+	{
+		x = (x < -87.33f) ? -87.33f : x;
+		x = (x > 88.72283f) ? 88.72283f : x;
+		return (x > 88.0f) ? x - 0.69140625f : x;
+	}
+	static inline float fix(float x, float y)
+	{
+		Fi bx, by;
+
+		bx.f = x;
+		by.f = y * (((int)bx.i > 0x42b00000) ? 1.99652112f : 1.0f); // 88.0f
+		by.i = ((int)bx.i > 0x42b17217) ? 0x7f800000 : by.i; // 88.72283f
+		by.i = (bx.i > 0xc2aea8f6) ? 0 : by.i;              // -87.33f
+		by.i = ((bx.i & 0x7fffffff) > 0x7f800000) ? (bx.i | 0x00400000)
+							  : by.i;
+		return by.f;
+	}
+};
+
+// S     : log2 of the table size(table has 1 << S entries, 23 bit mantissas)
+// W     : elements per call. Each step below is a separate loop over W, so
+//         the compiler fully unrolls them and interleaves the W independent
+//         chains like the hand-expanded fmath_exp4() used to do.
+// Range : NoRangeCheck, ClampRange or SafeRange
+template <int S, int W, class Range = NoRangeCheck> struct Exp {
+	static inline void eval(float *RESTRICT y, const float *RESTRICT x,
+				const unsigned int *RESTRICT table)
+	{
+		const float a0 = (float)(1 << S) * 1.44269504088896341f;
+		const float b0 = 0.693147180559945309f / (float)(1 << S);
+		const float magic = (1 << 23) + (1 << 22); // to round
+		const unsigned int magic_bits = 0x4b400000; // bits of magic
+		const unsigned int mask = (1U << S) - 1;
+
+		float xr[W], t[W];
+		Fi fi[W];
+		unsigned int u[W], v[W];
+		int i;
+
+		for (i = 0; i < W; i++) {
+			xr[i] = Range::apply(x[i]);
+		}
+		for (i = 0; i < W; i++) {
+			t[i] = xr[i] * a0 + magic;
+		}
+		for (i = 0; i < W; i++) {
+			fi[i].f = t[i];
+		}
+		// (t - magic) recovered from the bits, so -ffast-math can not
+		// fold it back to x * a0 and drop the rounding.
+		for (i = 0; i < W; i++) {
+			t[i] = xr[i] - (float)(int)(fi[i].i - magic_bits) * b0;
+		}
+		for (i = 0; i < W; i++) {
+			u[i] = ((fi[i].i + (127 << S)) >> S) << 23;
+			v[i] = fi[i].i & mask;
+		}
+		for (i = 0; i < W; i++) {
+			fi[i].i = u[i] | table[v[i]];
+		}
+		for (i = 0; i < W; i++) {
+			y[i] = Range::fix(x[i], (1.0f + t[i]) * fi[i].f);
+		}
+	}
+
+	// n need not be a multiple of W. The tail runs one element at a time.
+	static inline void eval_n(float *RESTRICT y, const float *RESTRICT x,
+				  int n, const unsigned int *RESTRICT table)
+	{
+		int i = 0;
+		for (; i + W <= n; i += W) {
+			eval(y + i, x + i, table);
+		}
+		for (; i < n; i++) {
+			Exp<S, 1, Range>::eval(y + i, x + i, table);
+		}
+	}
+};
+
+// x - k * c1 - k * c2 without letting -ffast-math reassociate it into
+// x - k * (c1 + c2), which would drop the extra bits of c2.
+static inline float cody_waite(float x, float k, float c1, float c2)
+{
+#if defined(__FP_FAST_FMAF)
+	return __builtin_fmaf(-k, c2, __builtin_fmaf(-k, c1, x));
+#else
+	float r = x - k * c1;
+#if defined(__epiphany__)
+	__asm__("" : "+r"(r));
+#elif defined(__SSE__)
+	__asm__("" : "+x"(r));
+#else
+	__asm__("" : "+m"(r));
+#endif
+	return r - k * c2;
+#endif
+}
+
+// Table-free exp(): Cody-Waite range reduction x = k * ln2 + r, |r| <= ln2/2,
+// then a degree D minimax polynomial for exp(r)(fmath_exp_poly.h, generated
+// by fmath_exp_remez.c) scaled by 2^k through the exponent bits.
+//
+//   D = 3: 7.5e-5, 4: 2.7e-6, 5: 2.2e-7, 6: 1.4e-7 max rel. diff, measured
+//   over [-87.33, 88.72]. From 5 on, float rounding in the Horner steps
+//   dominates the polynomial error.
+template <int D, int W, class Range = NoRangeCheck> struct PolyExp {
+	static inline void eval(float *RESTRICT y, const float *RESTRICT x)
+	{
+		const float log2e = 1.44269504088896341f;
+		const float c1 = 0.693359375f;       // ln2 upper bits, k * c1 exact
+		const float c2 = -2.12194440e-4f;    // ln2 - c1
+		const float magic = (1 << 23) + (1 << 22); // to round
+		const unsigned int magic_bits = 0x4b400000; // bits of magic
+
+		float xr[W], kf[W], r[W], p[W];
+		Fi fi[W];
+		int i, j;
+
+		for (i = 0; i < W; i++) {
+			xr[i] = Range::apply(x[i]);
+		}
+		for (i = 0; i < W; i++) {
+			fi[i].f = xr[i] * log2e + magic;
+		}
+		// k from the bits, so -ffast-math can not fold the rounding away.
+		for (i = 0; i < W; i++) {
+			kf[i] = (float)(int)(fi[i].i - magic_bits);
+		}
+		for (i = 0; i < W; i++) {
+			r[i] = cody_waite(xr[i], kf[i], c1, c2);
+		}
+		for (i = 0; i < W; i++) {
+			p[i] = kFmathExpPoly[D][D];
+		}
+		for (j = D - 1; j >= 0; j--) {
+			for (i = 0; i < W; i++) {
+				p[i] = p[i] * r[i] + kFmathExpPoly[D][j];
+			}
+		}
+		for (i = 0; i < W; i++) {
+			fi[i].i = (fi[i].i - magic_bits + 127) << 23;
+		}
+		for (i = 0; i < W; i++) {
+			y[i] = Range::fix(x[i], p[i] * fi[i].f);
+		}
+	}
+};
+
+// Kernels the tuned dispatch(fmath_exp_dispatch.cc) can pick, by id and
+// width. fmath and poly kernels saturate like SafeRange, so every kernel
+// accepts any finite input and stays accurate up to FLT_MAX.
+#define FMATH_EXP_KERNEL_FMATH (0)
+#define FMATH_EXP_KERNEL_EXPAPPROX (1)
+#define FMATH_EXP_KERNEL_POLY(degree) (10 + (degree))
+
+template <int K, int W> struct Kernel;
+
+template <int W> struct Kernel<FMATH_EXP_KERNEL_FMATH, W> {
+	static inline void eval(float *RESTRICT y, const float *RESTRICT x)
+	{
+		Exp<FMATH_EXP_TABLE_SIZE, W, SafeRange>::eval(y, x,
+							     kFmathExpTable);
+	}
+};
+
+template <int W> struct Kernel<FMATH_EXP_KERNEL_POLY(3), W> {
+	static inline void eval(float *RESTRICT y, const float *RESTRICT x)
+	{
+		PolyExp<3, W, SafeRange>::eval(y, x);
+	}
+};
+
+template <int W> struct Kernel<FMATH_EXP_KERNEL_POLY(4), W> {
+	static inline void eval(float *RESTRICT y, const float *RESTRICT x)
+	{
+		PolyExp<4, W, SafeRange>::eval(y, x);
+	}
+};
+
+template <int W> struct Kernel<FMATH_EXP_KERNEL_POLY(5), W> {
+	static inline void eval(float *RESTRICT y, const float *RESTRICT x)
+	{
+		PolyExp<5, W, SafeRange>::eval(y, x);
+	}
+};
+
+template <int W> struct Kernel<FMATH_EXP_KERNEL_POLY(6), W> {
+	static inline void eval(float *RESTRICT y, const float *RESTRICT x)
+	{
+		PolyExp<6, W, SafeRange>::eval(y, x);
+	}
+};
+
+template <> struct Kernel<FMATH_EXP_KERNEL_EXPAPPROX, 1> {
+	static inline void eval(float *RESTRICT y, const float *RESTRICT x)
+	{
+		y[0] = expapprox(x[0]);
+	}
+};
+
+template <> struct Kernel<FMATH_EXP_KERNEL_EXPAPPROX, 4> {
+	static inline void eval(float *RESTRICT y, const float *RESTRICT x)
+	{
+		expapprox4(y, x);
+	}
+};
+
+// y[i] = exp(x[i]) for any n, tail one element at a time.
+template <int K, int W>
+static inline void kernel_n(float *RESTRICT y, const float *RESTRICT x, int n)
+{
+	int i = 0;
+	for (; i + W <= n; i += W) {
+		Kernel<K, W>::eval(y + i, x + i);
+	}
+	for (; i < n; i++) {
+		Kernel<K, 1>::eval(y + i, x + i);
+	}
+}
+
+} // namespace fmath
+
+#endif // FMATH_EXP_HPP_
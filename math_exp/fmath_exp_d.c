@@ -0,0 +1,611 @@
+//
+// Double precision table based exp() for host side post-processing.
+//
+// Same scheme as fmath_exp() with 11 table bits(16KB, too large for e-core
+// local memory, so this file is only built into host programs) and a cubic
+// correction: exp(x) = 2^q * 2^(j / 2048) * p(r), |r| <= ln2 / 4096, with
+// the r^4 / 24 truncation error below 4e-17. ln2 / 2048 is split
+// Cody-Waite style so k * hi stays exact for the whole range.
+//
+// Saturates like fmath::SafeRange: +inf above ln(DBL_MAX), 0 below
+// ln(DBL_MIN)(no denormals), NaN stays NaN.
+//
+// base on fmath::expd https://github.com/herumi/fmath/blob/master/fmath.hpp
+//
+#include "fast_exp.h"
+
+#define FMATH_EXP_D_TABLE_SIZE (11)
+
+// Generated with `fmath_exp_tablegen d 11`.
+static const unsigned long long kFmathExpTableD[2048] = {
+  0x0000000000000ULL, 0x00162f3904052ULL, 0x002c605e2e8cfULL, 0x0042936faa3d8ULL,
+  0x0058c86da1c0aULL, 0x006eff583fc3dULL, 0x0085382faef83ULL, 0x009b72f41a12bULL,
+  0x00b1afa5abcbfULL, 0x00c7ee448ee02ULL, 0x00de2ed0ee0f5ULL, 0x00f4714af41d3ULL,
+  0x010ab5b2cbd11ULL, 0x0120fc089ff63ULL, 0x0137444c9b5b5ULL, 0x014d8e7ee8d2fULL,
+  0x0163da9fb3335ULL, 0x017a28af25567ULL, 0x019078ad6a19fULL, 0x01a6ca9aac5f3ULL,
+  0x01bd1e77170b4ULL, 0x01d37442d5070ULL, 0x01e9cbfe113efULL, 0x020025a8f6a35ULL,
+  0x02168143b0281ULL, 0x022cdece68c4fULL, 0x02433e494b755ULL, 0x02599fb483385ULL,
+  0x027003103b10eULL, 0x0286685c9e059ULL, 0x029ccf99d720aULL, 0x02b338c811703ULL,
+  0x02c9a3e778061ULL, 0x02e010f835f7bULL, 0x02f67ffa765e6ULL, 0x030cf0ee64571ULL,
+  0x032363d42b027ULL, 0x0339d8abf5851ULL, 0x03504f75ef071ULL, 0x0366c83242b47ULL,
+  0x037d42e11bbccULL, 0x0393bf82a5538ULL, 0x03aa3e170aafeULL, 0x03c0be9e770cbULL,
+  0x03d7411915a8aULL, 0x03edc58711c63ULL, 0x04044be896ab6ULL, 0x041ad43dcfa24ULL,
+  0x04315e86e7f85ULL, 0x0447eac40aff0ULL, 0x045e78f5640b9ULL, 0x0475091b1e76dULL,
+  0x048b9b35659d8ULL, 0x04a22f4464e00ULL, 0x04b8c54847a28ULL, 0x04cf5d41394cfULL,
+  0x04e5f72f654b1ULL, 0x04fc9312f70c5ULL, 0x051330ec1a03fULL, 0x0529d0baf9a8fULL,
+  0x0540727fc1762ULL, 0x0557163a9ce9fULL, 0x056dbbebb786bULL, 0x058463933cd29ULL,
+  0x059b0d3158574ULL, 0x05b1b8c635a28ULL, 0x05c866520045bULL, 0x05df15d4e3d5eULL,
+  0x05f5c74f0bec2ULL, 0x060c7ac0a4252ULL, 0x06233029d8216ULL, 0x0639e78ad3853ULL,
+  0x0650a0e3c1f89ULL, 0x06675c34cf276ULL, 0x067e197e26c14ULL, 0x0694d8bff479aULL,
+  0x06ab99fa6407cULL, 0x06c25d2da1268ULL, 0x06d92259d794dULL, 0x06efe97f33152ULL,
+  0x0706b29ddf6deULL, 0x071d7db608693ULL, 0x07344ac7d9d51ULL, 0x074b19d37f833ULL,
+  0x0761ead925493ULL, 0x0778bdd8f7005ULL, 0x078f92d32085dULL, 0x07a669c7cdba9ULL,
+  0x07bd42b72a836ULL, 0x07d41da162c8cULL, 0x07eafa86a2771ULL, 0x0801d967157e8ULL,
+  0x0818ba42e7d30ULL, 0x082f9d1a456c5ULL, 0x084681ed5a462ULL, 0x085d68bc525fcULL,
+  0x0874518759bc8ULL, 0x088b3c4e9c635ULL, 0x08a22912465f2ULL, 0x08b917d283be8ULL,
+  0x08d0088f8093fULL, 0x08e6fb4968f5dULL, 0x08fdf00068fe2ULL, 0x0914e6b4accafULL,
+  0x092bdf66607e0ULL, 0x0942da15b03cdULL, 0x0959d6c2c830dULL, 0x0970d56dd4875ULL,
+  0x0987d61701716ULL, 0x099ed8be7b23dULL, 0x09b5dd646dd77ULL, 0x09cce40905c8cULL,
+  0x09e3ecac6f383ULL, 0x09faf74ed66a0ULL, 0x0a1203f067a63ULL, 0x0a2912914f38cULL,
+  0x0a402331b9715ULL, 0x0a5735d1d2a39ULL, 0x0a6e4a71c726eULL, 0x0a856111c3568ULL,
+  0x0a9c79b1f3919ULL, 0x0ab39452843b1ULL, 0x0acab0f3a1b9cULL, 0x0ae1cf9578784ULL,
+  0x0af8f03834e52ULL, 0x0b1012dc0372cULL, 0x0b27378110974ULL, 0x0b3e5e2788ccbULL,
+  0x0b5586cf9890fULL, 0x0b6cb1796c65eULL, 0x0b83de2530d11ULL, 0x0b9b0cd3125bfULL,
+  0x0bb23d833d93fULL, 0x0bc97035df0a2ULL, 0x0be0a4eb2353bULL, 0x0bf7dba337098ULL,
+  0x0c0f145e46c85ULL, 0x0c264f1c7f30eULL, 0x0c3d8bde0ce7aULL, 0x0c54caa31c94fULL,
+  0x0c6c0b6bdae53ULL, 0x0c834e3874886ULL, 0x0c9a93091632aULL, 0x0cb1d9ddec9bbULL,
+  0x0cc922b7247f7ULL, 0x0ce06d94ea9d7ULL, 0x0cf7ba776bb94ULL, 0x0d0f095ed49a3ULL,
+  0x0d265a4b520baULL, 0x0d3dad3d10dc9ULL, 0x0d5502343de02ULL, 0x0d6c593105ed4ULL,
+  0x0d83b23395decULL, 0x0d9b0d3c1a933ULL, 0x0db26a4ac0ed5ULL, 0x0dc9c95fb5d37ULL,
+  0x0de12a7b26300ULL, 0x0df88d9d3ef15ULL, 0x0e0ff2c62d096ULL, 0x0e2759f61d6e6ULL,
+  0x0e3ec32d3d1a2ULL, 0x0e562e6bb90a8ULL, 0x0e6d9bb1be415ULL, 0x0e850aff79c41ULL,
+  0x0e9c7c55189c6ULL, 0x0eb3efb2c7d7bULL, 0x0ecb6518b4874ULL, 0x0ee2dc870bc07ULL,
+  0x0efa55fdfa9c5ULL, 0x0f11d17dae37fULL, 0x0f294f0653b45ULL, 0x0f40ce9818366ULL,
+  0x0f58503328e6dULL, 0x0f6fd3d7b2f26ULL, 0x0f875985e389bULL, 0x0f9ee13de7e15ULL,
+  0x0fb66affed31bULL, 0x0fcdf6cc20b73ULL, 0x0fe584a2afb21ULL, 0x0ffd1483c7669ULL,
+  0x1014a66f951ceULL, 0x102c3a6646210ULL, 0x1043d06807c2fULL, 0x105b68750756aULL,
+  0x1073028d7233eULL, 0x108a9eb175b68ULL, 0x10a23ce13f3e2ULL, 0x10b9dd1cfc2e8ULL,
+  0x10d17f64d9ef1ULL, 0x10e923b905eb7ULL, 0x1100ca19ad92fULL, 0x11187286fe591ULL,
+  0x11301d0125b51ULL, 0x1147c98851223ULL, 0x115f781cae1faULL, 0x117728be6a309ULL,
+  0x118edb6db2dc1ULL, 0x11a6902ab5ad2ULL, 0x11be46f5a032cULL, 0x11d5ffce9fffeULL,
+  0x11edbab5e2ab6ULL, 0x120577ab95d00ULL, 0x121d36afe70c9ULL, 0x1234f7c30403eULL,
+  0x124cbae51a5c8ULL, 0x1264801657c12ULL, 0x127c4756e9e05ULL, 0x129410a6fe6cbULL,
+  0x12abdc06c31ccULL, 0x12c3a97665aafULL, 0x12db78f613d5bULL, 0x12f34a85fb5f7ULL,
+  0x130b1e264a0e9ULL, 0x1322f3d72dad5ULL, 0x133acb98d40a2ULL, 0x1352a56b6af72ULL,
+  0x136a814f204abULL, 0x13825f4421defULL, 0x139a3f4a9d922ULL, 0x13b22162c1466ULL,
+  0x13ca058cbae1eULL, 0x13e1ebc8b84ebULL, 0x13f9d416e77afULL, 0x1411be777658bULL,
+  0x1429aaea92de0ULL, 0x144199706b04eULL, 0x14598a092ccb7ULL, 0x14717cb50633aULL,
+  0x1489717425438ULL, 0x14a16846b804fULL, 0x14b9612cec861ULL, 0x14d15c26f0d8bULL,
+  0x14e95934f312eULL, 0x15015857214e8ULL, 0x1519598da9a9aULL, 0x15315cd8ba461ULL,
+  0x154962388149eULL, 0x156169ad2cdefULL, 0x15797336eb333ULL, 0x15917ed5ea789ULL,
+  0x15a98c8a58e51ULL, 0x15c19c5464b2aULL, 0x15d9ae343c1f2ULL, 0x15f1c22a0d6caULL,
+  0x1609d83606e12ULL, 0x1621f05856c68ULL, 0x163a0a912b6acULL, 0x165226e0b3200ULL,
+  0x166a45471c3c2ULL, 0x168265c495194ULL, 0x169a88594c157ULL, 0x16b2ad056f92cULL,
+  0x16cad3c92df73ULL, 0x16e2fca4b5ad0ULL, 0x16fb279835224ULL, 0x171354a3dac91ULL,
+  0x172b83c7d517bULL, 0x1743b50452885ULL, 0x175be85981992ULL, 0x17741dc790cc7ULL,
+  0x178c554eaea89ULL, 0x17a48eef09b7dULL, 0x17bccaa8d0888ULL, 0x17d5087c31ad2ULL,
+  0x17ed48695bbc0ULL, 0x18058a707d4fbULL, 0x181dce91c506aULL, 0x183614cd61836ULL,
+  0x184e5d23816c9ULL, 0x1866a794536ccULL, 0x187ef4200632bULL, 0x189742c6c8711ULL,
+  0x18af9388c8deaULL, 0x18c7e66636363ULL, 0x18e03b5f3f36bULL, 0x18f8927412a2fULL,
+  0x1910eba4df41fULL, 0x192946f1d3decULL, 0x1941a45b1f487ULL, 0x195a03e0f0522ULL,
+  0x1972658375d2fULL, 0x198ac942dea64ULL, 0x19a32f1f59ab4ULL, 0x19bb971915c57ULL,
+  0x19d4013041dc2ULL, 0x19ec6d650cdadULL, 0x1a04dbb7a5b13ULL, 0x1a1d4c283b52dULL,
+  0x1a35beb6fcb75ULL, 0x1a4e336418da9ULL, 0x1a66aa2fbebc7ULL, 0x1a7f231a1d60cULL,
+  0x1a979e2363cf8ULL, 0x1ab01b4bc114dULL, 0x1ac89a936440dULL, 0x1ae11bfa7c67bULL,
+  0x1af99f8138a1cULL, 0x1b122527c80b7ULL, 0x1b2aacee59c53ULL, 0x1b4336d51cf38ULL,
+  0x1b5bc2dc40bf0ULL, 0x1b745103f4548ULL, 0x1b8ce14c66e4cULL, 0x1ba573b5c7a4bULL,
+  0x1bbe084045cd4ULL, 0x1bd69eec109b8ULL, 0x1bef37b95750bULL, 0x1c07d2a849321ULL,
+  0x1c206fb91588fULL, 0x1c390eebeba2eULL, 0x1c51b040fad15ULL, 0x1c6a53b8726a0ULL,
+  0x1c82f95281c6bULL, 0x1c9ba10f58454ULL, 0x1cb44aef2547aULL, 0x1cccf6f21833fULL,
+  0x1ce5a51860746ULL, 0x1cfe55622d773ULL, 0x1d1707cfaeaedULL, 0x1d2fbc611391cULL,
+  0x1d4873168b9aaULL, 0x1d612bf046484ULL, 0x1d79e6ee731d7ULL, 0x1d92a41141a12ULL,
+  0x1dab6358e15e8ULL, 0x1dc424c581e4bULL, 0x1ddce85752c71ULL, 0x1df5ae0e839d2ULL,
+  0x1e0e75eb44027ULL, 0x1e273fedc396bULL, 0x1e400c1631fdbULL, 0x1e58da64bedf8ULL,
+  0x1e71aad999e82ULL, 0x1e8a7d74f2c7eULL, 0x1ea35236f9330ULL, 0x1ebc291fdce22ULL,
+  0x1ed5022fcd91dULL, 0x1eeddd66fb02dULL, 0x1f06bac594fa0ULL, 0x1f1f9a4bcb409ULL,
+  0x1f387bf9cda38ULL, 0x1f515fcfcbf45ULL, 0x1f6a45cdf6085ULL, 0x1f832df47bb94ULL,
+  0x1f9c18438ce4dULL, 0x1fb504bb596ceULL, 0x1fcdf35c1137aULL, 0x1fe6e425e42f3ULL,
+  0x1fffd7190241eULL, 0x2018cc359b625ULL, 0x2031c37bdf872ULL, 0x204abcebfeab3ULL,
+  0x2063b88628cd6ULL, 0x207cb64a8df0fULL, 0x2095b6395e1d2ULL, 0x20aeb852c95d7ULL,
+  0x20c7bc96ffc18ULL, 0x20e0c306315d1ULL, 0x20f9cba08e483ULL, 0x2112d666469efULL,
+  0x212be3578a819ULL, 0x2144f2748a14aULL, 0x215e03bd7580cULL, 0x217717327cf2cULL,
+  0x21902cd3d09b9ULL, 0x21a944a1a0b07ULL, 0x21c25e9c1d6aaULL, 0x21db7ac37707bULL,
+  0x21f49917ddc96ULL, 0x220db99981f59ULL, 0x2226dc4893d64ULL, 0x2240012543b9cULL,
+  0x2259282fc1f27ULL, 0x227251683ed71ULL, 0x228b7cceeac25ULL, 0x22a4aa63f6134ULL,
+  0x22bdda27912d1ULL, 0x22d70c19ec773ULL, 0x22f0403b385d2ULL, 0x2309768ba54ecULL,
+  0x2322af0b63bffULL, 0x233be9baa428fULL, 0x2355269997062ULL, 0x236e65a86cd81ULL,
+  0x2387a6e756238ULL, 0x23a0ea5683718ULL, 0x23ba2ff6254f4ULL, 0x23d377c66c4e1ULL,
+  0x23ecc1c78903aULL, 0x24060df9ac09bULL, 0x241f5c5d05fe6ULL, 0x2438acf1c783eULL,
+  0x2451ffb82140aULL, 0x246b54b043df6ULL, 0x2484abda600efULL, 0x249e0536a6828ULL,
+  0x24b760c547f15ULL, 0x24d0be8675170ULL, 0x24ea1e7a5eb35ULL, 0x250380a1358a3ULL,
+  0x251ce4fb2a63fULL, 0x25364b886e0d0ULL, 0x254fb44931561ULL, 0x25691f3da5140ULL,
+  0x25828c65fa1ffULL, 0x259bfbc261576ULL, 0x25b56d530b9bcULL, 0x25cee11829d31ULL,
+  0x25e85711ece75ULL, 0x2601cf4085c6eULL, 0x261b49a425645ULL, 0x2634c63cfcb65ULL,
+  0x264e450b3cb82ULL, 0x2667c60f1668eULL, 0x26814948bacc3ULL, 0x269aceb85ae9dULL,
+  0x26b4565e27cddULL, 0x26cde03a52888ULL, 0x26e76c4d0c2e5ULL, 0x2700fa9685d82ULL,
+  0x271a8b16f0a30ULL, 0x27341dce7db03ULL, 0x274db2bd5e254ULL, 0x276749e3c32c0ULL,
+  0x2780e341ddf29ULL, 0x279a7ed7dfab5ULL, 0x27b41ca5f98cbULL, 0x27cdbcac5cd1cULL,
+  0x27e75eeb3ab98ULL, 0x28010362c4877ULL, 0x281aaa132b832ULL, 0x283452fca0f8aULL,
+  0x284dfe1f56381ULL, 0x2867ab7b7c95fULL, 0x28815b11456b1ULL, 0x289b0ce0e2147ULL,
+  0x28b4c0ea83f36ULL, 0x28ce772e5c6d7ULL, 0x28e82fac9cecaULL, 0x2901ea6576df0ULL,
+  0x291ba7591bb70ULL, 0x29356687bceb6ULL, 0x294f27f18bf72ULL, 0x2968eb96ba59aULL,
+  0x2982b17779965ULL, 0x299c7993fb354ULL, 0x29b643ec70c27ULL, 0x29d010810bce8ULL,
+  0x29e9df51fdee1ULL, 0x2a03b05f78ba5ULL, 0x2a1d83a9add08ULL, 0x2a375930ced25ULL,
+  0x2a5130f50d65cULL, 0x2a6b0af69b350ULL, 0x2a84e735a9eecULL, 0x2a9ec5b26b45bULL,
+  0x2ab8a66d10f13ULL, 0x2ad28965ccac9ULL, 0x2aec6e9cd037bULL, 0x2b0656124d56bULL,
+  0x2b203fc675d1fULL, 0x2b3a2bb97b763ULL, 0x2b5419eb90148ULL, 0x2b6e0a5ce5823ULL,
+  0x2b87fd0dad990ULL, 0x2ba1f1fe1a36eULL, 0x2bbbe92e5d3e3ULL, 0x2bd5e29ea8959ULL,
+  0x2befde4f2e280ULL, 0x2c09dc401fe4cULL, 0x2c23dc71afbf7ULL, 0x2c3ddee40fb02ULL,
+  0x2c57e39771b2fULL, 0x2c71ea8c07c89ULL, 0x2c8bf3c203f5fULL, 0x2ca5ff3998446ULL,
+  0x2cc00cf2f6c18ULL, 0x2cda1cee517f3ULL, 0x2cf42f2bda93dULL, 0x2d0e43abc41a0ULL,
+  0x2d285a6e4030bULL, 0x2d42737380fb4ULL, 0x2d5c8ebbb8a15ULL, 0x2d76ac47194efULL,
+  0x2d90cc15d5346ULL, 0x2daaee281e867ULL, 0x2dc5127e277e3ULL, 0x2ddf39182258fULL,
+  0x2df961f641589ULL, 0x2e138d18b6c33ULL, 0x2e2dba7fb4e33ULL, 0x2e47ea2b6e077ULL,
+  0x2e621c1c14833ULL, 0x2e7c5051daadfULL, 0x2e9686ccf2e3bULL, 0x2eb0bf8d8f849ULL,
+  0x2ecafa93e2f56ULL, 0x2ee537e01f9f1ULL, 0x2eff777277ef0ULL, 0x2f19b94b1e570ULL,
+  0x2f33fd6a454d2ULL, 0x2f4e43d01f4beULL, 0x2f688c7cded23ULL, 0x2f82d770b6634ULL,
+  0x2f9d24abd886bULL, 0x2fb7742e77c89ULL, 0x2fd1c5f8c6b93ULL, 0x2fec1a0af7ed6ULL,
+  0x300670653dfe4ULL, 0x3020c907cb896ULL, 0x303b23f2d330bULL, 0x30558126879a7ULL,
+  0x306fe0a31b715ULL, 0x308a4268c1648ULL, 0x30a4a677ac276ULL, 0x30bf0cd00e71eULL,
+  0x30d975721b004ULL, 0x30f3e05e04933ULL, 0x310e4d93fdefbULL, 0x3128bd1439df5ULL,
+  0x31432edeeb2fdULL, 0x315da2f444b39ULL, 0x3178195479413ULL, 0x319291ffbbb3cULL,
+  0x31ad0cf63eeacULL, 0x31c78a3835ca1ULL, 0x31e209c5d33a0ULL, 0x31fc8b9f4a275ULL,
+  0x32170fc4cd831ULL, 0x323196369042eULL, 0x324c1ef4c560aULL, 0x3266a9ff9fdacULL,
+  0x3281375752b40ULL, 0x329bc6fc10f3aULL, 0x32b658ee0da54ULL, 0x32d0ed2d7bd8eULL,
+  0x32eb83ba8ea32ULL, 0x33061c95791ccULL, 0x3320b7be6e633ULL, 0x333b5535a1984ULL,
+  0x3355f4fb45e20ULL, 0x3370970f8e6b3ULL, 0x338b3b72ae62dULL, 0x33a5e224d8fc7ULL,
+  0x33c08b26416ffULL, 0x33db36771af9cULL, 0x33f5e41798daaULL, 0x34109407ee57fULL,
+  0x342b46484ebb4ULL, 0x3445fad8ed52cULL, 0x3460b1b9fd712ULL, 0x347b6aebb26d5ULL,
+  0x3496266e3fa2dULL, 0x34b0e441d8719ULL, 0x34cba466b03e1ULL, 0x34e666dcfa710ULL,
+  0x35012ba4ea77dULL, 0x351bf2beb3c42ULL, 0x3536bc2a89cc4ULL, 0x355187e8a00aeULL,
+  0x356c55f929ff1ULL, 0x3587265c5b2c7ULL, 0x35a1f912671b1ULL, 0x35bcce1b81578ULL,
+  0x35d7a577dd72bULL, 0x35f27f27af022ULL, 0x360d5b2b299fcULL, 0x3628398280ea0ULL,
+  0x36431a2de883bULL, 0x365dfd2d94143ULL, 0x3678e281b7475ULL, 0x3693ca2a85cd7ULL,
+  0x36aeb428335b4ULL, 0x36c9a07af3aa2ULL, 0x36e48f22fa77cULL, 0x36ff80207b865ULL,
+  0x371a7373aa9cbULL, 0x3735691cbb85fULL, 0x3750611be211cULL, 0x376b5b7152147ULL,
+  0x3786581d3f669ULL, 0x37a1571fdde55ULL, 0x37bc587961726ULL, 0x37d75c29fdf3fULL,
+  0x37f26231e754aULL, 0x380d6a9151839ULL, 0x3828754870746ULL, 0x38438257781f6ULL,
+  0x385e91be9c811ULL, 0x3879a37e119abULL, 0x3894b7960b71fULL, 0x38afce06be10eULL,
+  0x38cae6d05d866ULL, 0x38e601f31de57ULL, 0x39011f6f3345fULL, 0x391c3f44d1c41ULL,
+  0x393761742d808ULL, 0x395285fd7aa09ULL, 0x396dace0ed4e1ULL, 0x3988d61eb9b74ULL,
+  0x39a401b7140efULL, 0x39bf2faa308c8ULL, 0x39da5ff8436bcULL, 0x39f592a180ed3ULL,
+  0x3a10c7a61d55bULL, 0x3a2bff064ceecULL, 0x3a4738c244064ULL, 0x3a6274da36eedULL,
+  0x3a7db34e59ff7ULL, 0x3a98f41ee193cULL, 0x3ab4374c020bdULL, 0x3acf7cd5efcc6ULL,
+  0x3aeac4bcdf3eaULL, 0x3b060f0104d04ULL, 0x3b215ba294f39ULL, 0x3b3caaa1c41f7ULL,
+  0x3b57fbfec6cf4ULL, 0x3b734fb9d182fULL, 0x3b8ea5d318befULL, 0x3ba9fe4ad10c4ULL,
+  0x3bc559212ef89ULL, 0x3be0b6566715fULL, 0x3bfc15eaadfb1ULL, 0x3c1777de38434ULL,
+  0x3c32dc313a8e5ULL, 0x3c4e42e3e9808ULL, 0x3c69abf679c2eULL, 0x3c8517692002eULL,
+  0x3ca0853c10f28ULL, 0x3cbbf56f81488ULL, 0x3cd76803a5c00ULL, 0x3cf2dcf8b318dULL,
+  0x3d0e544ede173ULL, 0x3d29ce065b842ULL, 0x3d454a1f602d0ULL, 0x3d60c89a20e40ULL,
+  0x3d7c4976d27faULL, 0x3d97ccb5a9db3ULL, 0x3db35256dbd67ULL, 0x3dceda5a9d55cULL,
+  0x3dea64c123422ULL, 0x3e05f18aa2891ULL, 0x3e2180b7501ccULL, 0x3e3d124760f3dULL,
+  0x3e58a63b0a09bULL, 0x3e743c92805e2ULL, 0x3e8fd54df8f5cULL, 0x3eab706da8d99ULL,
+  0x3ec70df1c5175ULL, 0x3ee2adda82c14ULL, 0x3efe502816ee3ULL, 0x3f19f4dab6b9cULL,
+  0x3f359bf29743fULL, 0x3f51456fedb16ULL, 0x3f6cf152ef2b8ULL, 0x3f889f9bd0e02ULL,
+  0x3fa4504ac801cULL, 0x3fc0036009c78ULL, 0x3fdbb8dbcb6d2ULL, 0x3ff770be4232fULL,
+  0x40132b07a35dfULL, 0x402ee7b82437bULL, 0x404aa6cffa0e5ULL, 0x4066684f5a34bULL,
+  0x40822c367a024ULL, 0x409df2858ed31ULL, 0x40b9bb3cce07cULL, 0x40d5865c6d05aULL,
+  0x40f153e4a136aULL, 0x410d23d5a0095ULL, 0x4128f62f9ef0eULL, 0x4144caf2d3653ULL,
+  0x4160a21f72e2aULL, 0x417c7bb5b2ea5ULL, 0x419857b5c901fULL, 0x41b4361feab3fULL,
+  0x41d016f44d8f5ULL, 0x41ebfa332727aULL, 0x4207dfdcad153ULL, 0x4223c7f114f50ULL,
+  0x423fb2709468aULL, 0x425b9f5b61163ULL, 0x42778eb1b0a8bULL, 0x42938073b8cf9ULL,
+  0x42af74a1af3f1ULL, 0x42cb6b3bc9b00ULL, 0x42e764423ddfdULL, 0x43035fb54190bULL,
+  0x431f5d950a897ULL, 0x433b5de1ce958ULL, 0x4357609bc3850ULL, 0x437365c31f2ccULL,
+  0x438f6d5817663ULL, 0x43ab775ae20f7ULL, 0x43c783cbb50b4ULL, 0x43e392aac6413ULL,
+  0x43ffa3f84b9d4ULL, 0x441bb7b47b105ULL, 0x4437cddf8a8feULL, 0x4453e679b0160ULL,
+  0x4470018321a1aULL, 0x448c1efc15362ULL, 0x44a83ee4c0dbdULL, 0x44c4613d5a9f9ULL,
+  0x44e086061892dULL, 0x44fcad3f30cbeULL, 0x4518d6e8d965bULL, 0x45350303487feULL,
+  0x4551318eb43ecULL, 0x456d628b52cb4ULL, 0x458995f95a532ULL, 0x45a5cbd90108bULL,
+  0x45c2042a7d232ULL, 0x45de3eee04de2ULL, 0x45fa7c23ce7a4ULL, 0x4616bbcc103cbULL,
+  0x4632fde7006f4ULL, 0x464f4274d5609ULL, 0x466b8975c563eULL, 0x4687d2ea06d15ULL,
+  0x46a41ed1d0057ULL, 0x46c06d2d5761dULL, 0x46dcbdfcd34c8ULL, 0x46f911407a306ULL,
+  0x471566f8827d0ULL, 0x4731bf2522a6aULL, 0x474e19c691265ULL, 0x476a76dd0479cULL,
+  0x4786d668b3237ULL, 0x47a33869d3aa7ULL, 0x47bf9ce09c9abULL, 0x47dc03cd4484eULL,
+  0x47f86d3001fe5ULL, 0x4814d9090ba11ULL, 0x48314758980bfULL, 0x484db81edde28ULL,
+  0x486a2b5c13cd0ULL, 0x4886a11070788ULL, 0x48a3193c2a96cULL, 0x48bf93df78de3ULL,
+  0x48dc10fa920a1ULL, 0x48f8908dacda7ULL, 0x491512990013fULL, 0x4931971cc2802ULL,
+  0x494e1e192aed2ULL, 0x496aa78e702dfULL, 0x4987337cc91a5ULL, 0x49a3c1e46c8ebULL,
+  0x49c052c5916c4ULL, 0x49dce6206e991ULL, 0x49f97bf53affdULL, 0x4a1614442d900ULL,
+  0x4a32af0d7d3deULL, 0x4a4f4c5161028ULL, 0x4a6bec100fdbaULL, 0x4a888e49c0cbdULL,
+  0x4aa532feaada6ULL, 0x4ac1da2f05135ULL, 0x4ade83db0687aULL, 0x4afb3002e64ceULL,
+  0x4b17dea6db7d7ULL, 0x4b348fc71d388ULL, 0x4b514363e2a20ULL, 0x4b6df97d62e2cULL,
+  0x4b8ab213d5283ULL, 0x4ba76d2770a49ULL, 0x4bc42ab86c8f1ULL, 0x4be0eac700237ULL,
+  0x4bfdad5362a27ULL, 0x4c1a725dcb517ULL, 0x4c3739e6717aaULL, 0x4c5403ed8c6d2ULL,
+  0x4c70d073537caULL, 0x4c8d9f77fe01dULL, 0x4caa70fbc35a1ULL, 0x4cc744fedae78ULL,
+  0x4ce41b817c114ULL, 0x4d00f483de431ULL, 0x4d1dd00638ed8ULL, 0x4d3aae08c3860ULL,
+  0x4d578e8bb586bULL, 0x4d74718f466ecULL, 0x4d915713adc1eULL, 0x4dae3f192308cULL,
+  0x4dcb299fddd0dULL, 0x4de816a815ac6ULL, 0x4e05063202327ULL, 0x4e21f83ddafefULL,
+  0x4e3eeccbd7b2aULL, 0x4e5be3dc2ff30ULL, 0x4e78dd6f1b6a6ULL, 0x4e95d984d1c81ULL,
+  0x4eb2d81d8abffULL, 0x4ecfd9397e0aeULL, 0x4eecdcd8e3669ULL, 0x4f09e2fbf2958ULL,
+  0x4f26eba2e35f0ULL, 0x4f43f6cded8f4ULL, 0x4f61047d48f73ULL, 0x4f7e14b12d6cbULL,
+  0x4f9b2769d2ca7ULL, 0x4fb83ca770efeULL, 0x4fd5546a3fc17ULL, 0x4ff26eb277284ULL,
+  0x500f8b804f127ULL, 0x502caad3ff72dULL, 0x5049ccadc0412ULL, 0x5066f10dc97a0ULL,
+  0x508417f4531eeULL, 0x50a1416195360ULL, 0x50be6d55c7ca9ULL, 0x50db9bd122ec9ULL,
+  0x50f8ccd3deb0dULL, 0x5116005e33311ULL, 0x51333670588bfULL, 0x51506f0a86e4eULL,
+  0x516daa2cf6642ULL, 0x518ae7d7df36eULL, 0x51a8280b798f4ULL, 0x51c56ac7fda42ULL,
+  0x51e2b00da3b14ULL, 0x51fff7dca3f75ULL, 0x521d423536bbeULL, 0x523a8f1794495ULL,
+  0x5257de83f4eefULL, 0x5275307a9100eULL, 0x529284fba0d84ULL, 0x52afdc075cd2fULL,
+  0x52cd359dfd53dULL, 0x52ea91bfbac28ULL, 0x5307f06ccd8baULL, 0x532551a56e20cULL,
+  0x5342b569d4f82ULL, 0x53601bba3a8d1ULL, 0x537d8496d75fcULL, 0x539aefffe3f54ULL,
+  0x53b85df598d78ULL, 0x53d5ce782e955ULL, 0x53f34187ddc28ULL, 0x5410b724def7bULL,
+  0x542e2f4f6ad27ULL, 0x544baa07b9f54ULL, 0x5469274e05078ULL, 0x5486a72284b58ULL,
+  0x54a4298571b06ULL, 0x54c1ae7704ae4ULL, 0x54df35f7766a3ULL, 0x54fcc006ffa42ULL,
+  0x551a4ca5d920fULL, 0x5537dbd43baa5ULL, 0x55556d92600f1ULL, 0x557301e07f22cULL,
+  0x559098bed1bdfULL, 0x55ae322d90be2ULL, 0x55cbce2cf505bULL, 0x55e96cbd377beULL,
+  0x56070dde910d2ULL, 0x5624b1913aaa8ULL, 0x564257d56d4a2ULL, 0x566000ab61e73ULL,
+  0x567dac1351819ULL, 0x569b5a0d751e4ULL, 0x56b90a9a05c72ULL, 0x56d6bdb93c8b0ULL,
+  0x56f4736b527daULL, 0x57122bb080b7dULL, 0x572fe68900573ULL, 0x574da3f50a7e5ULL,
+  0x576b63f4d854cULL, 0x57892688a3072ULL, 0x57a6ebb0a3c6dULL, 0x57c4b36d13ca5ULL,
+  0x57e27dbe2c4cfULL, 0x58004aa4268f1ULL, 0x581e1a1f3bd60ULL, 0x583bec2fa56c1ULL,
+  0x5859c0d59ca07ULL, 0x587798115ac76ULL, 0x589571e31939fULL, 0x58b34e4b11567ULL,
+  0x58d12d497c7fdULL, 0x58ef0ede941e4ULL, 0x590cf30a919edULL, 0x592ad9cdae738ULL,
+  0x5948c32824135ULL, 0x5966af1a2bfa5ULL, 0x59849da3ffa96ULL, 0x59a28ec5d8a69ULL,
+  0x59c0827ff07ccULL, 0x59de78d280bbeULL, 0x59fc71bdc2f8eULL, 0x5a1a6d41f0cdbULL,
+  0x5a386b5f43d92ULL, 0x5a566c15f5bf3ULL, 0x5a746f664028bULL, 0x5a9275505cc38ULL,
+  0x5ab07dd485429ULL, 0x5ace88f2f35dcULL, 0x5aec96abe0d1fULL, 0x5b0aa6ff87610ULL,
+  0x5b28b9ee20d1eULL, 0x5b46cf77e6f06ULL, 0x5b64e79d138d8ULL, 0x5b83025de07f2ULL,
+  0x5ba11fba87a03ULL, 0x5bbf3fb342d0aULL, 0x5bdd62484bf56ULL, 0x5bfb8779dcf88ULL,
+  0x5c19af482fc8fULL, 0x5c37d9b37e5abULL, 0x5c5606bc02a6dULL, 0x5c743661f6ab6ULL,
+  0x5c9268a5946b7ULL, 0x5cb09d8715ef3ULL, 0x5cced506b543aULL, 0x5ced0f24ac7b2ULL,
+  0x5d0b4be135accULL, 0x5d298b3c8af4cULL, 0x5d47cd36e6747ULL, 0x5d6611d082522ULL,
+  0x5d84590998b93ULL, 0x5da2a2e263d9fULL, 0x5dc0ef5b1de9eULL, 0x5ddf3e7401238ULL,
+  0x5dfd902d47c65ULL, 0x5e1be4872c16dULL, 0x5e3a3b81e85ecULL, 0x5e58951db6eccULL,
+  0x5e76f15ad2148ULL, 0x5e955039742eeULL, 0x5eb3b1b9d799aULL, 0x5ed215dc36b7bULL,
+  0x5ef07ca0cbf0fULL, 0x5f0ee607d1b29ULL, 0x5f2d5211826e8ULL, 0x5f4bc0be189beULL,
+  0x5f6a320dceb71ULL, 0x5f88a600df413ULL, 0x5fa71c9784c0bULL, 0x5fc595d1f9c0fULL,
+  0x5fe411b078d26ULL, 0x600290333c8acULL, 0x6021115a7f849ULL, 0x603f95267c5f9ULL,
+  0x605e1b976dc09ULL, 0x607ca4ad8e517ULL, 0x609b306918c13ULL, 0x60b9beca47c3eULL,
+  0x60d84fd15612aULL, 0x60f6e37e7e6bbULL, 0x611579d1fb925ULL, 0x613412cc084f1ULL,
+  0x6152ae6cdf6f4ULL, 0x61714cb4bbc5bULL, 0x618feda3d829fULL, 0x61ae913a6f78dULL,
+  0x61cd3778bc944ULL, 0x61ebe05efa634ULL, 0x620a8bed63d1fULL, 0x62293a2433d18ULL,
+  0x6247eb03a5585ULL, 0x62669e8bf361bULL, 0x628554bd58ee5ULL, 0x62a40d981103cULL,
+  0x62c2c91c56acdULL, 0x62e1874a64f97ULL, 0x6300482276fe8ULL, 0x631f0ba4c7d64ULL,
+  0x633dd1d1929fdULL, 0x635c9aa9127fbULL, 0x637b662b829f5ULL, 0x639a34591e2d5ULL,
+  0x63b90532205d8ULL, 0x63d7d8b6c468aULL, 0x63f6aee7458cdULL, 0x641587c3df0d3ULL,
+  0x6434634ccc320ULL, 0x645341824848bULL, 0x647222648ea3dULL, 0x649105f3da9b2ULL,
+  0x64afec30678b7ULL, 0x64ced51a70d6bULL, 0x64edc0b231e41ULL, 0x650caef7e61fdULL,
+  0x652b9febc8fb7ULL, 0x654a938e15ed7ULL, 0x656989df08719ULL, 0x658882dedc08cULL,
+  0x65a77e8dcc390ULL, 0x65c67cec148d8ULL, 0x65e57df9f096bULL, 0x660481b79bea1ULL,
+  0x6623882552225ULL, 0x664291434edf4ULL, 0x66619d11cdc5fULL, 0x6680ab910a809ULL,
+  0x669fbcc140be7ULL, 0x66bed0a2ac343ULL, 0x66dde735889b8ULL, 0x66fd007a11b33ULL,
+  0x671c1c70833f6ULL, 0x673b3b1919094ULL, 0x675a5c740edf5ULL, 0x67798081a0951ULL,
+  0x6798a7420a036ULL, 0x67b7d0b587083ULL, 0x67d6fcdc5386aULL, 0x67f62bb6ab672ULL,
+  0x68155d44ca973ULL, 0x68349186ed099ULL, 0x6853c87d4eb62ULL, 0x687302282b9a1ULL,
+  0x68923e87bfb7aULL, 0x68b17d9c47168ULL, 0x68d0bf65fdc34ULL, 0x68f003e51fcfeULL,
+  0x690f4b19e9538ULL, 0x692e9504966a8ULL, 0x694de1a563367ULL, 0x696d30fc8bde0ULL,
+  0x698c830a4c8d4ULL, 0x69abd7cee1755ULL, 0x69cb2f4a86ccaULL, 0x69ea897d78ceeULL,
+  0x6a09e667f3bcdULL, 0x6a29460a33dc8ULL, 0x6a48a86475795ULL, 0x6a680d76f4e3cULL,
+  0x6a877541ee718ULL, 0x6aa6dfc59e7d9ULL, 0x6ac64d0241683ULL, 0x6ae5bcf81396cULL,
+  0x6b052fa75173eULL, 0x6b24a510376f9ULL, 0x6b441d3301feeULL, 0x6b63980fed9c4ULL,
+  0x6b8315a736c75ULL, 0x6ba295f91a04eULL, 0x6bc21905d3df0ULL, 0x6be19ecda0e53ULL,
+  0x6c012750bdabfULL, 0x6c20b28f66cd2ULL, 0x6c404089d8e7dULL, 0x6c5fd14050a07ULL,
+  0x6c7f64b30aa09ULL, 0x6c9efae243971ULL, 0x6cbe93ce38381ULL, 0x6cde2f77253cfULL,
+  0x6cfdcddd47645ULL, 0x6d1d6f00db723ULL, 0x6d3d12e21e2fbULL, 0x6d5cb9814c6b5ULL,
+  0x6d7c62dea2f8aULL, 0x6d9c0efa5eb0dULL, 0x6dbbbdd4bc720ULL, 0x6ddb6f6df91fcULL,
+  0x6dfb23c651a2fULL, 0x6e1adade02e99ULL, 0x6e3a94b549e71ULL, 0x6e5a514c63941ULL,
+  0x6e7a10a38cee8ULL, 0x6e99d2bb02f99ULL, 0x6eb9979302bddULL, 0x6ed95f2bc9490ULL,
+  0x6ef9298593ae5ULL, 0x6f18f6a09f060ULL, 0x6f38c67d286ddULL, 0x6f58991b6d08bULL,
+  0x6f786e7ba9fefULL, 0x6f98469e1c7e1ULL, 0x6fb8218301b90ULL, 0x6fd7ff2a96e7eULL,
+  0x6ff7df9519484ULL, 0x7017c2c2c61cdULL, 0x7037a8b3daadbULL, 0x7057916894485ULL,
+  0x70777ce1303f6ULL, 0x70976b1debeaeULL, 0x70b75c1f04a84ULL, 0x70d74fe4b7da2ULL,
+  0x70f7466f42e87ULL, 0x71173fbee3409ULL, 0x71373bd3d6551ULL, 0x71573aae599dfULL,
+  0x71773c4eaa988ULL, 0x719740b506c74ULL, 0x71b747e1abb24ULL, 0x71d751d4d6e6bULL,
+  0x71f75e8ec5f74ULL, 0x72176e0fb67bdULL, 0x72378057e611aULL, 0x72579567925b6ULL,
+  0x7277ad3ef9011ULL, 0x7297c7de57afeULL, 0x72b7e545ec1a8ULL, 0x72d80575f3f90ULL,
+  0x72f8286ead08aULL, 0x73184e30550c2ULL, 0x733876bb29cb8ULL, 0x7358a20f69143ULL,
+  0x7378d02d50b8fULL, 0x739901151e91eULL, 0x73b934c7107c7ULL, 0x73d96b43645b8ULL,
+  0x73f9a48a58174ULL, 0x7419e09c299d3ULL, 0x743a1f7916e05ULL, 0x745a61215dd8eULL,
+  0x747aa5953c849ULL, 0x749aecd4f0e66ULL, 0x74bb36e0b906dULL, 0x74db83b8d2f39ULL,
+  0x74fbd35d7cbfdULL, 0x751c25cef4843ULL, 0x753c7b0d785e8ULL, 0x755cd31946722ULL,
+  0x757d2df29ce7cULL, 0x759d8b99b9ed7ULL, 0x75bdec0edbb6bULL, 0x75de4f52407c5ULL,
+  0x75feb564267c9ULL, 0x761f1e44cbfb2ULL, 0x763f89f46f40fULL, 0x765ff8734e9caULL,
+  0x768069c1a861dULL, 0x76a0dddfbae9fULL, 0x76c154cdc4937ULL, 0x76e1ce8c03c29ULL,
+  0x77024b1ab6e09ULL, 0x7722ca7a1c5c8ULL, 0x77434caa72aa7ULL, 0x7763d1abf8444ULL,
+  0x7784597eeba8fULL, 0x77a4e4238b5d0ULL, 0x77c5719a15ea6ULL, 0x77e601e2c9e07ULL,
+  0x780694fde5d3fULL, 0x78272aeba85f2ULL, 0x7847c3ac50219ULL, 0x78685f401bc05ULL,
+  0x7888fda749e5dULL, 0x78a99ee219421ULL, 0x78ca42f0c88a5ULL, 0x78eae9d396795ULL,
+  0x790b938ac1cf6ULL, 0x792c401689522ULL, 0x794cef772bcc9ULL, 0x796da1ace80f4ULL,
+  0x798e56b7fcf03ULL, 0x79af0e98a94adULL, 0x79cfc94f2bfffULL, 0x79f086dbc3f5eULL,
+  0x7a11473eb0187ULL, 0x7a320a782f58cULL, 0x7a52d08880ad9ULL, 0x7a73996fe3130ULL,
+  0x7a94652e958aaULL, 0x7ab533c4d71b7ULL, 0x7ad60532e6d20ULL, 0x7af6d97903c04ULL,
+  0x7b17b0976cfdbULL, 0x7b388a8e61a72ULL, 0x7b59675e20defULL, 0x7b7a4706e9cd1ULL,
+  0x7b9b2988fb9ecULL, 0x7bbc0ee49586dULL, 0x7bdcf719f6bd7ULL, 0x7bfde2295e808ULL,
+  0x7c1ed0130c132ULL, 0x7c3fc0d73ebe2ULL, 0x7c60b47635cf9ULL, 0x7c81aaf0309b3ULL,
+  0x7ca2a4456e7a3ULL, 0x7cc3a0762ecb2ULL, 0x7ce49f82b0f24ULL, 0x7d05a16b34593ULL,
+  0x7d26a62ff86f0ULL, 0x7d47add13ca87ULL, 0x7d68b84f407f8ULL, 0x7d89c5aa4373eULL,
+  0x7daad5e2850acULL, 0x7dcbe8f844cebULL, 0x7decfeebc24feULL, 0x7e0e17bd3d240ULL,
+  0x7e2f336cf4e62ULL, 0x7e5051fb29370ULL, 0x7e71736819bcdULL, 0x7e9297b406234ULL,
+  0x7eb3bedf2e1b9ULL, 0x7ed4e8e9d15c8ULL, 0x7ef615d42fa24ULL, 0x7f17459e88aebULL,
+  0x7f3878491c491ULL, 0x7f59add42a3e4ULL, 0x7f7ae63ff260aULL, 0x7f9c218cb4881ULL,
+  0x7fbd5fbab091fULL, 0x7fdea0ca26616ULL, 0x7fffe4bb55decULL, 0x80212b8e7ef82ULL,
+  0x80427543e1a12ULL, 0x8063c1dbbdd2dULL, 0x80851156538beULL, 0x80a663b3e2d09ULL,
+  0x80c7b8f4abaa9ULL, 0x80e91118ee294ULL, 0x810a6c20ea617ULL, 0x812bca0ce06d9ULL,
+  0x814d2add106d9ULL, 0x816e8e91ba871ULL, 0x818ff52b1ee50ULL, 0x81b15ea97db82ULL,
+  0x81d2cb0d1736aULL, 0x81f43a562b9c4ULL, 0x8215ac84fb2a6ULL, 0x82372199c627dULL,
+  0x82589994cce13ULL, 0x827a14764fa86ULL, 0x829b923e8ed53ULL, 0x82bd12edcac4aULL,
+  0x82de968443d9aULL, 0x83001d023a7c8ULL, 0x8321a667ef1b2ULL, 0x834332b5a2291ULL,
+  0x8364c1eb941f7ULL, 0x8386540a057cfULL, 0x83a7e91136c5dULL, 0x83c9810168840ULL,
+  0x83eb1bdadb46dULL, 0x840cb99dcfa38ULL, 0x842e5a4a8634aULL, 0x844ffde13f9a7ULL,
+  0x8471a4623c7adULL, 0x84934dcdbd813ULL, 0x84b4fa24035eaULL, 0x84d6a9654ec9eULL,
+  0x84f85b91e07f1ULL, 0x851a10a9f9403ULL, 0x853bc8add9d4cULL, 0x855d839dc309cULL,
+  0x857f4179f5b21ULL, 0x85a10242b2a5fULL, 0x85c2c5f83ac35ULL, 0x85e48c9aceedeULL,
+  0x8606562ab00ecULL, 0x862822a81f14dULL, 0x8649f2135cf48ULL, 0x866bc46caaa7fULL,
+  0x868d99b4492edULL, 0x86af71ea798e7ULL, 0x86d14d0f7cd1dULL, 0x86f32b239409bULL,
+  0x87150c27004c2ULL, 0x8736f01a02b53ULL, 0x8758d6fcdc666ULL, 0x877ac0cfce86dULL,
+  0x879cad931a436ULL, 0x87be9d4700ce9ULL, 0x87e08febc3608ULL, 0x88028581a3370ULL,
+  0x88247e08e1957ULL, 0x88467981bfc4fULL, 0x886877ec7f144ULL, 0x888a794960d7cULL,
+  0x88ac7d98a6699ULL, 0x88ce84da91297ULL, 0x88f08f0f627cbULL, 0x89129c375bce8ULL,
+  0x8934ac52be8f7ULL, 0x8956bf61cc361ULL, 0x8978d564c63e7ULL, 0x899aee5bee2a4ULL,
+  0x89bd0a478580fULL, 0x89df2927cdcfbULL, 0x8a014afd08a94ULL, 0x8a236fc777a60ULL,
+  0x8a4597875c644ULL, 0x8a67c23cf887cULL, 0x8a89efe88dba1ULL, 0x8aac208a5daa7ULL,
+  0x8ace5422aa0dbULL, 0x8af08ab1b49e9ULL, 0x8b12c437bf1d4ULL, 0x8b3500b50b4fdULL,
+  0x8b574029db01eULL, 0x8b7982967004fULL, 0x8b9bc7fb0c302ULL, 0x8bbe1057f1602ULL,
+  0x8be05bad61778ULL, 0x8c02a9fb9e5e9ULL, 0x8c24fb42ea033ULL, 0x8c474f8386591ULL,
+  0x8c69a6bdb5598ULL, 0x8c8c00f1b903aULL, 0x8cae5e1fd35c4ULL, 0x8cd0be48466deULL,
+  0x8cf3216b5448cULL, 0x8d1587893f02eULL, 0x8d37f0a248b7fULL, 0x8d5a5cb6b3896ULL,
+  0x8d7ccbc6c19e6ULL, 0x8d9f3dd2b523dULL, 0x8dc1b2dad04c4ULL, 0x8de42adf55502ULL,
+  0x8e06a5e0866d9ULL, 0x8e2923dea5e85ULL, 0x8e4ba4d9f60a1ULL, 0x8e6e28d2b9221ULL,
+  0x8e90afc931857ULL, 0x8eb339bda18f0ULL, 0x8ed5c6b04b9f6ULL, 0x8ef856a1721cdULL,
+  0x8f1ae99157736ULL, 0x8f3d7f803e150ULL, 0x8f60186e68793ULL, 0x8f82b45c191d6ULL,
+  0x8fa553499284bULL, 0x8fc7f5371737eULL, 0x8fea9a24e9c5cULL, 0x900d42134cc29ULL,
+  0x902fed0282c8aULL, 0x90529af2ce77eULL, 0x90754be472760ULL, 0x9097ffd7b16e8ULL,
+  0x90bab6ccce12cULL, 0x90dd70c40b19bULL, 0x91002dbdab403ULL, 0x9122edb9f148fULL,
+  0x9145b0b91ffc6ULL, 0x916876bb7a289ULL, 0x918b3fc142a19ULL, 0x91ae0bcabc413ULL,
+  0x91d0dad829e70ULL, 0x91f3ace9ce785ULL, 0x921681ffece05ULL, 0x92395a1ac8100ULL,
+  0x925c353aa2fe2ULL, 0x927f135fc0a74ULL, 0x92a1f48a640dcULL, 0x92c4d8bad039cULL,
+  0x92e7bff148396ULL, 0x930aaa2e0f204ULL, 0x932d977168083ULL, 0x935087bb96107ULL,
+  0x93737b0cdc5e5ULL, 0x939671657e1ceULL, 0x93b96ac5be7d1ULL, 0x93dc672de0b57ULL,
+  0x93ff669e2802bULL, 0x94226916d7a71ULL, 0x94456e9832eadULL, 0x946877227d1bfULL,
+  0x948b82b5f98e5ULL, 0x94ae9152eb9b9ULL, 0x94d1a2f996a33ULL, 0x94f4b7aa3e0aaULL,
+  0x9517cf65253d1ULL, 0x953aea2a8fab7ULL, 0x955e07fac0ccdULL, 0x958128d5fc1dcULL,
+  0x95a44cbc8520fULL, 0x95c773ae9f5ecULL, 0x95ea9dac8e658ULL, 0x960dcab695c95ULL,
+  0x9630faccf9243ULL, 0x96542deffc160ULL, 0x9677641fe2446ULL, 0x969a9d5cef5afULL,
+  0x96bdd9a7670b3ULL, 0x96e118ff8d0c6ULL, 0x97045b65a51baULL, 0x9727a0d9f2fc0ULL,
+  0x974ae95cba768ULL, 0x976e34ee3f59dULL, 0x9791838ec57abULL, 0x97b4d53e90b39ULL,
+  0x97d829fde4e50ULL, 0x97fb81cd05f52ULL, 0x981edcac37d05ULL, 0x98423a9bbe688ULL,
+  0x98659b9bddb5bULL, 0x9888ffacd9b5dULL, 0x98ac66cef66c8ULL, 0x98cfd10277e37ULL,
+  0x98f33e47a22a2ULL, 0x9916ae9eb9561ULL, 0x993a220801829ULL, 0x995d9883bed0dULL,
+  0x9981121235681ULL, 0x99a48eb3a9753ULL, 0x99c80e685f2b5ULL, 0x99eb91309ac33ULL,
+  0x9a0f170ca07baULL, 0x9a329ffcb4995ULL, 0x9a562c011b66dULL, 0x9a79bb1a1934cULL,
+  0x9a9d4d47f2598ULL, 0x9ac0e28aeb316ULL, 0x9ae47ae3481edULL, 0x9b0816514d89eULL,
+  0x9b2bb4d53fe0dULL, 0x9b4f566f6397aULL, 0x9b72fb1ffd285ULL, 0x9b96a2e75112eULL,
+  0x9bba4dc5a3dd3ULL, 0x9bddfbbb3a131ULL, 0x9c01acc858463ULL, 0x9c2560ed430e4ULL,
+  0x9c49182a3f090ULL, 0x9c6cd27f90d9fULL, 0x9c908fed7d2aaULL, 0x9cb4507448aa9ULL,
+  0x9cd81414380f2ULL, 0x9cfbdacd9013dULL, 0x9d1fa4a09579dULL, 0x9d43718d8d089ULL,
+  0x9d674194bb8d5ULL, 0x9d8b14b665db3ULL, 0x9daeeaf2d0cb8ULL, 0x9dd2c44a413d6ULL,
+  0x9df6a0bcfc15eULL, 0x9e1a804b46403ULL, 0x9e3e62f564ad5ULL, 0x9e6248bb9c545ULL,
+  0x9e86319e32323ULL, 0x9eaa1d9d6b4a0ULL, 0x9ece0cb98ca4bULL, 0x9ef1fef2db513ULL,
+  0x9f15f4499c647ULL, 0x9f39ecbe14f97ULL, 0x9f5de8508a311ULL, 0x9f81e70141324ULL,
+  0x9fa5e8d07f29eULL, 0x9fc9edbe894adULL, 0x9fedf5cba4ce0ULL, 0xa01200f816f25ULL,
+  0xa0360f4424fcbULL, 0xa05a20b01437fULL, 0xa07e353c29f50ULL, 0xa0a24ce8ab8adULL,
+  0xa0c667b5de565ULL, 0xa0ea85a407ba5ULL, 0xa10ea6b36d1feULL, 0xa132cae453f5eULL,
+  0xa156f23701b15ULL, 0xa17b1cabbbcd4ULL, 0xa19f4a42c7ca9ULL, 0xa1c37afc6b306ULL,
+  0xa1e7aed8eb8bbULL, 0xa20be5d88e6fbULL, 0xa2301ffb99757ULL, 0xa2545d42523c1ULL,
+  0xa2789dacfe68cULL, 0xa29ce13be3a6cULL, 0xa2c127ef47a74ULL, 0xa2e571c77021aULL,
+  0xa309bec4a2d33ULL, 0xa32e0ee7257f5ULL, 0xa352622f3def6ULL, 0xa376b89d31f2fULL,
+  0xa39b1231475f7ULL, 0xa3bf6eebc4108ULL, 0xa3e3ceccede7cULL, 0xa40831d50accdULL,
+  0xa42c980460ad8ULL, 0xa451015b357d9ULL, 0xa4756dd9cf36eULL, 0xa499dd8073d96ULL,
+  0xa4be504f696b1ULL, 0xa4e2c646f5f7fULL, 0xa5073f675f924ULL, 0xa52bbbb0ec521ULL,
+  0xa5503b23e255dULL, 0xa574bdc087c1bULL, 0xa599438722c03ULL, 0xa5bdcc77f981eULL,
+  0xa5e25893523d4ULL, 0xa606e7d9732f1ULL, 0xa62b7a4aa29a1ULL, 0xa6500fe726c72ULL,
+  0xa674a8af46052ULL, 0xa69944a346a93ULL, 0xa6bde3c36f0e6ULL, 0xa6e286100595fULL,
+  0xa7072b8950a73ULL, 0xa72bd42f96afaULL, 0xa75080031e22bULL, 0xa7752f042d7a1ULL,
+  0xa799e1330b358ULL, 0xa7be968ffddaeULL, 0xa7e34f1b4bf62ULL, 0xa8080ad53c195ULL,
+  0xa82cc9be14dcaULL, 0xa8518bd61cde7ULL, 0xa876511d9ac32ULL, 0xa89b1994d5354ULL,
+  0xa8bfe53c12e59ULL, 0xa8e4b4139a8acULL, 0xa909861bb2e1dULL, 0xa92e5b54a2adcULL,
+  0xa95333beb0b7eULL, 0xa9780f5a23cf6ULL, 0xa99cee2742c9dULL, 0xa9c1d0265482cULL,
+  0xa9e6b5579fdbfULL, 0xaa0b9dbb6bbd5ULL, 0xaa308951ff14dULL, 0xaa55781ba0d6aULL,
+  0xaa7a6a1897fd2ULL, 0xaa9f5f492b88cULL, 0xaac457ada2803ULL, 0xaae9534643f03ULL,
+  0xab0e521356ebaULL, 0xab335415228bbULL, 0xab58594bedefaULL, 0xab7d61b8003cdULL,
+  0xaba26d59a09eeULL, 0xabc77c311647aULL, 0xabec8e3ea86eeULL, 0xac11a3829e52cULL,
+  0xac36bbfd3f37aULL, 0xac5bd7aed267dULL, 0xac80f6979f340ULL, 0xaca618b7ecf31ULL,
+  0xaccb3e100301eULL, 0xacf066a028c3aULL, 0xad159268a5a1cULL, 0xad3ac169c10bbULL,
+  0xad5ff3a3c2774ULL, 0xad852916f1606ULL, 0xadaa61c395493ULL, 0xadcf9da9f5b9fULL,
+  0xadf4dcca5a413ULL, 0xae1a1f250a73bULL, 0xae3f64ba4dec6ULL, 0xae64ad8a6c4c5ULL,
+  0xae89f995ad3adULL, 0xaeaf48dc58659ULL, 0xaed49b5eb5803ULL, 0xaef9f11d0c44bULL,
+  0xaf1f4a17a4735ULL, 0xaf44a64ec5d26ULL, 0xaf6a05c2b82e9ULL, 0xaf8f6873c35acULL,
+  0xafb4ce622f2ffULL, 0xafda378e438d7ULL, 0xafffa3f84858cULL, 0xb02513a0857dbULL,
+  0xb04a868742ee4ULL, 0xb06ffcacc8a2aULL, 0xb09576115e994ULL, 0xb0baf2b54cd6dULL,
+  0xb0e07298db666ULL, 0xb105f5bc5258fULL, 0xb12b7c1ff9c61ULL, 0xb15105c419cb6ULL,
+  0xb17692a8fa8cdULL, 0xb19c22cee4349ULL, 0xb1c1b6361ef31ULL, 0xb1e74cdef2fefULL,
+  0xb20ce6c9a8952ULL, 0xb23283f687f8fULL, 0xb2582465d973cULL, 0xb27dc817e5555ULL,
+  0xb2a36f0cf3f3aULL, 0xb2c919454daafULL, 0xb2eec6c13adddULL, 0xb314778103f50ULL,
+  0xb33a2b84f15fbULL, 0xb35fe2cd4b932ULL, 0xb3859d5a5b0b1ULL, 0xb3ab5b2c68495ULL,
+  0xb3d11c43bbd62ULL, 0xb3f6e0a09e3ffULL, 0xb41ca843581baULL, 0xb442732c32044ULL,
+  0xb468415b749b1ULL, 0xb48e12d16887dULL, 0xb4b3e78e56786ULL, 0xb4d9bf9287210ULL,
+  0xb4ff9ade433c6ULL, 0xb5257971d38b2ULL, 0xb54b5b4d80d4aULL, 0xb571407193e63ULL,
+  0xb59728de5593aULL, 0xb5bd14940eb70ULL, 0xb5e303930830cULL, 0xb608f5db8ae79ULL,
+  0xb62eeb6ddfc87ULL, 0xb654e44a4fc6cULL, 0xb67ae07123dc3ULL, 0xb6a0dfe2a508bULL,
+  0xb6c6e29f1c52aULL, 0xb6ece8a6d2c6aULL, 0xb712f1fa1177bULL, 0xb738fe99217f1ULL,
+  0xb75f0e844bfc6ULL, 0xb78521bbda15cULL, 0xb7ab384014f76ULL, 0xb7d1521145d3fULL,
+  0xb7f76f2fb5e47ULL, 0xb81d8f9bae684ULL, 0xb843b35578a51ULL, 0xb869da5d5de6fULL,
+  0xb89004b3a7804ULL, 0xb8b632589ec9bULL, 0xb8dc634c8d228ULL, 0xb902978fbbf01ULL,
+  0xb928cf22749e4ULL, 0xb94f0a05009f3ULL, 0xb9754837a96b7ULL, 0xb99b89bab881fULL,
+  0xb9c1ce8e77680ULL, 0xb9e816b32fa95ULL, 0xba0e62292ad7dULL, 0xba34b0f0b28c0ULL,
+  0xba5b030a1064aULL, 0xba8158758e06dULL, 0xbaa7b133751e3ULL, 0xbace0d440f5caULL,
+  0xbaf46ca7a67a7ULL, 0xbb1acf5e84367ULL, 0xbb413568f255aULL, 0xbb679ec73aa38ULL,
+  0xbb8e0b79a6f1fULL, 0xbbb47b8081194ULL, 0xbbdaeedc12f82ULL, 0xbc01658ca673bULL,
+  0xbc27df9285775ULL, 0xbc4e5cedf9f50ULL, 0xbc74dd9f4de4fULL, 0xbc9b61a6cb460ULL,
+  0xbcc1e904bc1d2ULL, 0xbce873b96a760ULL, 0xbd0f01c520628ULL, 0xbd35932827fb0ULL,
+  0xbd5c27e2cb5e5ULL, 0xbd82bff554b1bULL, 0xbda95b600e20bULL, 0xbdcffa2341dd7ULL,
+  0xbdf69c3f3a207ULL, 0xbe1d41b44128aULL, 0xbe43ea82a13b5ULL, 0xbe6a96aaa4a46ULL,
+  0xbe91462c95b60ULL, 0xbeb7f908bec8eULL, 0xbedeaf3f6a3c2ULL, 0xbf0568d0e2756ULL,
+  0xbf2c25bd71e09ULL, 0xbf52e60562f02ULL, 0xbf79a9a9001d2ULL, 0xbfa070a893e6cULL,
+  0xbfc73b0468d30ULL, 0xbfee08bcc96e0ULL, 0xc014d9d2004aaULL, 0xc03bae4458020ULL,
+  0xc06286141b33dULL, 0xc089614194863ULL, 0xc0b03fcd0ea5cULL, 0xc0d721b6d445aULL,
+  0xc0fe06ff301f4ULL, 0xc124efa66cf2cULL, 0xc14bdbacd586aULL, 0xc172cb12b4a7dULL,
+  0xc199bdd85529cULL, 0xc1c0b3fe01e67ULL, 0xc1e7ad8405be6ULL, 0xc20eaa6aab985ULL,
+  0xc235aab23e61eULL, 0xc25cae5b090edULL, 0xc283b56556999ULL, 0xc2aabfd172031ULL,
+  0xc2d1cd9fa652cULL, 0xc2f8ded03e967ULL, 0xc31ff36385e29ULL, 0xc3470b59c7521ULL,
+  0xc36e26b34e065ULL, 0xc395457065275ULL, 0xc3bc679157e38ULL, 0xc3e38d16716fcULL,
+  0xc40ab5fffd07aULL, 0xc431e24e45ed2ULL, 0xc45912019768cULL, 0xc480451a3cc98ULL,
+  0xc4a77b9881650ULL, 0xc4ceb57cb0975ULL, 0xc4f5f2c715c31ULL, 0xc51d3377fc517ULL,
+  0xc544778fafb22ULL, 0xc56bbf0e7b5b6ULL, 0xc59309f4aac9fULL, 0xc5ba584289812ULL,
+  0xc5e1a9f8630adULL, 0xc608ff1682f76ULL, 0xc630579d34dddULL, 0xc657b38cc45b9ULL,
+  0xc67f12e57d14bULL, 0xc6a675a7aab3eULL, 0xc6cddbd398ea4ULL, 0xc6f54569936f8ULL,
+  0xc71cb269e601fULL, 0xc74422d4dc667ULL, 0xc76b96aac2686ULL, 0xc7930debe3d9cULL,
+  0xc7ba88988c933ULL, 0xc7e206b10873bULL, 0xc8098835a3611ULL, 0xc8310d26a9479ULL,
+  0xc8589584661a1ULL, 0xc880214f25d1fULL, 0xc8a7b087346f4ULL, 0xc8cf432cddf8bULL,
+  0xc8f6d9406e7b5ULL, 0xc91e72c2320b0ULL, 0xc9460fb274c22ULL, 0xc96db01182c1bULL,
+  0xc99553dfa8313ULL, 0xc9bcfb1d313eeULL, 0xc9e4a5ca6a1f8ULL, 0xca0c53e79f0e7ULL,
+  0xca3405751c4dbULL, 0xca5bba732e25dULL, 0xca8372e220e61ULL, 0xcaab2ec240e43ULL,
+  0xcad2ee13da7cbULL, 0xcafab0d73a12aULL, 0xcb22770cac0f9ULL, 0xcb4a40b47ce3fULL,
+  0xcb720dcef9069ULL, 0xcb99de5c6cf50ULL, 0xcbc1b25d25337ULL, 0xcbe989d16e4cbULL,
+  0xcc1164b994d23ULL, 0xcc394315e55bfULL, 0xcc6124e6ac88bULL, 0xcc890a2c36fddULL,
+  0xccb0f2e6d1675ULL, 0xccd8df16c877cULL, 0xcd00cebc68e87ULL, 0xcd28c1d7ff795ULL,
+  0xcd50b869d8f0fULL, 0xcd78b272421c9ULL, 0xcda0aff187d02ULL, 0xcdc8b0e7f6e61ULL,
+  0xcdf0b555dc3faULL, 0xce18bd3b84c4bULL, 0xce40c8993d63dULL, 0xce68d76f53122ULL,
+  0xce90e9be12cb9ULL, 0xceb8ff85c992aULL, 0xcee118c6c4709ULL, 0xcf09358150754ULL,
+  0xcf3155b5bab74ULL, 0xcf5979645053cULL, 0xcf81a08d5e6ecULL, 0xcfa9cb313232eULL,
+  0xcfd1f95018d17ULL, 0xcffa2aea5f825ULL, 0xd022600053845ULL, 0xd04a9892421ccULL,
+  0xd072d4a07897cULL, 0xd09b142b44480ULL, 0xd0c35732f2870ULL, 0xd0eb9db7d0b4fULL,
+  0xd113e7ba2c38cULL, 0xd13c353a527ffULL, 0xd164863890feeULL, 0xd18cdab535307ULL,
+  0xd1b532b08c968ULL, 0xd1dd8e2ae4b97ULL, 0xd205ed248b287ULL, 0xd22e4f9dcd795ULL,
+  0xd256b596f948cULL, 0xd27f1f105c3a0ULL, 0xd2a78c0a43f72ULL, 0xd2cffc84fe310ULL,
+  0xd2f87080d89f2ULL, 0xd320e7fe20ffaULL, 0xd34962fd2517aULL, 0xd371e17e32b2eULL,
+  0xd39a638197a3cULL, 0xd3c2e907a1c38ULL, 0xd3eb72109ef21ULL, 0xd413fe9cdd164ULL,
+  0xd43c8eacaa1d6ULL, 0xd465224053fbdULL, 0xd48db95828ac7ULL, 0xd4b653f47630fULL,
+  0xd4def2158a91fULL, 0xd50793bbb3de9ULL, 0xd53038e7402ceULL, 0xd558e1987d99aULL,
+  0xd5818dcfba487ULL, 0xd5aa3d8d44639ULL, 0xd5d2f0d16a1c3ULL, 0xd5fba79c79aa1ULL,
+  0xd62461eec14beULL, 0xd64d1fc88f472ULL, 0xd675e12a31e7fULL, 0xd69ea613f7816ULL,
+  0xd6c76e862e6d3ULL, 0xd6f03a81250bfULL, 0xd7190a0529c51ULL, 0xd741dd128b06aULL,
+  0xd76ab3a99745bULL, 0xd7938dca9cfdfULL, 0xd7bc6b75eab1fULL, 0xd7e54cabceeb1ULL,
+  0xd80e316c98398ULL, 0xd83719b895343ULL, 0xd86005901478fULL, 0xd888f4f364ac5ULL,
+  0xd8b1e7e2d479dULL, 0xd8dade5eb2939ULL, 0xd903d8674db2bULL, 0xd92cd5fcf4971ULL,
+  0xd955d71ff6075ULL, 0xd97edbd0a0d11ULL, 0xd9a7e40f43c89ULL, 0xd9d0efdc2dc92ULL,
+  0xd9f9ff37adb4aULL, 0xda23122212740ULL, 0xda4c289baaf6eULL, 0xda7542a4c633eULL,
+  0xda9e603db3285ULL, 0xdac78166c0d87ULL, 0xdaf0a6203e4f5ULL, 0xdb19ce6a7a9eeULL,
+  0xdb42fa45c4dfdULL, 0xdb6c29b26c31dULL, 0xdb955cb0bfbb6ULL, 0xdbbe93410ea9dULL,
+  0xdbe7cd63a8315ULL, 0xdc110b18db8cfULL, 0xdc3a4c60f7feaULL, 0xdc63913c4ccf3ULL,
+  0xdc8cd9ab294e4ULL, 0xdcb625addcd27ULL, 0xdcdf7544b6b92ULL, 0xdd08c87006669ULL,
+  0xdd321f301b460ULL, 0xdd5b798544c98ULL, 0xdd84d76fd269eULL, 0xddae38f013a72ULL,
+  0xddd79e065807dULL, 0xde0106b2ef19bULL, 0xde2a72f628712ULL, 0xde53e2d053a9aULL,
+  0xde7d5641c0658ULL, 0xdea6cd4abe4ddULL, 0xded047eb9d12dULL, 0xdef9c624ac6b6ULL,
+  0xdf2347f63c159ULL, 0xdf4ccd609bd61ULL, 0xdf7656641b78cULL, 0xdf9fe3010ad03ULL,
+  0xdfc97337b9b5fULL, 0xdff30708780a8ULL, 0xe01c9e7395b56ULL, 0xe046397962a4cULL,
+  0xe06fd81a2ece1ULL, 0xe0997a564a2d6ULL, 0xe0c3202e04c5dULL, 0xe0ecc9a1aea18ULL,
+  0xe11676b197d17ULL, 0xe140275e106d8ULL, 0xe169dba768949ULL, 0xe193938df06c8ULL,
+  0xe1bd4f11f8220ULL, 0xe1e70e33cfe8dULL, 0xe210d0f3c7fbaULL, 0xe23a9752309c0ULL,
+  0xe264614f5a129ULL, 0xe28e2eeb94aecULL, 0xe2b8002730c71ULL, 0xe2e1d5027eb91ULL,
+  0xe30bad7dcee90ULL, 0xe335899971c26ULL, 0xe35f6955b7b78ULL, 0xe3894cb2f141aULL,
+  0xe3b333b16ee12ULL, 0xe3dd1e51811d3ULL, 0xe4070c9378842ULL, 0xe430fe77a5ab3ULL,
+  0xe45af3fe592e8ULL, 0xe484ed27e3b15ULL, 0xe4aee9f495ddcULL, 0xe4d8ea64c0651ULL,
+  0xe502ee78b3ff6ULL, 0xe52cf630c16beULL, 0xe557018d3970bULL, 0xe581108e6cdafULL,
+  0xe5ab2334ac7eeULL, 0xe5d539804937aULL, 0xe5ff537193e75ULL, 0xe6297108dd773ULL,
+  0xe653924676d76ULL, 0xe67db72ab0ff2ULL, 0xe6a7dfb5dcecaULL, 0xe6d20be84ba53ULL,
+  0xe6fc3bc24e350ULL, 0xe7266f4435af7ULL, 0xe750a66e532ebULL, 0xe77ae140f7d42ULL,
+  0xe7a51fbc74c83ULL, 0xe7cf61e11b3a4ULL, 0xe7f9a7af3c60bULL, 0xe823f12729791ULL,
+  0xe84e3e4933c7eULL, 0xe8788f15ac98aULL, 0xe8a2e38ce53dfULL, 0xe8cd3baf2f118ULL,
+  0xe8f7977cdb740ULL, 0xe921f6f63bcd2ULL, 0xe94c5a1ba18bdULL, 0xe976c0ed5e25dULL,
+  0xe9a12b6bc3181ULL, 0xe9cb999721e6aULL, 0xe9f60b6fcc1c7ULL, 0xea2080f6134bcULL,
+  0xea4afa2a490daULL, 0xea75770cbf025ULL, 0xea9ff79dc6d14ULL, 0xeaca7bddb228cULL,
+  0xeaf503ccd2be5ULL, 0xeb1f8f6b7a4e9ULL, 0xeb4a1eb9fa9d1ULL, 0xeb74b1b8a5749ULL,
+  0xeb9f4867cca6eULL, 0xebc9e2c7c20d0ULL, 0xebf480d8d786dULL, 0xec1f229b5efb8ULL,
+  0xec49c80faa594ULL, 0xec7471360b955ULL, 0xec9f1e0ed4ac2ULL, 0xecc9ce9a57a12ULL,
+  0xecf482d8e67f1ULL, 0xed1f3acad3578ULL, 0xed49f67070435ULL, 0xed74b5ca0f628ULL,
+  0xed9f78d802dc2ULL, 0xedca3f9a9cde5ULL, 0xedf50a122f9e6ULL, 0xee1fd83f0d58cULL,
+  0xee4aaa2188510ULL, 0xee757fb9f2d1dULL, 0xeea059089f2d0ULL, 0xeecb360ddfbb8ULL,
+  0xeef616ca06dd6ULL, 0xef20fb3d66f9eULL, 0xef4be368527f6ULL, 0xef76cf4b1be36ULL,
+  0xefa1bee615a27ULL, 0xefccb23992408ULL, 0xeff7a945e4487ULL, 0xf022a40b5e4c6ULL,
+  0xf04da28a52e59ULL, 0xf078a4c314b47ULL, 0xf0a3aab5f6609ULL, 0xf0ceb4634a98aULL,
+  0xf0f9c1cb6412aULL, 0xf124d2ee958b9ULL, 0xf14fe7cd31c7bULL, 0xf17b00678b927ULL,
+  0xf1a61cbdf5be7ULL, 0xf1d13cd0c3256ULL, 0xf1fc60a046a84ULL, 0xf227882cd32f3ULL,
+  0xf252b376bba97ULL, 0xf27de27e530daULL, 0xf2a91543ec595ULL, 0xf2d44bc7da917ULL,
+  0xf2ff860a70c22ULL, 0xf32ac40c01fe8ULL, 0xf35605cce1613ULL, 0xf3814b4d620bdULL,
+  0xf3ac948dd7274ULL, 0xf3d7e18e93e39ULL, 0xf403324feb781ULL, 0xf42e86d231233ULL,
+  0xf459df15b82acULL, 0xf4853b1ad3dbbULL, 0xf4b09ae1d78a1ULL, 0xf4dbfe6b16915ULL,
+  0xf50765b6e4540ULL, 0xf532d0c5943c0ULL, 0xf55e3f9779ba5ULL, 0xf589b22ce8474ULL,
+  0xf5b5288633625ULL, 0xf5e0a2a3ae925ULL, 0xf60c2085ad652ULL, 0xf637a22c83701ULL,
+  0xf6632798844f8ULL, 0xf68eb0ca03a75ULL, 0xf6ba3dc155226ULL, 0xf6e5ce7ecc72fULL,
+  0xf7116302bd526ULL, 0xf73cfb4d7b819ULL, 0xf768975f5ac86ULL, 0xf7943738aef61ULL,
+  0xf7bfdad9cbe14ULL, 0xf7eb824305679ULL, 0xf8172d74af6e1ULL, 0xf842dc6f1de12ULL,
+  0xf86e8f32a4b45ULL, 0xf89a45bf97e28ULL, 0xf8c600164b6dcULL, 0xf8f1be37135f9ULL,
+  0xf91d802243c89ULL, 0xf94945d830c0cULL, 0xf9750f592e677ULL, 0xf9a0dca590e33ULL,
+  0xf9ccadbdac61dULL, 0xf9f882a1d5187ULL, 0xfa245b525f439ULL, 0xfa5037cf9f26eULL,
+  0xfa7c1819e90d8ULL, 0xfaa7fc319149cULL, 0xfad3e416ec354ULL, 0xfaffcfca4e310ULL,
+  0xfb2bbf4c0ba54ULL, 0xfb57b29c7901aULL, 0xfb83a9bbeabd1ULL, 0xfbafa4aab555cULL,
+  0xfbdba3692d514ULL, 0xfc07a5f7a73c7ULL, 0xfc33ac5677ab8ULL, 0xfc5fb685f33a0ULL,
+  0xfc8bc4866e8adULL, 0xfcb7d6583e482ULL, 0xfce3ebfbb7237ULL, 0xfd1005712dd5bULL,
+  0xfd3c22b8f71f1ULL, 0xfd6843d367c72ULL, 0xfd9468c0d49ccULL, 0xfdc0918192765ULL,
+  0xfdecbe15f6314ULL, 0xfe18ee7e54b2bULL, 0xfe4522bb02e6eULL, 0xfe715acc55c18ULL,
+  0xfe9d96b2a23d9ULL, 0xfec9d66e3d5d9ULL, 0xfef619ff7c2b3ULL, 0xff226166b3b7aULL,
+  0xff4eaca4391b6ULL, 0xff7afbb861765ULL, 0xffa74ea381efcULL, 0xffd3a565efb65ULL
+};
+
+typedef union {
+	double d;
+	unsigned long long i;
+} di_t;
+
+// x - k * hi - k * lo without -ffast-math turning it into x - k * (hi + lo).
+static inline double cody_waite_d(double x, double k, double hi, double lo)
+{
+	double r = x - k * hi;
+#if defined(__SSE2__)
+	__asm__("" : "+x"(r));
+#elif defined(__aarch64__)
+	__asm__("" : "+w"(r));
+#else
+	__asm__("" : "+m"(r));
+#endif
+	return r - k * lo;
+}
+
+// Constants as bits, so they survive -fsingle-precision-constant(the module
+// CFLAGS).
+static inline double d_bits(unsigned long long i)
+{
+	di_t di;
+	di.i = i;
+	return di.d;
+}
+
+double fmath_exp_d(double x)
+{
+	const int s = FMATH_EXP_D_TABLE_SIZE;
+	const double a = d_bits(0x40a71547652b82feULL);  // 2048 / ln2
+	const double hi = d_bits(0x3f362e42fee00000ULL); // ln2 / 2048, upper
+	const double lo = d_bits(0x3d3a39ef35793c76ULL); // bits and the rest
+	const double c3 = d_bits(0x3fc5555555555555ULL); // 1 / 6
+	const double x_min = d_bits(0xc086232bdd7abcd2ULL); // ln(DBL_MIN)
+	const double x_max = d_bits(0x40862e42fefa39efULL); // ln(DBL_MAX)
+	const double exp_c = d_bits(0x3ffff1c02e22a540ULL); // exp(0.69140625)
+	const double magic = 6755399441055744.0; // 3 * 2^51, to round
+	const unsigned long long magic_bits = 0x4338000000000000ULL;
+	di_t bx, di;
+	long long k;
+	double xr, r, p;
+
+	bx.d = x;
+
+	xr = (x < x_min) ? x_min : x;
+	xr = (xr > x_max) ? x_max : xr;
+	xr = (xr > 709.0) ? xr - 0.69140625 : xr;
+
+	di.d = xr * a + magic;
+	k = (long long)(di.i - magic_bits);
+	r = cody_waite_d(xr, (double)k, hi, lo);
+	p = 1.0 + r * (1.0 + r * (0.5 + r * c3));
+
+	di.i = (unsigned long long)((k + (1023LL << s)) >> s) << 52;
+	di.i |= kFmathExpTableD[k & ((1 << s) - 1)];
+	di.d *= p;
+
+	di.d *= ((long long)bx.i > 0x4086280000000000LL) ? exp_c : 1.0; // 709.0
+	di.i = ((long long)bx.i > 0x40862e42fefa39efLL) ? 0x7ff0000000000000ULL
+							 : di.i; // x_max
+	di.i = (bx.i > 0xc086232bdd7abcd2ULL) ? 0 : di.i; // x_min
+	di.i = ((bx.i & 0x7fffffffffffffffULL) > 0x7ff0000000000000ULL)
+		       ? (bx.i | 0x0008000000000000ULL)
+		       : di.i; // NaN
+	return di.d;
+}
+
+void fmath_exp_d_n(double *RESTRICT y, const double *RESTRICT x, int n)
+{
+	int i;
+
+	for (i = 0; i < n; i++) {
+		y[i] = fmath_exp_d(x[i]);
+	}
+}
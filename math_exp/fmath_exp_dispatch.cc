@@ -0,0 +1,28 @@
+//
+// exp() over arrays, dispatched at compile time to the kernel and unroll
+// width `make tune` found fastest on the target for each accuracy tier.
+// The host shim build takes its own `make tune_shim` picks, so host timings
+// never reach the e-core build.
+//
+#include "fmath_exp.hpp"
+#ifdef __epiphany__
+#include "fmath_exp_tuned.h"
+#else
+#include "fmath_exp_tuned_shim.h"
+#endif
+
+#if (FMATH_EXP_TUNED_TABLE_SIZE != FMATH_EXP_TABLE_SIZE)
+#warning "fmath_exp_tuned.h was generated for another table size, re-run make tune"
+#endif
+
+extern "C" void exp_fast_n(float *RESTRICT y, const float *RESTRICT x, int n)
+{
+	fmath::kernel_n<FMATH_EXP_FAST_KERNEL, FMATH_EXP_FAST_WIDTH>(y, x, n);
+}
+
+extern "C" void exp_accurate_n(float *RESTRICT y, const float *RESTRICT x,
+			       int n)
+{
+	fmath::kernel_n<FMATH_EXP_ACCURATE_KERNEL, FMATH_EXP_ACCURATE_WIDTH>(
+		y, x, n);
+}
@@ -0,0 +1,11 @@
+//
+// Host CPU exp() over arrays, for splitting exp batches between the host and
+// the e-cores(host_sched.c). Table-free(fmath::PolyExp<5>, 2.2e-7 max rel.
+// diff) and 8 wide, which the compiler maps onto NEON/SSE.
+//
+#include "fmath_exp.hpp"
+
+extern "C" void exp_host_n(float *RESTRICT y, const float *RESTRICT x, int n)
+{
+	fmath::kernel_n<FMATH_EXP_KERNEL_POLY(5), 8>(y, x, n);
+}
@@ -0,0 +1,26 @@
+//
+// Generated by `fmath_exp_remez 3 6`. Do not edit.
+//
+// Minimax(relative error) coefficients of exp(r) on [-ln2/2, ln2/2],
+// kFmathExpPoly[degree][i] is the coefficient of r^i.
+//
+#ifndef FMATH_EXP_POLY_H_
+#define FMATH_EXP_POLY_H_
+
+#define FMATH_EXP_POLY_MAX_DEGREE (6)
+
+static const float kFmathExpPoly[7][7] = {
+  {0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f},
+  {0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f},
+  {0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f},
+  // degree 3: max rel. err = 7.478e-05(7.480e-05 with float coefficients)
+  {9.999280572e-01f, 1.000164151e+00f, 5.049632788e-01f, 1.656684279e-01f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f},
+  // degree 4: max rel. err = 2.593e-06(2.625e-06 with float coefficients)
+  {9.999992847e-01f, 9.999634027e-01f, 5.000435710e-01f, 1.679090708e-01f, 4.145860672e-02f, 0.000000000e+00f, 0.000000000e+00f},
+  // degree 5: max rel. err = 7.494e-08(1.347e-07 with float coefficients)
+  {1.000000119e+00f, 9.999997020e-01f, 4.999889433e-01f, 1.666757464e-01f, 4.191538319e-02f, 8.297654800e-03f, 0.000000000e+00f},
+  // degree 6: max rel. err = 1.856e-09(1.735e-08 with float coefficients)
+  {1.000000000e+00f, 1.000000000e+00f, 4.999999106e-01f, 1.666641980e-01f, 4.166822508e-02f, 8.374815807e-03f, 1.383684576e-03f}
+};
+
+#endif // FMATH_EXP_POLY_H_
@@ -0,0 +1,234 @@
+//
+// Minimax(relative error) polynomial fit of exp(r) on [-ln2/2, ln2/2] with the
+// Remez exchange algorithm. Emits fmath_exp_poly.h for fmath::PolyExp<>.
+//
+//   gcc -O2 fmath_exp_remez.c -o fmath_exp_remez -lm
+//   ./fmath_exp_remez 3 6 > fmath_exp_poly.h
+//
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define REMEZ_MAX_DEGREE (6)
+#define REMEZ_MAX_POINTS (REMEZ_MAX_DEGREE + 2)
+#define REMEZ_GRID (8192)
+#define REMEZ_MAX_ITER (32)
+
+static double poly_eval(const double *c, int degree, double x)
+{
+	double p = c[degree];
+	int j;
+
+	for (j = degree - 1; j >= 0; j--) {
+		p = p * x + c[j];
+	}
+	return p;
+}
+
+static double rel_err(const double *c, int degree, double x)
+{
+	return poly_eval(c, degree, x) / exp(x) - 1.0;
+}
+
+// Solves a[n][n + 1](augmented) in place, partial pivoting.
+static int solve(double a[REMEZ_MAX_POINTS][REMEZ_MAX_POINTS + 1], int n,
+		 double *x)
+{
+	int i, j, k;
+
+	for (k = 0; k < n; k++) {
+		int p = k;
+		for (i = k + 1; i < n; i++) {
+			if (fabs(a[i][k]) > fabs(a[p][k])) {
+				p = i;
+			}
+		}
+		if (fabs(a[p][k]) < 1.0e-300) {
+			return -1;
+		}
+		for (j = 0; j <= n; j++) {
+			double t = a[k][j];
+			a[k][j] = a[p][j];
+			a[p][j] = t;
+		}
+		for (i = k + 1; i < n; i++) {
+			double f = a[i][k] / a[k][k];
+			for (j = k; j <= n; j++) {
+				a[i][j] -= f * a[k][j];
+			}
+		}
+	}
+	for (k = n - 1; k >= 0; k--) {
+		double s = a[k][n];
+		for (j = k + 1; j < n; j++) {
+			s -= a[k][j] * x[j];
+		}
+		x[k] = s / a[k][k];
+	}
+	return 0;
+}
+
+// New reference: the extremum of every run of equal error sign on a dense
+// grid. Returns the number of points found, n is wanted.
+static int find_extrema(const double *c, int degree, double lo, double hi,
+			double *pts, int n)
+{
+	double ext[REMEZ_GRID + 1];
+	int count = 0;
+	double best_x = lo, best_e = rel_err(c, degree, lo);
+	int i;
+
+	for (i = 1; i <= REMEZ_GRID; i++) {
+		double x = lo + (hi - lo) * i / REMEZ_GRID;
+		double e = rel_err(c, degree, x);
+		if ((e > 0.0) != (best_e > 0.0)) {
+			ext[count++] = best_x;
+			best_x = x;
+			best_e = e;
+		} else if (fabs(e) > fabs(best_e)) {
+			best_x = x;
+			best_e = e;
+		}
+	}
+	ext[count++] = best_x;
+
+	// Too many sign changes: drop the smaller end until n remain.
+	{
+		int first = 0, last = count - 1;
+		while (last - first + 1 > n) {
+			if (fabs(rel_err(c, degree, ext[first])) <
+			    fabs(rel_err(c, degree, ext[last]))) {
+				first++;
+			} else {
+				last--;
+			}
+		}
+		for (i = first; i <= last; i++) {
+			pts[i - first] = ext[i];
+		}
+		return last - first + 1;
+	}
+}
+
+// Returns max. rel. error of the fit, coefficients in c[0..degree].
+static double remez(int degree, double lo, double hi, double *c)
+{
+	const int n = degree + 2;
+	double pts[REMEZ_MAX_POINTS];
+	double sol[REMEZ_MAX_POINTS];
+	double max_err = 0.0;
+	int iter, i, j;
+
+	for (i = 0; i < n; i++) {
+		pts[i] = 0.5 * (lo + hi) -
+			 0.5 * (hi - lo) * cos(M_PI * i / (double)(n - 1));
+	}
+
+	for (iter = 0; iter < REMEZ_MAX_ITER; iter++) {
+		double a[REMEZ_MAX_POINTS][REMEZ_MAX_POINTS + 1];
+		double min_err;
+
+		// p(x_i) - (-1)^i E exp(x_i) = exp(x_i)
+		for (i = 0; i < n; i++) {
+			double xp = 1.0;
+			for (j = 0; j <= degree; j++) {
+				a[i][j] = xp;
+				xp *= pts[i];
+			}
+			a[i][degree + 1] = ((i & 1) ? 1.0 : -1.0) * exp(pts[i]);
+			a[i][n] = exp(pts[i]);
+		}
+		if (solve(a, n, sol) != 0) {
+			break;
+		}
+		for (j = 0; j <= degree; j++) {
+			c[j] = sol[j];
+		}
+
+		if (find_extrema(c, degree, lo, hi, pts, n) != n) {
+			break;
+		}
+		max_err = 0.0;
+		min_err = HUGE_VAL;
+		for (i = 0; i < n; i++) {
+			double e = fabs(rel_err(c, degree, pts[i]));
+			max_err = (e > max_err) ? e : max_err;
+			min_err = (e < min_err) ? e : min_err;
+		}
+		if ((max_err - min_err) < 1.0e-6 * max_err) {
+			break;
+		}
+	}
+
+	return max_err;
+}
+
+// Error with the coefficients rounded to float, still evaluated in double.
+static double float_coeff_err(const double *c, int degree, double lo, double hi)
+{
+	double cf[REMEZ_MAX_DEGREE + 1];
+	double max_err = 0.0;
+	int i;
+
+	for (i = 0; i <= degree; i++) {
+		cf[i] = (float)c[i];
+	}
+	for (i = 0; i <= REMEZ_GRID; i++) {
+		double e = fabs(rel_err(cf, degree, lo + (hi - lo) * i / REMEZ_GRID));
+		max_err = (e > max_err) ? e : max_err;
+	}
+	return max_err;
+}
+
+// Usage: fmath_exp_remez [minDegree] [maxDegree]
+int main(int argc, char **argv)
+{
+	const double hi = 0.5 * log(2.0);
+	const double lo = -hi;
+	int minDegree = 3;
+	int maxDegree = REMEZ_MAX_DEGREE;
+	int d, j;
+
+	if (argc > 1) {
+		minDegree = atoi(argv[1]);
+	}
+	if (argc > 2) {
+		maxDegree = atoi(argv[2]);
+	}
+	minDegree = (minDegree < 1) ? 1 : minDegree;
+	maxDegree = (maxDegree > REMEZ_MAX_DEGREE) ? REMEZ_MAX_DEGREE : maxDegree;
+
+	printf("//\n");
+	printf("// Generated by `fmath_exp_remez %d %d`. Do not edit.\n", minDegree,
+	       maxDegree);
+	printf("//\n");
+	printf("// Minimax(relative error) coefficients of exp(r) on [-ln2/2, "
+	       "ln2/2],\n");
+	printf("// kFmathExpPoly[degree][i] is the coefficient of r^i.\n");
+	printf("//\n");
+	printf("#ifndef FMATH_EXP_POLY_H_\n");
+	printf("#define FMATH_EXP_POLY_H_\n\n");
+	printf("#define FMATH_EXP_POLY_MAX_DEGREE (%d)\n\n", REMEZ_MAX_DEGREE);
+	printf("static const float kFmathExpPoly[%d][%d] = {\n",
+	       REMEZ_MAX_DEGREE + 1, REMEZ_MAX_DEGREE + 1);
+	for (d = 0; d <= REMEZ_MAX_DEGREE; d++) {
+		double c[REMEZ_MAX_DEGREE + 1] = {0.0};
+
+		if ((d >= minDegree) && (d <= maxDegree)) {
+			double err = remez(d, lo, hi, c);
+			printf("  // degree %d: max rel. err = %.3e(%.3e with "
+			       "float coefficients)\n",
+			       d, err, float_coeff_err(c, d, lo, hi));
+		}
+		printf("  {");
+		for (j = 0; j <= REMEZ_MAX_DEGREE; j++) {
+			printf("%.9ef%s", (float)c[j],
+			       (j != REMEZ_MAX_DEGREE) ? ", " : "");
+		}
+		printf("}%s\n", (d != REMEZ_MAX_DEGREE) ? "," : "");
+	}
+	printf("};\n\n");
+	printf("#endif // FMATH_EXP_POLY_H_\n");
+
+	return 0;
+}
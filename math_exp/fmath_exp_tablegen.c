@@ -3,6 +3,7 @@
 //
 #include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 // base on fmath::exp https://github.com/herumi/fmath/blob/master/fmath.hpp
 
@@ -42,17 +43,89 @@ void fmath_exp_gentable(int tableSize) {
 	printf("};\n");
 }
 
+// Fraction table for fmath_exp_i(): 2^(i / (n * m)), n = 1 << tableSize,
+// m = 1 << fracBits, stored as float bits since it is used as a multiplier.
+void fmath_exp_gen_frac_table(int tableSize, int fracBits) {
+
+	const int n = 1 << tableSize;
+	const int m = 1 << fracBits;
+	int i = 0;
+
+	printf("const unsigned int kFmathExpFracTable[%d] = {\n  ", m);
+
+	for (i = 0; i < m; i++) {
+		float y = pow(2.0, (double)i / ((double)n * m));
+		fi fi;
+		fi.f = y;
+
+		printf("0x%08x", fi.i);
+		if (i != (m-1)) printf(", ");
+		if ((i != 0) && (i % 4 == 3)) {
+			printf("\n");
+			if (i != (m-1)) {
+				printf("  ");
+			}
+		}
+
+	}
+	printf("};\n");
+}
+
+// Double table for fmath_exp_d(): 52 bit mantissas of 2^(i / n).
+void fmath_exp_gentable_d(int tableSize) {
+
+	const int n = 1 << tableSize;
+	int i = 0;
+
+	printf("static const unsigned long long kFmathExpTableD[%d] = {\n  ", n);
+
+	for (i = 0; i < n; i++) {
+		union {
+			double d;
+			unsigned long long i;
+		} di;
+		di.d = pow(2.0, (double)i / n);
+
+		printf("0x%013llxULL", di.i & ((1ULL << 52) - 1));
+		if (i != (n-1)) printf(", ");
+		if ((i != 0) && (i % 4 == 3)) {
+			printf("\n");
+			if (i != (n-1)) {
+				printf("  ");
+			}
+		}
+
+	}
+	printf("};\n");
+}
+
+// Usage: fmath_exp_tablegen [tableSize] [fracBits]
+//        fmath_exp_tablegen d [tableSize]
+//   fracBits > 0 emits kFmathExpFracTable for fmath_exp_i() instead.
+//   d emits kFmathExpTableD for fmath_exp_d().
 int main(int argc, char** argv)
 {
 	int tableSize = 10;
+	int fracBits = 0;
+	if ((argc > 1) && (argv[1][0] == 'd')) {
+		fmath_exp_gentable_d((argc > 2) ? atoi(argv[2]) : 11);
+		return 0;
+	}
 	if (argc > 1) {
 		tableSize = atoi(argv[1]);
 	}
+	if (argc > 2) {
+		fracBits = atoi(argv[2]);
+	}
 
 	if (tableSize > (1 << 14)) {
 		tableSize = (1 << 14);
 	}
 
-	fmath_exp_gentable(tableSize);
+	if (fracBits > 0) {
+		fmath_exp_gen_frac_table(tableSize, fracBits);
+	} else {
+		fmath_exp_gentable(tableSize);
+	}
 } 
 
@@ -0,0 +1,21 @@
+#ifndef FMATH_EXP_TUNED_H_
+#define FMATH_EXP_TUNED_H_
+//
+// Default for the e-core from the cycle table in e_fast_exp.c(table size 7,
+// measured by hand over [-30, 30]). Regenerate on the board with `make tune`.
+// The host shim build uses fmath_exp_tuned_shim.h(`make tune_shim`).
+//
+//   expapprox      x4    32.00 clocks/elem, max rel. diff 767 e-8
+//   fmath          x4    18.00 clocks/elem, max rel. diff 377 e-8
+//
+#define FMATH_EXP_TUNED_TARGET "epiphany"
+#define FMATH_EXP_TUNED_TABLE_SIZE (7)
+
+// fast: fmath          x4    18.00 clocks/elem, max rel. diff 377 e-8
+#define FMATH_EXP_FAST_KERNEL (0)
+#define FMATH_EXP_FAST_WIDTH (4)
+// accurate: fmath          x4    18.00 clocks/elem, max rel. diff 377 e-8
+#define FMATH_EXP_ACCURATE_KERNEL (0)
+#define FMATH_EXP_ACCURATE_WIDTH (4)
+
+#endif // FMATH_EXP_TUNED_H_
@@ -0,0 +1,32 @@
+#ifndef FMATH_EXP_TUNED_SHIM_H_
+#define FMATH_EXP_TUNED_SHIM_H_
+//
+// Generated by e_fmath_exp_tune.cc(make tune_shim) on x86_64.
+//
+//   expapprox      x1     1.57 clocks/elem, max rel. diff 1147 e-8
+//   expapprox      x4     0.47 clocks/elem, max rel. diff 1147 e-8
+//   fmath          x1     1.28 clocks/elem, max rel. diff 706 e-8
+//   fmath          x2     1.16 clocks/elem, max rel. diff 706 e-8
+//   fmath          x4     1.21 clocks/elem, max rel. diff 706 e-8
+//   fmath          x8     1.21 clocks/elem, max rel. diff 706 e-8
+//   fmath          x16    1.14 clocks/elem, max rel. diff 706 e-8
+//   poly3          x4     1.81 clocks/elem, max rel. diff 7485 e-8
+//   poly3          x8     1.62 clocks/elem, max rel. diff 7485 e-8
+//   poly4          x4     1.98 clocks/elem, max rel. diff 286 e-8
+//   poly4          x8     1.78 clocks/elem, max rel. diff 286 e-8
+//   poly5          x4     2.14 clocks/elem, max rel. diff 18 e-8
+//   poly5          x8     1.92 clocks/elem, max rel. diff 18 e-8
+//   poly6          x4     2.35 clocks/elem, max rel. diff 25 e-8
+//   poly6          x8     2.05 clocks/elem, max rel. diff 25 e-8
+//
+#define FMATH_EXP_TUNED_TARGET "x86_64"
+#define FMATH_EXP_TUNED_TABLE_SIZE (7)
+
+// fast: fmath          x16    1.14 clocks/elem, max rel. diff 706 e-8
+#define FMATH_EXP_FAST_KERNEL (0)
+#define FMATH_EXP_FAST_WIDTH (16)
+// accurate: poly4          x8     1.78 clocks/elem, max rel. diff 286 e-8
+#define FMATH_EXP_ACCURATE_KERNEL (14)
+#define FMATH_EXP_ACCURATE_WIDTH (8)
+
+#endif // FMATH_EXP_TUNED_SHIM_H_
@@ -0,0 +1,65 @@
+//
+// IEEE half precision <-> float, integer ops plus one float add/sub, no
+// denormal float operands(e-core FPU and -ffast-math hosts flush them).
+//
+// based on https://gist.github.com/rygorous/2156668
+//
+#ifndef FP16_H_
+#define FP16_H_
+
+typedef unsigned short fp16_t;
+
+typedef union {
+	float f;
+	unsigned int i;
+} fp16_fi_t;
+
+static inline float fp16_to_float(fp16_t h)
+{
+	const unsigned int shifted_exp = 0x7c00 << 13; // exponent mask after shift
+	fp16_fi_t magic, o;
+	unsigned int exp;
+
+	magic.i = 113 << 23; // 2^-14
+	o.i = (h & 0x7fff) << 13;
+	exp = o.i & shifted_exp;
+	o.i += (127 - 15) << 23; // rebias
+
+	if (exp == shifted_exp) { // inf/NaN
+		o.i += (128 - 16) << 23;
+	} else if (exp == 0) { // zero/subnormal, renormalize
+		o.i += 1 << 23;
+		o.f -= magic.f;
+	}
+
+	o.i |= (h & 0x8000) << 16;
+	return o.f;
+}
+
+// Round to nearest even. Overflow -> inf, NaN -> quiet NaN.
+static inline fp16_t fp16_from_float(float f)
+{
+	fp16_fi_t in, denorm_magic;
+	unsigned int sign, a;
+
+	in.f = f;
+	sign = (in.i >> 16) & 0x8000;
+	a = in.i & 0x7fffffff;
+
+	if (a >= ((127 + 16) << 23)) { // >= 65536, inf or NaN
+		return sign | ((a > 0x7f800000) ? 0x7e00 : 0x7c00);
+	}
+	if (a < ((127 - 14) << 23)) { // half subnormal or zero
+		fp16_fi_t t;
+		denorm_magic.i = ((127 - 15) + (23 - 10) + 1) << 23;
+		t.i = a;
+		t.f += denorm_magic.f;
+		return sign | (t.i - denorm_magic.i);
+	}
+
+	// rebias exponent, round to nearest even
+	a += ((unsigned int)(15 - 127) << 23) + 0xfff + ((a >> 13) & 1);
+	return sign | (a >> 13);
+}
+
+#endif // FP16_H_
@@ -24,13 +24,17 @@ along with this program, see the file COPYING. If not, see
 // to each core on the chip and read results from the mailbox
 // in each core.
 
+#include <math.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 
 #include <e-hal.h>
 
+#include "fast_exp.h"
+
 #define _BufSize (4096)
 #define _BufOffset (0x01000000)
 
@@ -38,10 +42,62 @@ along with this program, see the file COPYING. If not, see
 #define WAIT_MICROSECONDS (100000)
 #endif
 
+// A core sets mailbox[0] to 1 when it is done. It is polled every
+// WAIT_POLL_USEC for at most WAIT_TIMEOUT_USEC(`make tune` takes seconds).
+#define WAIT_POLL_USEC (1000)
+#define WAIT_TIMEOUT_USEC (60e6)
+
+#define EXP_D_N (1 << 16)
+#define EXP_D_REPEAT (16)
+
+static double now_usec(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec * 1e-3;
+}
+
+// Host side double precision exp(fmath_exp_d.c) against libm exp().
+static void bench_exp_d(void)
+{
+	static double x[EXP_D_N], y[EXP_D_N], ref[EXP_D_N];
+	double t0, t_fmath, t_libm, max_diff = 0.0;
+	int i, r;
+
+	for (i = 0; i < EXP_D_N; i++) {
+		x[i] = -700.0 + 1400.0 * (double)i / EXP_D_N;
+	}
+
+	t0 = now_usec();
+	for (r = 0; r < EXP_D_REPEAT; r++) {
+		fmath_exp_d_n(y, x, EXP_D_N);
+	}
+	t_fmath = now_usec() - t0;
+
+	t0 = now_usec();
+	for (r = 0; r < EXP_D_REPEAT; r++) {
+		for (i = 0; i < EXP_D_N; i++) {
+			ref[i] = exp(x[i]);
+		}
+	}
+	t_libm = now_usec() - t0;
+
+	for (i = 0; i < EXP_D_N; i++) {
+		double diff = fabs(y[i] - ref[i]) / ref[i];
+		max_diff = (diff > max_diff) ? diff : max_diff;
+	}
+
+	fprintf(stderr, "[exp_d] [-700, 700] max rel. diff = %e, %.1f Mexp/s"
+			"(libm exp(): %.1f Mexp/s)\n",
+		max_diff, (double)EXP_D_N * EXP_D_REPEAT / t_fmath,
+		(double)EXP_D_N * EXP_D_REPEAT / t_libm);
+}
+
 int main(int argc, char *argv[])
 {
 	unsigned row, col, coreid, i, j, m, n, k, flag;
 	unsigned int mask0, mask1;
+	double t_start;
 	e_platform_t platform;
 	e_epiphany_t dev;
 	e_mem_t emem;
@@ -71,9 +127,10 @@ int main(int argc, char *argv[])
 	// platform.cols,
 	// E_FALSE);
 
-	// To test
-	e_load_group("e_fast_exp_test.srec", &dev, 0, 0, platform.rows,
-		     platform.cols, E_FALSE);
+	// To test. Optionally pass another build of the test program,
+	// e.g. one built with different bank placement.
+	e_load_group((argc > 1) ? argv[1] : "e_fast_exp_test.srec", &dev, 0, 0,
+		     platform.rows, platform.cols, E_FALSE);
 
 	for (i = 0; i < platform.rows; i++) {
 		for (j = 0; j < platform.cols; j++) {
@@ -85,14 +142,21 @@ int main(int argc, char *argv[])
 			// fprintf(stderr,"%3d: Message from eCore 0x%03x
 			// (%2d,%2d) :
 			// \n",(i*platform.cols+j),coreid,row,col);
+			memset(result, 0, sizeof(result));
+			e_write(&dev, i, j, 0x6000, result, sizeof(result));
 			e_start(&dev, i, j);
-			usleep(WAIT_MICROSECONDS); // Wait enough time.
 
-			// Wait for core program execution to finish
-			// Read message from shared buffer
+			// Wait for core program execution to finish(mailbox[0]
+			// set), then read message from shared buffer
+			t_start = now_usec();
+			do {
+				usleep(WAIT_POLL_USEC);
+				e_read(&dev, i, j, 0x6000, result,
+				       sizeof(result));
+			} while ((result[0] != 1) &&
+				 (now_usec() - t_start < WAIT_TIMEOUT_USEC));
 
 			e_read(&emem, 0, 0, 0x0, emsg, _BufSize);
-			e_read(&dev, i, j, 0x6000, result, sizeof(result));
 
 			// Print the message and close the workgroup.
 			// if(flag == 1)
@@ -126,5 +190,7 @@ int main(int argc, char *argv[])
 	e_free(&emem);
 	e_finalize();
 
+	bench_exp_d();
+
 	return 0;
 }
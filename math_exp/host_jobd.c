@@ -0,0 +1,534 @@
+//
+// Exp job daemon on top of the host runtime(../common/e_rt.h).
+//
+// Keeps the persistent exp kernel(e_exp_server.c) loaded and serves
+// JOBD_EXP requests from any number of local processes(jobd.h). Each
+// client hands over a memfd once, requests only name offsets in it.
+//
+// Small requests are coalesced: pending requests are gathered back to back
+// into the staging buffer of an idle core and go out as one E_CMD_EXP, either
+// once `-b` floats are pending or once the oldest one has waited `-w` us.
+// `-n` posts every request on its own for comparison. The gather into shared
+// DRAM is the only copy of the input: e-cores can't reach the client's
+// memfd, and the copy replaces the per-request post anyway. Outputs are
+// scattered straight into the client's memfd.
+//
+// On JOBD_SHUTDOWN or SIGINT it drains what is queued, prints request count,
+// batch sizes, queueing/total latency and throughput, and leaves the cores
+// parked so the next start is warm.
+//
+//   ./test_jobd [-w usec] [-b floats] [-n] [socket]
+//
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "e_arena.h"
+#include "e_rt.h"
+#include "jobd.h"
+
+#define IMAGE "e_exp_server.srec"
+#define MAX_PENDING (4096)
+#define BATCH_MAX_REQS (64)
+#define BATCH_MAX_FLOATS (4 * JOBD_MAX_COUNT) // per core staging buffer
+#define DEFAULT_WAIT_USEC (200)
+#define DEFAULT_BATCH_FLOATS (4096)
+
+typedef struct {
+	int fd; // -1: slot free
+	int closing;
+	unsigned busy; // requests queued or on a core
+	char *mem;
+	size_t size;
+} client_t;
+
+typedef struct {
+	unsigned client;
+	uint32_t id, count, in_off, out_off;
+	double t_arrive, t_post;
+} pend_t;
+
+typedef struct {
+	e_buf_t in, out;
+	pend_t reqs[BATCH_MAX_REQS];
+	unsigned nreqs;
+	int busy;
+} core_t;
+
+typedef struct {
+	unsigned long requests, items, batches, rejected;
+	double queue_sum, queue_max, total_sum, total_max;
+	double t_first, t_last;
+} stats_t;
+
+static volatile sig_atomic_t g_quit;
+
+static client_t g_clients[JOBD_MAX_CLIENTS];
+static pend_t g_pending[MAX_PENDING];
+static unsigned g_pend_head, g_pend_tail; // free running
+static core_t g_cores[E_RT_MAX_CORES];
+static stats_t g_stats;
+
+static double now_usec(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec * 1e-3;
+}
+
+static void on_signal(int sig)
+{
+	(void)sig;
+	g_quit = 1;
+}
+
+static void client_release(unsigned c)
+{
+	client_t *cl = &g_clients[c];
+
+	if (cl->busy || (cl->fd < 0)) {
+		return;
+	}
+	if (cl->mem) {
+		munmap(cl->mem, cl->size);
+	}
+	close(cl->fd);
+	memset(cl, 0, sizeof(*cl));
+	cl->fd = -1;
+}
+
+// A client that can't take a reply right away is dropped: it keeps at most
+// its own queue depth of requests outstanding, so a full socket means it
+// stopped reading.
+static void reply(unsigned c, const pend_t *p, int status, double t)
+{
+	client_t *cl = &g_clients[c];
+	jobd_reply_t r;
+
+	r.id = p->id;
+	r.status = status;
+	r.queue_usec = (p->t_post > p->t_arrive) ? p->t_post - p->t_arrive : 0;
+	r.total_usec = t - p->t_arrive;
+	if (!cl->closing && (send(cl->fd, &r, sizeof(r),
+				  MSG_NOSIGNAL | MSG_DONTWAIT) != sizeof(r))) {
+		cl->closing = 1;
+	}
+}
+
+// Reads one packet from client `c`. Returns 0 when the client went away.
+static int client_read(unsigned c)
+{
+	client_t *cl = &g_clients[c];
+	char cbuf[CMSG_SPACE(sizeof(int))];
+	struct iovec iov;
+	struct msghdr msg;
+	struct cmsghdr *cm;
+	jobd_req_t req;
+	struct stat st;
+	pend_t p;
+	ssize_t n;
+	int fd = -1;
+
+	memset(&msg, 0, sizeof(msg));
+	iov.iov_base = &req;
+	iov.iov_len = sizeof(req);
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = cbuf;
+	msg.msg_controllen = sizeof(cbuf);
+	n = recvmsg(cl->fd, &msg, MSG_CMSG_CLOEXEC);
+	if (n <= 0) {
+		return (n < 0) && (errno == EAGAIN);
+	}
+	for (cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+		if ((cm->cmsg_level == SOL_SOCKET) &&
+		    (cm->cmsg_type == SCM_RIGHTS)) {
+			memcpy(&fd, CMSG_DATA(cm), sizeof(fd));
+		}
+	}
+	if (n != sizeof(req)) {
+		if (fd >= 0) {
+			close(fd);
+		}
+		return 0;
+	}
+
+	switch (req.op) {
+	case JOBD_HELLO:
+		// The memfd must be sealed against shrinking, a truncate by the
+		// client would fault the daemon's copies.
+		if ((fd < 0) || cl->mem ||
+		    !(fcntl(fd, F_GET_SEALS) & F_SEAL_SHRINK) ||
+		    (fstat(fd, &st) != 0) || ((uint64_t)st.st_size < req.size)) {
+			if (fd >= 0) {
+				close(fd);
+			}
+			return 0;
+		}
+		cl->mem = mmap(NULL, req.size, PROT_READ | PROT_WRITE,
+			       MAP_SHARED, fd, 0);
+		close(fd);
+		if (cl->mem == MAP_FAILED) {
+			cl->mem = NULL;
+			return 0;
+		}
+		cl->size = req.size;
+		return 1;
+	case JOBD_SHUTDOWN:
+		g_quit = 1;
+		return 1;
+	default:
+		break;
+	}
+	if (fd >= 0) {
+		close(fd);
+	}
+
+	memset(&p, 0, sizeof(p));
+	p.client = c;
+	p.id = req.id;
+	p.count = req.count;
+	p.in_off = req.in_off;
+	p.out_off = req.out_off;
+	p.t_arrive = now_usec();
+	if (!g_stats.t_first) {
+		g_stats.t_first = p.t_arrive;
+	}
+	if ((req.op != JOBD_EXP) || !cl->mem || (req.count == 0) ||
+	    (req.count > JOBD_MAX_COUNT) || (req.in_off % 4) ||
+	    (req.out_off % 4) ||
+	    ((uint64_t)req.in_off + req.count * 4 > cl->size) ||
+	    ((uint64_t)req.out_off + req.count * 4 > cl->size)) {
+		g_stats.rejected++;
+		reply(c, &p, JOBD_EINVAL, p.t_arrive);
+		return !cl->closing;
+	}
+	g_pending[g_pend_tail++ % MAX_PENDING] = p;
+	cl->busy++;
+	return 1;
+}
+
+static void accept_clients(int lfd)
+{
+	int fd;
+
+	while ((fd = accept4(lfd, NULL, NULL,
+			     SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+		unsigned c;
+
+		for (c = 0; c < JOBD_MAX_CLIENTS; c++) {
+			if (g_clients[c].fd < 0) {
+				break;
+			}
+		}
+		if (c == JOBD_MAX_CLIENTS) {
+			close(fd);
+			continue;
+		}
+		memset(&g_clients[c], 0, sizeof(g_clients[c]));
+		g_clients[c].fd = fd;
+	}
+}
+
+// Gathers pending requests into core `k`'s staging buffer and posts them as
+// one job. Returns -1 and leaves the requests pending if the command queue
+// is full.
+static int dispatch(e_rt_t *rt, unsigned k, unsigned batch_reqs)
+{
+	core_t *core = &g_cores[k];
+	const double t = now_usec();
+	uint32_t floats = 0;
+	e_cmd_t cmd;
+
+	core->nreqs = 0;
+	while ((g_pend_head != g_pend_tail) && (core->nreqs < batch_reqs)) {
+		pend_t *p = &g_pending[g_pend_head % MAX_PENDING];
+
+		if (floats + p->count > BATCH_MAX_FLOATS) {
+			break;
+		}
+		memcpy((float *)core->in.ptr + floats,
+		       g_clients[p->client].mem + p->in_off, p->count * 4);
+		p->t_post = t;
+		core->reqs[core->nreqs++] = *p;
+		floats += p->count;
+		g_pend_head++;
+	}
+
+	memset(&cmd, 0, sizeof(cmd));
+	cmd.op = E_CMD_EXP;
+	cmd.seq = g_stats.batches;
+	cmd.src = core->in.off;
+	cmd.dst = core->out.off;
+	cmd.count = floats;
+	if (e_cmdq_post(&rt->queues[k], &cmd) != 0) {
+		g_pend_head -= core->nreqs;
+		core->nreqs = 0;
+		return -1;
+	}
+	g_stats.batches++;
+	core->busy = 1;
+	return 0;
+}
+
+// Scatters the outputs of core `k`'s finished batch and answers every
+// request in it.
+static void complete(unsigned k, int status)
+{
+	core_t *core = &g_cores[k];
+	const double t = now_usec();
+	uint32_t floats = 0;
+	unsigned i;
+
+	for (i = 0; i < core->nreqs; i++) {
+		const pend_t *p = &core->reqs[i];
+		client_t *cl = &g_clients[p->client];
+		double q = p->t_post - p->t_arrive, total = t - p->t_arrive;
+
+		if (!cl->closing && (status == E_CMD_OK)) {
+			memcpy(cl->mem + p->out_off,
+			       (const float *)core->out.ptr + floats,
+			       p->count * 4);
+		}
+		floats += p->count;
+		reply(p->client, p, (status == E_CMD_OK) ? JOBD_OK : JOBD_EFAIL,
+		      t);
+
+		g_stats.requests++;
+		g_stats.items += p->count;
+		g_stats.queue_sum += q;
+		g_stats.queue_max = (q > g_stats.queue_max) ? q
+							    : g_stats.queue_max;
+		g_stats.total_sum += total;
+		g_stats.total_max = (total > g_stats.total_max)
+					    ? total
+					    : g_stats.total_max;
+		cl->busy--;
+		if (cl->closing) {
+			client_release(p->client);
+		}
+	}
+	g_stats.t_last = t;
+	core->busy = 0;
+}
+
+static int listen_on(const char *path)
+{
+	struct sockaddr_un addr;
+	int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC,
+			0);
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path);
+	unlink(path);
+	if ((fd < 0) ||
+	    (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) ||
+	    (listen(fd, JOBD_MAX_CLIENTS) != 0)) {
+		perror("??? jobd socket");
+		return -1;
+	}
+	return fd;
+}
+
+int main(int argc, char *argv[])
+{
+	const char *path = JOBD_SOCKET;
+	double wait_usec = DEFAULT_WAIT_USEC;
+	uint32_t batch_floats = DEFAULT_BATCH_FLOATS;
+	unsigned batch_reqs = BATCH_MAX_REQS;
+	struct pollfd pfds[1 + JOBD_MAX_CLIENTS];
+	unsigned pfd_client[1 + JOBD_MAX_CLIENTS];
+	e_arena_t arena;
+	e_rt_t rt;
+	double busy_usec;
+	unsigned c, k;
+	int lfd, i;
+
+	for (i = 1; i < argc; i++) {
+		if ((strcmp(argv[i], "-w") == 0) && (i + 1 < argc)) {
+			wait_usec = atof(argv[++i]);
+		} else if ((strcmp(argv[i], "-b") == 0) && (i + 1 < argc)) {
+			batch_floats = (uint32_t)atoi(argv[++i]);
+		} else if (strcmp(argv[i], "-n") == 0) {
+			batch_reqs = 1;
+		} else {
+			path = argv[i];
+		}
+	}
+
+	for (c = 0; c < JOBD_MAX_CLIENTS; c++) {
+		g_clients[c].fd = -1;
+	}
+	signal(SIGINT, on_signal);
+	signal(SIGTERM, on_signal);
+	signal(SIGPIPE, SIG_IGN);
+
+	if (e_rt_open(&rt, IMAGE) != E_OK) {
+		return EXIT_FAILURE;
+	}
+	fprintf(stderr, "[jobd] %s open: %.1f us, %u cores\n",
+		rt.warm ? "warm" : "cold", rt.open_usec, rt.ncores);
+
+	e_arena_init(&arena, E_SHM_DATA_OFFSET, E_SHM_DATA_SIZE);
+	for (k = 0; k < rt.ncores; k++) {
+		memset(&g_cores[k], 0, sizeof(g_cores[k]));
+		if ((e_arena_alloc(&arena, BATCH_MAX_FLOATS * sizeof(float), 64,
+				   0, &g_cores[k].in) != E_OK) ||
+		    (e_arena_alloc(&arena, BATCH_MAX_FLOATS * sizeof(float), 64,
+				   0, &g_cores[k].out) != E_OK)) {
+			fprintf(stderr, "??? out of shared DRAM\n");
+			return EXIT_FAILURE;
+		}
+	}
+
+	if ((lfd = listen_on(path)) < 0) {
+		return EXIT_FAILURE;
+	}
+	fprintf(stderr, "[jobd] listening on %s, batch %u floats or %.0f us%s\n",
+		path, batch_floats, wait_usec,
+		(batch_reqs == 1) ? ", no coalescing" : "");
+
+	for (;;) {
+		const unsigned npending = g_pend_tail - g_pend_head;
+		unsigned nbusy = 0, npfds = 0;
+		uint32_t pending_floats = 0;
+		struct timespec ts, *tsp = NULL;
+		double t;
+
+		// Completions
+		for (k = 0; k < rt.ncores; k++) {
+			e_cmpl_t cmpl;
+
+			if (g_cores[k].busy &&
+			    e_cmdq_reap(&rt.queues[k], &cmpl)) {
+				complete(k, cmpl.status);
+			}
+			nbusy += g_cores[k].busy;
+		}
+
+		// Dispatch, once a batch is full or its oldest request waited
+		// long enough. When quitting, whatever is left goes out now.
+		t = now_usec();
+		for (c = g_pend_head; c != g_pend_tail; c++) {
+			pending_floats += g_pending[c % MAX_PENDING].count;
+		}
+		for (k = 0; (k < rt.ncores) && (g_pend_head != g_pend_tail);
+		     k++) {
+			const double age =
+				t - g_pending[g_pend_head % MAX_PENDING].t_arrive;
+
+			if (g_cores[k].busy) {
+				continue;
+			}
+			if ((pending_floats < batch_floats) && (age < wait_usec) &&
+			    (batch_reqs > 1) && !g_quit) {
+				break;
+			}
+			if (dispatch(&rt, k, batch_reqs) != 0) {
+				continue;
+			}
+			pending_floats = 0;
+			for (c = g_pend_head; c != g_pend_tail; c++) {
+				pending_floats +=
+					g_pending[c % MAX_PENDING].count;
+			}
+			nbusy++;
+		}
+
+		if (g_quit && !nbusy && (g_pend_head == g_pend_tail)) {
+			break;
+		}
+
+		// Wait for clients. Spin while cores are busy, sleep until the
+		// oldest pending request is due otherwise.
+		pfds[npfds].fd = lfd;
+		pfds[npfds].events = POLLIN;
+		pfd_client[npfds++] = JOBD_MAX_CLIENTS;
+		for (c = 0; c < JOBD_MAX_CLIENTS; c++) {
+			if ((g_clients[c].fd >= 0) && !g_clients[c].closing) {
+				pfds[npfds].fd = g_clients[c].fd;
+				pfds[npfds].events =
+					(npending + JOBD_MAX_CLIENTS <= MAX_PENDING)
+						? POLLIN
+						: 0;
+				pfd_client[npfds++] = c;
+			}
+		}
+		if (nbusy || g_quit) {
+			ts.tv_sec = 0;
+			ts.tv_nsec = 0;
+			tsp = &ts;
+		} else if (g_pend_head != g_pend_tail) {
+			double due = g_pending[g_pend_head % MAX_PENDING].t_arrive +
+				     wait_usec - now_usec();
+			due = (due > 0.0) ? due : 0.0;
+			ts.tv_sec = (time_t)(due * 1e-6);
+			ts.tv_nsec = (long)((due - ts.tv_sec * 1e6) * 1e3);
+			tsp = &ts;
+		}
+		if (ppoll(pfds, npfds, tsp, NULL) <= 0) {
+			if (nbusy) {
+				sched_yield();
+			}
+			continue;
+		}
+		for (i = 0; i < (int)npfds; i++) {
+			if (!pfds[i].revents) {
+				continue;
+			}
+			if (pfd_client[i] == JOBD_MAX_CLIENTS) {
+				accept_clients(lfd);
+			} else if ((pfds[i].revents & (POLLIN | POLLHUP |
+						       POLLERR)) &&
+				   !client_read(pfd_client[i])) {
+				g_clients[pfd_client[i]].closing = 1;
+				client_release(pfd_client[i]);
+			}
+		}
+	}
+
+	close(lfd);
+	unlink(path);
+	for (c = 0; c < JOBD_MAX_CLIENTS; c++) {
+		g_clients[c].busy = 0;
+		client_release(c);
+	}
+
+	busy_usec = g_stats.t_last - g_stats.t_first;
+	fprintf(stderr, "[jobd] %lu requests(%lu rejected), %lu floats in %lu "
+			"batches, %.1f requests/batch\n",
+		g_stats.requests, g_stats.rejected, g_stats.items,
+		g_stats.batches,
+		g_stats.batches ? (double)g_stats.requests / g_stats.batches
+				: 0.0);
+	if (g_stats.requests) {
+		fprintf(stderr, "[jobd] queueing: ave = %.1f us, max = %.1f us; "
+				"total: ave = %.1f us, max = %.1f us\n",
+			g_stats.queue_sum / g_stats.requests, g_stats.queue_max,
+			g_stats.total_sum / g_stats.requests,
+			g_stats.total_max);
+		fprintf(stderr, "[jobd] throughput: %.1f requests/s, %.2f "
+				"Mexp/s over %.1f ms\n",
+			g_stats.requests * 1e6 / busy_usec,
+			g_stats.items / busy_usec, busy_usec * 1e-3);
+	}
+
+	e_arena_free_job(&arena, 0);
+	e_arena_destroy(&arena);
+	e_rt_close(&rt, E_RT_PARK);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,184 @@
+//
+// HOST side of exp batches split between the host CPU and the persistent exp
+// kernel(e_exp_server.c) with ../common/e_sched.h.
+//
+// After calibration the same batch runs on the host alone, on the e-cores
+// alone, then NUM_BATCHES times on both. Each of those prints the host
+// share, Mexp/s and the rate re-estimated from it, and ends with the best
+// possible rate(host + e-cores). `./test_sched [host threads]`, default 1:
+// on the Parallella one ARM core drives the e-cores, the other computes.
+//
+#include <math.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <e-hal.h>
+
+#include "e_arena.h"
+#include "e_cmdq.h"
+#include "e_sched.h"
+#include "fast_exp.h"
+
+#define BATCH_SIZE (1 << 20) // floats
+#define CALIBRATE_SIZE (1 << 18)
+#define NUM_BATCHES (8)
+#define WAIT_READY_MICROSECONDS (1000000)
+#define MAX_CORES (64)
+
+typedef struct {
+	const float *x;
+	float *y;
+	uint32_t x_off, y_off;
+} exp_batch_t;
+
+static double now_usec(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec * 1e-3;
+}
+
+static void host_exp(void *ctx, unsigned begin, unsigned end)
+{
+	const exp_batch_t *b = (const exp_batch_t *)ctx;
+	exp_host_n(b->y + begin, b->x + begin, (int)(end - begin));
+}
+
+static void core_exp(void *ctx, e_cmd_t *cmd, unsigned begin, unsigned end)
+{
+	const exp_batch_t *b = (const exp_batch_t *)ctx;
+	cmd->op = E_CMD_EXP;
+	cmd->src = b->x_off + begin * sizeof(float);
+	cmd->dst = b->y_off + begin * sizeof(float);
+	cmd->count = end - begin;
+}
+
+static void report(const char *name, const e_sched_t *s)
+{
+	fprintf(stderr, "[sched] %-9s: host %5.1f%%, %7.2f Mexp/s(host %.2f, "
+			"e-cores %.2f Mexp/s estimated), %u jobs\n",
+		name, 100.0 * s->host_items / (s->host_items + s->core_items),
+		(s->host_items + s->core_items) / s->usec, s->host_rate,
+		s->core_rate, s->core_jobs);
+}
+
+int main(int argc, char *argv[])
+{
+	const unsigned nthreads = (argc > 1) ? (unsigned)atoi(argv[1]) : 1;
+	unsigned i, ncores;
+	e_platform_t platform;
+	e_epiphany_t dev;
+	e_mem_t qmem;
+	e_arena_t arena;
+	e_buf_t xbuf, ybuf;
+	e_cmdq_t *queues;
+	exp_batch_t batch;
+	e_sched_t sched;
+	double t0;
+	float max_diff;
+	int errors = 0;
+
+	e_init(NULL);
+	e_reset_system();
+	e_get_platform_info(&platform);
+
+	ncores = platform.rows * platform.cols;
+	ncores = (ncores > MAX_CORES) ? MAX_CORES : ncores;
+
+	e_alloc(&qmem, E_SHM_CMDQ_OFFSET, ncores * sizeof(e_cmdq_t));
+	e_arena_init(&arena, E_SHM_DATA_OFFSET, E_SHM_DATA_SIZE);
+	queues = (e_cmdq_t *)qmem.base;
+	for (i = 0; i < ncores; i++) {
+		e_cmdq_init(&queues[i]);
+	}
+
+	if ((e_arena_alloc(&arena, BATCH_SIZE * sizeof(float), 64, 0, &xbuf) !=
+	     E_OK) ||
+	    (e_arena_alloc(&arena, BATCH_SIZE * sizeof(float), 64, 0, &ybuf) !=
+	     E_OK)) {
+		fprintf(stderr, "??? out of shared DRAM\n");
+		return EXIT_FAILURE;
+	}
+	batch.x = (const float *)xbuf.ptr;
+	batch.y = (float *)ybuf.ptr;
+	batch.x_off = xbuf.off;
+	batch.y_off = ybuf.off;
+	for (i = 0; i < BATCH_SIZE; i++) {
+		((float *)xbuf.ptr)[i] =
+			-30.0f + 60.0f * (float)rand() / (float)RAND_MAX;
+	}
+
+	e_open(&dev, 0, 0, platform.rows, platform.cols);
+	t0 = now_usec();
+	e_load_group("e_exp_server.srec", &dev, 0, 0, platform.rows,
+		     platform.cols, E_FALSE);
+	e_start_group(&dev);
+	for (i = 0; i < ncores; i++) {
+		while (!e_cmdq_ready(&queues[i])) {
+			if (now_usec() - t0 > WAIT_READY_MICROSECONDS) {
+				fprintf(stderr, "??? core %u did not start\n", i);
+				return EXIT_FAILURE;
+			}
+		}
+	}
+
+	e_sched_init(&sched, queues, ncores, nthreads, host_exp, core_exp,
+		     &batch);
+	e_sched_calibrate(&sched, CALIBRATE_SIZE);
+	fprintf(stderr, "[sched] %u host threads, %u cores, calibrated on %u "
+			"floats: host %.2f Mexp/s, e-cores %.2f Mexp/s\n",
+		sched.nthreads, ncores, CALIBRATE_SIZE, sched.host_rate,
+		sched.core_rate);
+
+	// One side only. The other side's rate is left alone.
+	sched.ncores = 0;
+	errors += e_sched_run(&sched, BATCH_SIZE);
+	report("host", &sched);
+	sched.ncores = ncores;
+	sched.nthreads = 0;
+	errors += e_sched_run(&sched, BATCH_SIZE);
+	report("e-cores", &sched);
+	sched.nthreads = (nthreads > E_SCHED_MAX_THREADS) ? E_SCHED_MAX_THREADS
+							  : nthreads;
+
+	for (i = 0; i < NUM_BATCHES; i++) {
+		char name[16];
+		memset(batch.y, 0, BATCH_SIZE * sizeof(float));
+		errors += e_sched_run(&sched, BATCH_SIZE);
+		snprintf(name, sizeof(name), "batch %u", i);
+		report(name, &sched);
+	}
+	fprintf(stderr, "[sched] host + e-cores = %.2f Mexp/s at best\n",
+		sched.host_rate + sched.core_rate);
+
+	max_diff = 0.0f;
+	for (i = 0; i < BATCH_SIZE; i++) {
+		float ref = expf(batch.x[i]);
+		float diff = fabsf(ref - batch.y[i]) / ref;
+		max_diff = (diff > max_diff) ? diff : max_diff;
+	}
+	fprintf(stderr, "[sched] max rel. diff = %e, %d failed jobs\n",
+		max_diff, errors);
+
+	for (i = 0; i < ncores; i++) {
+		e_cmd_t cmd;
+		e_cmpl_t cmpl;
+		memset(&cmd, 0, sizeof(cmd));
+		cmd.op = E_CMD_QUIT;
+		while (e_cmdq_post(&queues[i], &cmd) != 0) {
+		}
+		while (!e_cmdq_reap(&queues[i], &cmpl)) {
+		}
+	}
+
+	e_sched_destroy(&sched);
+	e_close(&dev);
+	e_arena_free_job(&arena, 0);
+	e_arena_destroy(&arena);
+	e_free(&qmem);
+	e_finalize();
+
+	return (errors || (max_diff > 5e-6f)) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,318 @@
+//
+// HOST side of the persistent exp kernel(e_exp_server.c).
+//
+// Loads the program once, then dispatches exp jobs through the command
+// queue(../common/e_cmdq.h) and reports program load cost, per-job dispatch
+// latency and batch throughput, then streams one multi-MB array with
+// E_CMD_EXP and E_CMD_EXP_STREAM(DMA double buffered) for bytes/cycle and
+// elements/cycle per core and in aggregate.
+//
+#include <math.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <e-hal.h>
+
+#include "e_arena.h"
+#include "e_cmdq.h"
+
+#define NUM_LATENCY_JOBS (256)
+#define NUM_BATCH_JOBS (4096)
+#define JOB_SIZE (1024) // floats per job
+#define WAIT_READY_MICROSECONDS (1000000)
+#define MAX_CORES (64)
+#define STREAM_SIZE (1 << 20) // floats, 4MB in + 4MB out
+#define TRACE_JSON "exp_server.trace.json" // with E_TRACE, see e_trace.h
+
+static double now_usec(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec * 1e-3;
+}
+
+// Spins until the completion for one job shows up on `q`.
+static void wait_one(e_cmdq_t *q, e_cmpl_t *cmpl)
+{
+	while (!e_cmdq_reap(q, cmpl)) {
+	}
+}
+
+// One slice of x per core, all posted at once. Per core rates use the job's
+// own clocks, the aggregate uses the slowest core. Bytes count both the load
+// and the store.
+static void stream_bench(e_cmdq_t *queues, unsigned ncores, uint32_t op,
+			 const char *name, const e_buf_t *x, const e_buf_t *y)
+{
+	const unsigned slice = (STREAM_SIZE / ncores) & ~15u;
+	uint32_t clocks[MAX_CORES];
+	uint32_t max_clocks = 0;
+	float max_diff = 0.0f;
+	unsigned i, k;
+
+	memset(y->ptr, 0, STREAM_SIZE * sizeof(float));
+	for (k = 0; k < ncores; k++) {
+		e_cmd_t cmd;
+		memset(&cmd, 0, sizeof(cmd));
+		cmd.op = op;
+		cmd.seq = k;
+		cmd.src = x->off + k * slice * sizeof(float);
+		cmd.dst = y->off + k * slice * sizeof(float);
+		cmd.count = slice;
+		e_cmdq_post(&queues[k], &cmd);
+	}
+	for (k = 0; k < ncores; k++) {
+		e_cmpl_t cmpl;
+		wait_one(&queues[k], &cmpl);
+		if (cmpl.status != E_CMD_OK) {
+			fprintf(stderr, "??? %s failed on core %u(%d)\n", name,
+				k, cmpl.status);
+		}
+		clocks[k] = cmpl.clocks ? cmpl.clocks : 1;
+		max_clocks = (clocks[k] > max_clocks) ? clocks[k] : max_clocks;
+	}
+
+	for (i = 0; i < slice * ncores; i++) {
+		float ref = expf(((const float *)x->ptr)[i]);
+		float diff = fabsf(ref - ((const float *)y->ptr)[i]) / ref;
+		max_diff = (diff > max_diff) ? diff : max_diff;
+	}
+
+	for (k = 0; k < ncores; k++) {
+		fprintf(stderr, "[exp_server] %s core %2u: %u floats, %u clocks, "
+				"%.3f elements/cycle, %.3f bytes/cycle\n",
+			name, k, slice, clocks[k], (double)slice / clocks[k],
+			8.0 * slice / clocks[k]);
+	}
+	fprintf(stderr, "[exp_server] %s aggregate: %u floats, %u clocks, "
+			"%.3f elements/cycle, %.3f bytes/cycle, "
+			"max rel. diff = %e\n",
+		name, slice * ncores, max_clocks,
+		(double)slice * ncores / max_clocks,
+		8.0 * slice * ncores / max_clocks, max_diff);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned i, k, ncores;
+	e_platform_t platform;
+	e_epiphany_t dev;
+	e_mem_t qmem;
+#if E_TRACE
+	e_mem_t tmem;
+#endif
+	e_arena_t arena;
+	e_arena_stats_t stats;
+	e_buf_t src[MAX_CORES], dst[MAX_CORES];
+	e_cmdq_t *queues;
+	double t0, t1, load_usec, lat_sum, lat_min, lat_max;
+	unsigned long long clocks_sum;
+	float max_diff;
+
+	e_init(NULL);
+	e_reset_system();
+	e_get_platform_info(&platform);
+
+	ncores = platform.rows * platform.cols;
+	ncores = (ncores > MAX_CORES) ? MAX_CORES : ncores;
+
+	// Queues and payloads both live in shared DRAM and are accessed
+	// through the mapping, so no e_read()/e_write() is needed.
+	e_alloc(&qmem, E_SHM_CMDQ_OFFSET, ncores * sizeof(e_cmdq_t));
+#if E_TRACE
+	e_alloc(&tmem, E_SHM_TRACE_OFFSET, ncores * sizeof(e_trace_ring_t));
+	e_trace_clear(tmem.base, ncores);
+#endif
+	e_arena_init(&arena, E_SHM_DATA_OFFSET, E_SHM_DATA_SIZE);
+	queues = (e_cmdq_t *)qmem.base;
+
+	for (i = 0; i < ncores; i++) {
+		e_cmdq_init(&queues[i]);
+	}
+
+	// Batch buffers, one in/out pair per core. Job id 0 is used for
+	// buffers which live until the end of the run.
+	for (k = 0; k < ncores; k++) {
+		float *p;
+		if ((e_arena_alloc(&arena, JOB_SIZE * sizeof(float), 64, 0,
+				   &src[k]) != E_OK) ||
+		    (e_arena_alloc(&arena, JOB_SIZE * sizeof(float), 64, 0,
+				   &dst[k]) != E_OK)) {
+			fprintf(stderr, "??? out of shared DRAM\n");
+			return EXIT_FAILURE;
+		}
+		p = (float *)src[k].ptr;
+		for (i = 0; i < JOB_SIZE; i++) {
+			p[i] = -30.0f + 60.0f * (float)rand() / (float)RAND_MAX;
+		}
+	}
+
+	e_open(&dev, 0, 0, platform.rows, platform.cols);
+
+	t0 = now_usec();
+	e_load_group("e_exp_server.srec", &dev, 0, 0, platform.rows,
+		     platform.cols, E_FALSE);
+	e_start_group(&dev);
+	for (i = 0; i < ncores; i++) {
+		while (!e_cmdq_ready(&queues[i])) {
+			if (now_usec() - t0 > WAIT_READY_MICROSECONDS) {
+				fprintf(stderr, "??? core %u did not start\n", i);
+				return EXIT_FAILURE;
+			}
+		}
+	}
+	load_usec = now_usec() - t0;
+
+	// Latency: one job in flight on core 0. Buffers are allocated per
+	// job(tagged with seq + 1) and released when the job completes.
+	lat_sum = 0.0;
+	lat_min = 1e30;
+	lat_max = 0.0;
+	for (i = 0; i < NUM_LATENCY_JOBS; i++) {
+		e_cmd_t cmd;
+		e_cmpl_t cmpl;
+		e_buf_t in, out;
+		double lat;
+
+		t0 = now_usec();
+		e_arena_alloc(&arena, 4 * sizeof(float), 8, i + 1, &in);
+		e_arena_alloc(&arena, 4 * sizeof(float), 8, i + 1, &out);
+		memcpy(in.ptr, src[0].ptr, 4 * sizeof(float));
+
+		memset(&cmd, 0, sizeof(cmd));
+		cmd.op = E_CMD_EXP;
+		cmd.seq = i;
+		cmd.src = in.off;
+		cmd.dst = out.off;
+		cmd.count = 4;
+
+		e_cmdq_post(&queues[0], &cmd);
+		wait_one(&queues[0], &cmpl);
+		e_arena_free_job(&arena, i + 1);
+		lat = now_usec() - t0;
+
+		lat_sum += lat;
+		lat_min = (lat < lat_min) ? lat : lat_min;
+		lat_max = (lat > lat_max) ? lat : lat_max;
+	}
+
+	// Throughput: keep every core's ring full.
+	{
+		unsigned posted = 0, done = 0;
+		clocks_sum = 0;
+
+		t0 = now_usec();
+		while (done < NUM_BATCH_JOBS) {
+			for (k = 0; k < ncores; k++) {
+				e_cmd_t cmd;
+				e_cmpl_t cmpl;
+
+				if (posted < NUM_BATCH_JOBS) {
+					memset(&cmd, 0, sizeof(cmd));
+					cmd.op = E_CMD_EXP;
+					cmd.seq = posted;
+					cmd.src = src[k].off;
+					cmd.dst = dst[k].off;
+					cmd.count = JOB_SIZE;
+					if (e_cmdq_post(&queues[k], &cmd) == 0) {
+						posted++;
+					}
+				}
+				while (e_cmdq_reap(&queues[k], &cmpl)) {
+					if (cmpl.status != E_CMD_OK) {
+						fprintf(stderr,
+							"??? job %u failed(%d)\n",
+							cmpl.seq, cmpl.status);
+					}
+					clocks_sum += cmpl.clocks;
+					done++;
+				}
+			}
+		}
+		t1 = now_usec();
+
+		// Results are read in place through the mapping.
+		max_diff = 0.0f;
+		for (k = 0; k < ncores; k++) {
+			const float *x = (const float *)src[k].ptr;
+			const float *y = (const float *)dst[k].ptr;
+			for (i = 0; i < JOB_SIZE; i++) {
+				float ref = expf(x[i]);
+				float diff = fabsf(ref - y[i]) / ref;
+				max_diff = (diff > max_diff) ? diff : max_diff;
+			}
+		}
+
+		fprintf(stderr, "[exp_server] cores = %u\n", ncores);
+		fprintf(stderr, "[exp_server] load + start = %.1f us\n",
+			load_usec);
+		fprintf(stderr, "[exp_server] dispatch latency(4 floats): "
+				"ave = %.2f us, min = %.2f us, max = %.2f us\n",
+			lat_sum / NUM_LATENCY_JOBS, lat_min, lat_max);
+		fprintf(stderr, "[exp_server] %d jobs x %d floats: %.1f us, "
+				"%.2f Mexp/s, %llu clocks/job on core\n",
+			NUM_BATCH_JOBS, JOB_SIZE, t1 - t0,
+			(double)NUM_BATCH_JOBS * JOB_SIZE / (t1 - t0),
+			clocks_sum / NUM_BATCH_JOBS);
+		fprintf(stderr, "[exp_server] max rel. diff = %e\n", max_diff);
+
+		e_arena_get_stats(&arena, &stats);
+		fprintf(stderr, "[exp_server] arena: used = %u, peak = %u, "
+				"free = %u in %u blocks(largest %u), "
+				"fragmentation = %.3f\n",
+			stats.used, stats.peak, stats.free_bytes,
+			stats.num_free, stats.largest_free,
+			stats.fragmentation);
+	}
+
+	// Streaming: arrays far larger than the 32KB of local memory.
+	{
+		const unsigned job = NUM_LATENCY_JOBS + 1;
+		e_buf_t x, y;
+
+		if ((e_arena_alloc(&arena, STREAM_SIZE * sizeof(float), 64, job,
+				   &x) != E_OK) ||
+		    (e_arena_alloc(&arena, STREAM_SIZE * sizeof(float), 64, job,
+				   &y) != E_OK)) {
+			fprintf(stderr, "??? out of shared DRAM\n");
+			return EXIT_FAILURE;
+		}
+		for (i = 0; i < STREAM_SIZE; i++) {
+			((float *)x.ptr)[i] =
+				-30.0f + 60.0f * (float)rand() / (float)RAND_MAX;
+		}
+
+		stream_bench(queues, ncores, E_CMD_EXP, "exp", &x, &y);
+		stream_bench(queues, ncores, E_CMD_EXP_STREAM, "exp_stream", &x,
+			     &y);
+		e_arena_free_job(&arena, job);
+	}
+
+	for (i = 0; i < ncores; i++) {
+		e_cmd_t cmd;
+		e_cmpl_t cmpl;
+		memset(&cmd, 0, sizeof(cmd));
+		cmd.op = E_CMD_QUIT;
+		while (e_cmdq_post(&queues[i], &cmd) != 0) {
+		}
+		wait_one(&queues[i], &cmpl);
+	}
+
+#if E_TRACE
+	if (e_trace_write_json(TRACE_JSON, tmem.base, ncores, platform.cols,
+			       E_TRACE_CLOCK_MHZ) == 0) {
+		fprintf(stderr, "[exp_server] trace -> %s\n", TRACE_JSON);
+	}
+	e_free(&tmem);
+#endif
+	e_close(&dev);
+	e_arena_free_job(&arena, 0);
+	e_arena_destroy(&arena);
+	e_free(&qmem);
+	e_finalize();
+
+	return 0;
+}
@@ -0,0 +1,332 @@
+//
+// HOST side of the parallel softmax/log-sum-exp on the persistent exp
+// kernel(e_exp_server.c).
+//
+// A long vector is split across all cores:
+//   1. E_CMD_SOFTMAX_STATS : every core reduces its part to (max, sum)
+//   2. host merges the partial (max, sum) pairs
+//   3. E_CMD_SOFTMAX_SCALE : every core writes exp(x - max) / sum
+//
+// Accuracy and throughput are compared against a double precision reference
+// computed on the host.
+//
+// Then the same data as ROWS independent rows of ROW_LEN floats, the
+// attention-style case: every core runs softmax_n(), softmax_online_n() and
+// logsumexp_n() on whole rows in local memory(E_CMD_SOFTMAX_ROWS).
+//
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <e-hal.h>
+
+#include "e_arena.h"
+#include "e_cmdq.h"
+
+#define VECTOR_SIZE (1 << 20)
+#define NUM_REPEAT (8)
+#define WAIT_READY_MICROSECONDS (1000000)
+#define MAX_CORES (64)
+#define ROW_LEN (256) // at most EXP_CHUNK(e_exp_server.c)
+#define ROWS (VECTOR_SIZE / ROW_LEN)
+
+typedef union {
+	unsigned int i;
+	float f;
+} bits_t;
+
+static double now_usec(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec * 1e-3;
+}
+
+// Posts one job per core and waits for all of them. Returns the largest
+// per-core clock count.
+static unsigned run_round(e_cmdq_t *queues, const e_cmd_t *cmds,
+			  unsigned ncores)
+{
+	unsigned k, max_clocks = 0;
+
+	for (k = 0; k < ncores; k++) {
+		while (e_cmdq_post(&queues[k], &cmds[k]) != 0) {
+		}
+	}
+	for (k = 0; k < ncores; k++) {
+		e_cmpl_t cmpl;
+		while (!e_cmdq_reap(&queues[k], &cmpl)) {
+		}
+		if (cmpl.status != E_CMD_OK) {
+			fprintf(stderr, "??? job on core %u failed(%d)\n", k,
+				cmpl.status);
+		}
+		max_clocks = (cmpl.clocks > max_clocks) ? cmpl.clocks
+							: max_clocks;
+	}
+	return max_clocks;
+}
+
+// Times one E_CMD_SOFTMAX_ROWS variant over all rows of x and checks it
+// against the double precision reference: max rel. diff of the
+// probabilities, max abs. diff of log-sum-exp.
+static void rows_bench(e_cmdq_t *queues, unsigned ncores, unsigned variant,
+		       const e_buf_t *xbuf, const e_buf_t *ybuf,
+		       const e_buf_t *lbuf)
+{
+	static const char *const names[] = {"softmax_n", "softmax_online_n",
+					    "logsumexp_n"};
+	const unsigned part = (ROWS + ncores - 1) / ncores;
+	const float *x = (const float *)xbuf->ptr;
+	const float *y = (const float *)ybuf->ptr;
+	const float *l = (const float *)lbuf->ptr;
+	e_cmd_t cmds[MAX_CORES];
+	unsigned i, k, r, row, clocks = 0;
+	double t0, t, max_diff = 0.0;
+
+	t0 = now_usec();
+	for (r = 0; r < NUM_REPEAT; r++) {
+		for (k = 0; k < ncores; k++) {
+			const unsigned first = k * part;
+			memset(&cmds[k], 0, sizeof(e_cmd_t));
+			cmds[k].op = E_CMD_SOFTMAX_ROWS;
+			cmds[k].seq = r;
+			cmds[k].src = xbuf->off + first * ROW_LEN * sizeof(float);
+			cmds[k].dst = (variant == E_SOFTMAX_ROWS_LSE)
+					      ? lbuf->off + first * sizeof(float)
+					      : ybuf->off + first * ROW_LEN *
+								    sizeof(float);
+			cmds[k].count = (first >= ROWS) ? 0
+					: (first + part > ROWS) ? ROWS - first
+								: part;
+			cmds[k].arg[0] = ROW_LEN;
+			cmds[k].arg[1] = variant;
+		}
+		clocks += run_round(queues, cmds, ncores);
+	}
+	t = (now_usec() - t0) / NUM_REPEAT;
+
+	for (row = 0; row < ROWS; row++) {
+		const float *xr = x + row * ROW_LEN;
+		double rm = -DBL_MAX, rs = 0.0;
+
+		for (i = 0; i < ROW_LEN; i++) {
+			rm = (xr[i] > rm) ? xr[i] : rm;
+		}
+		for (i = 0; i < ROW_LEN; i++) {
+			rs += exp((double)xr[i] - rm);
+		}
+		if (variant == E_SOFTMAX_ROWS_LSE) {
+			double diff = fabs(l[row] - (rm + log(rs)));
+			max_diff = (diff > max_diff) ? diff : max_diff;
+			continue;
+		}
+		for (i = 0; i < ROW_LEN; i++) {
+			double ref = exp((double)xr[i] - rm) / rs;
+			double diff = fabs(y[row * ROW_LEN + i] - ref) / ref;
+			max_diff = (diff > max_diff) ? diff : max_diff;
+		}
+	}
+
+	fprintf(stderr, "[softmax rows] %-16s %u x %u: %.1f us(%u clocks/core), "
+			"%.2f Melem/s, max %s diff = %e\n",
+		names[variant], ROWS, ROW_LEN, t, clocks / NUM_REPEAT,
+		VECTOR_SIZE / t,
+		(variant == E_SOFTMAX_ROWS_LSE) ? "abs." : "rel.", max_diff);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned i, k, r, ncores, part;
+	e_platform_t platform;
+	e_epiphany_t dev;
+	e_mem_t qmem;
+	e_arena_t arena;
+	e_buf_t xbuf, ybuf, sbuf, lbuf;
+	e_cmdq_t *queues;
+	e_cmd_t cmds[MAX_CORES];
+	float *x, *y, *stats;
+	double *ref;
+	double t0, t_stats, t_scale, t_ref;
+	unsigned clocks_stats, clocks_scale;
+	double rm, rs, max_abs, max_rel, sum_y;
+	float m, d;
+
+	e_init(NULL);
+	e_reset_system();
+	e_get_platform_info(&platform);
+
+	ncores = platform.rows * platform.cols;
+	ncores = (ncores > MAX_CORES) ? MAX_CORES : ncores;
+	part = (VECTOR_SIZE + ncores - 1) / ncores;
+
+	e_alloc(&qmem, E_SHM_CMDQ_OFFSET, ncores * sizeof(e_cmdq_t));
+	e_arena_init(&arena, E_SHM_DATA_OFFSET, E_SHM_DATA_SIZE);
+	queues = (e_cmdq_t *)qmem.base;
+	if ((e_arena_alloc(&arena, VECTOR_SIZE * sizeof(float), 64, 0, &xbuf) !=
+	     E_OK) ||
+	    (e_arena_alloc(&arena, VECTOR_SIZE * sizeof(float), 64, 0, &ybuf) !=
+	     E_OK) ||
+	    (e_arena_alloc(&arena, ncores * 2 * sizeof(float), 8, 0, &sbuf) !=
+	     E_OK) ||
+	    (e_arena_alloc(&arena, ROWS * sizeof(float), 8, 0, &lbuf) !=
+	     E_OK)) {
+		fprintf(stderr, "??? out of shared DRAM\n");
+		return EXIT_FAILURE;
+	}
+	x = (float *)xbuf.ptr;
+	y = (float *)ybuf.ptr;
+	stats = (float *)sbuf.ptr;
+
+	// Logits in [-8, 8] with a few large spikes, so the running max moves.
+	for (i = 0; i < VECTOR_SIZE; i++) {
+		x[i] = -8.0f + 16.0f * (float)rand() / (float)RAND_MAX;
+		if ((rand() % 4096) == 0) {
+			x[i] += 20.0f;
+		}
+	}
+
+	for (i = 0; i < ncores; i++) {
+		e_cmdq_init(&queues[i]);
+	}
+
+	e_open(&dev, 0, 0, platform.rows, platform.cols);
+	e_load_group("e_exp_server.srec", &dev, 0, 0, platform.rows,
+		     platform.cols, E_FALSE);
+	e_start_group(&dev);
+	t0 = now_usec();
+	for (i = 0; i < ncores; i++) {
+		while (!e_cmdq_ready(&queues[i])) {
+			if (now_usec() - t0 > WAIT_READY_MICROSECONDS) {
+				fprintf(stderr, "??? core %u did not start\n", i);
+				return EXIT_FAILURE;
+			}
+		}
+	}
+
+	t_stats = 0.0;
+	t_scale = 0.0;
+	clocks_stats = 0;
+	clocks_scale = 0;
+	m = 0.0f;
+	d = 0.0f;
+	for (r = 0; r < NUM_REPEAT; r++) {
+		bits_t mb, inv_db;
+
+		t0 = now_usec();
+		for (k = 0; k < ncores; k++) {
+			unsigned first = k * part;
+			memset(&cmds[k], 0, sizeof(e_cmd_t));
+			cmds[k].op = E_CMD_SOFTMAX_STATS;
+			cmds[k].seq = r;
+			cmds[k].src = xbuf.off + first * sizeof(float);
+			cmds[k].dst = sbuf.off + k * 2 * sizeof(float);
+			cmds[k].count = (first + part > VECTOR_SIZE)
+					    ? VECTOR_SIZE - first
+					    : part;
+		}
+		clocks_stats += run_round(queues, cmds, ncores);
+
+		m = stats[0];
+		d = stats[1];
+		for (k = 1; k < ncores; k++) {
+			float mk = stats[2 * k], dk = stats[2 * k + 1];
+			if (mk > m) {
+				d = d * expf(m - mk) + dk;
+				m = mk;
+			} else {
+				d += dk * expf(mk - m);
+			}
+		}
+		t_stats += now_usec() - t0;
+
+		t0 = now_usec();
+		mb.f = m;
+		inv_db.f = 1.0f / d;
+		for (k = 0; k < ncores; k++) {
+			cmds[k].op = E_CMD_SOFTMAX_SCALE;
+			cmds[k].dst = ybuf.off + k * part * sizeof(float);
+			cmds[k].arg[0] = mb.i;
+			cmds[k].arg[1] = inv_db.i;
+		}
+		clocks_scale += run_round(queues, cmds, ncores);
+		t_scale += now_usec() - t0;
+	}
+
+	// Double precision reference.
+	ref = (double *)malloc(VECTOR_SIZE * sizeof(double));
+	t0 = now_usec();
+	rm = -DBL_MAX;
+	for (i = 0; i < VECTOR_SIZE; i++) {
+		rm = (x[i] > rm) ? x[i] : rm;
+	}
+	rs = 0.0;
+	for (i = 0; i < VECTOR_SIZE; i++) {
+		ref[i] = exp((double)x[i] - rm);
+		rs += ref[i];
+	}
+	for (i = 0; i < VECTOR_SIZE; i++) {
+		ref[i] /= rs;
+	}
+	t_ref = now_usec() - t0;
+
+	max_abs = 0.0;
+	max_rel = 0.0;
+	sum_y = 0.0;
+	for (i = 0; i < VECTOR_SIZE; i++) {
+		double diff = fabs((double)y[i] - ref[i]);
+		max_abs = (diff > max_abs) ? diff : max_abs;
+		if (ref[i] > 1.0e-30) {
+			diff /= ref[i];
+			max_rel = (diff > max_rel) ? diff : max_rel;
+		}
+		sum_y += y[i];
+	}
+
+	fprintf(stderr, "[softmax] n = %d, cores = %u\n", VECTOR_SIZE, ncores);
+	fprintf(stderr, "[softmax] stats pass: %.1f us(%u clocks/core), "
+			"%.2f Melem/s\n",
+		t_stats / NUM_REPEAT, clocks_stats / NUM_REPEAT,
+		VECTOR_SIZE / (t_stats / NUM_REPEAT));
+	fprintf(stderr, "[softmax] scale pass: %.1f us(%u clocks/core), "
+			"%.2f Melem/s\n",
+		t_scale / NUM_REPEAT, clocks_scale / NUM_REPEAT,
+		VECTOR_SIZE / (t_scale / NUM_REPEAT));
+	fprintf(stderr, "[softmax] total: %.2f Melem/s(host double "
+			"reference: %.2f Melem/s)\n",
+		VECTOR_SIZE / ((t_stats + t_scale) / NUM_REPEAT),
+		VECTOR_SIZE / t_ref);
+	fprintf(stderr, "[softmax] max abs. diff = %e, max rel. diff = %e, "
+			"|sum - 1| = %e\n",
+		max_abs, max_rel, fabs(sum_y - 1.0));
+	fprintf(stderr, "[logsumexp] ret = %.7f, ref = %.7f, abs. diff = %e\n",
+		m + logf(d), rm + log(rs), fabs((m + log(d)) - (rm + log(rs))));
+
+	rows_bench(queues, ncores, E_SOFTMAX_ROWS_3PASS, &xbuf, &ybuf, &lbuf);
+	rows_bench(queues, ncores, E_SOFTMAX_ROWS_ONLINE, &xbuf, &ybuf, &lbuf);
+	rows_bench(queues, ncores, E_SOFTMAX_ROWS_LSE, &xbuf, &ybuf, &lbuf);
+
+	for (i = 0; i < ncores; i++) {
+		e_cmd_t cmd;
+		e_cmpl_t cmpl;
+		memset(&cmd, 0, sizeof(cmd));
+		cmd.op = E_CMD_QUIT;
+		while (e_cmdq_post(&queues[i], &cmd) != 0) {
+		}
+		while (!e_cmdq_reap(&queues[i], &cmpl)) {
+		}
+	}
+
+	free(ref);
+	e_close(&dev);
+	e_arena_free_job(&arena, 0);
+	e_arena_destroy(&arena);
+	e_free(&qmem);
+	e_finalize();
+
+	return 0;
+}
@@ -0,0 +1,133 @@
+//
+// HOST side of cold vs. warm starts of the persistent exp kernel
+// (e_exp_server.c) through ../common/e_rt.h.
+//
+// Opens the runtime twice. The first open is cold unless an earlier run left
+// the cores parked, the second one is always warm. Each open prints its
+// phases(init, ping, reset, load, start), then the relaunch latency of a
+// parked core(E_CMD_NOP round trip on core 0) and of one short exp job per
+// core. The cores are left parked at exit, so running it again shows a warm
+// start across processes. `./test_warm -q` stops them instead.
+//
+#include <math.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "e_arena.h"
+#include "e_rt.h"
+
+#define IMAGE "e_exp_server.srec"
+#define NUM_RELAUNCH (256)
+#define JOB_SIZE (1024) // floats per core
+
+static double now_usec(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec * 1e-3;
+}
+
+// One exp job of JOB_SIZE floats on every core, us until the last one is
+// done. Returns the max rel. diff in `max_diff`.
+static double exp_round(e_rt_t *rt, const e_buf_t *x, const e_buf_t *y,
+			float *max_diff)
+{
+	const double t0 = now_usec();
+	double usec;
+	unsigned i, k;
+
+	for (k = 0; k < rt->ncores; k++) {
+		e_cmd_t cmd;
+		memset(&cmd, 0, sizeof(cmd));
+		cmd.op = E_CMD_EXP;
+		cmd.seq = k;
+		cmd.src = x->off + k * JOB_SIZE * sizeof(float);
+		cmd.dst = y->off + k * JOB_SIZE * sizeof(float);
+		cmd.count = JOB_SIZE;
+		while (e_cmdq_post(&rt->queues[k], &cmd) != 0) {
+		}
+	}
+	for (k = 0; k < rt->ncores; k++) {
+		e_cmpl_t cmpl;
+		while (!e_cmdq_reap(&rt->queues[k], &cmpl)) {
+		}
+	}
+	usec = now_usec() - t0;
+
+	*max_diff = 0.0f;
+	for (i = 0; i < rt->ncores * JOB_SIZE; i++) {
+		float ref = expf(((const float *)x->ptr)[i]);
+		float diff = fabsf(ref - ((const float *)y->ptr)[i]) / ref;
+		*max_diff = (diff > *max_diff) ? diff : *max_diff;
+	}
+	return usec;
+}
+
+int main(int argc, char *argv[])
+{
+	const int stop = (argc > 1) && (strcmp(argv[1], "-q") == 0);
+	int pass;
+
+	for (pass = 0; pass < 2; pass++) {
+		e_rt_t rt;
+		e_arena_t arena;
+		e_buf_t x, y;
+		double lat_sum = 0.0, lat_min = 1e30, exp_usec;
+		float max_diff;
+		unsigned i;
+
+		if (e_rt_open(&rt, IMAGE) != E_OK) {
+			return EXIT_FAILURE;
+		}
+		fprintf(stderr, "[warm] open %d: %s, %.1f us(init %.1f, ping %.1f, "
+				"reset %.1f, load %.1f, start %.1f), %u opens "
+				"since load\n",
+			pass, rt.warm ? "warm" : "cold", rt.open_usec,
+			rt.init_usec, rt.ping_usec, rt.reset_usec,
+			rt.load_usec, rt.start_usec, rt.hdr->opens);
+
+		for (i = 0; i < NUM_RELAUNCH; i++) {
+			e_cmd_t cmd;
+			e_cmpl_t cmpl;
+			double t0 = now_usec();
+			memset(&cmd, 0, sizeof(cmd));
+			cmd.op = E_CMD_NOP;
+			cmd.seq = i;
+			e_rt_call(&rt, 0, &cmd, &cmpl);
+			t0 = now_usec() - t0;
+			lat_sum += t0;
+			lat_min = (t0 < lat_min) ? t0 : lat_min;
+		}
+
+		e_arena_init(&arena, E_SHM_DATA_OFFSET, E_SHM_DATA_SIZE);
+		if ((e_arena_alloc(&arena, rt.ncores * JOB_SIZE * sizeof(float),
+				   64, 0, &x) != E_OK) ||
+		    (e_arena_alloc(&arena, rt.ncores * JOB_SIZE * sizeof(float),
+				   64, 0, &y) != E_OK)) {
+			fprintf(stderr, "??? out of shared DRAM\n");
+			return EXIT_FAILURE;
+		}
+		for (i = 0; i < rt.ncores * JOB_SIZE; i++) {
+			((float *)x.ptr)[i] =
+				-30.0f + 60.0f * (float)rand() / (float)RAND_MAX;
+		}
+		exp_usec = exp_round(&rt, &x, &y, &max_diff);
+		e_arena_free_job(&arena, 0);
+		e_arena_destroy(&arena);
+
+		fprintf(stderr, "[warm] relaunch(NOP on core 0): ave = %.2f us, "
+				"min = %.2f us; %u x %d floats exp: %.1f us(%.1f%% "
+				"of open + exp), max rel. diff = %e\n",
+			lat_sum / NUM_RELAUNCH, lat_min, rt.ncores, JOB_SIZE,
+			exp_usec, 100.0 * exp_usec / (exp_usec + rt.open_usec),
+			max_diff);
+
+		e_rt_close(&rt, (stop && (pass == 1)) ? E_RT_STOP : E_RT_PARK);
+	}
+	fprintf(stderr, "[warm] cores %s\n",
+		stop ? "stopped" : "left parked, run again for a warm start");
+
+	return EXIT_SUCCESS;
+}
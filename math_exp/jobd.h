@@ -0,0 +1,50 @@
+//
+// Protocol between the exp job daemon(host_jobd.c) and its clients
+// (jobd_client.c).
+//
+// SOCK_SEQPACKET on a Unix domain socket, one jobd_req_t per packet. A
+// client first sends JOBD_HELLO with a memfd attached(SCM_RIGHTS), sealed
+// with F_SEAL_SHRINK so it can't be truncated under the daemon. Both
+// sides map it, and requests then only carry offsets into it, so payloads
+// are never copied through the socket. Every JOBD_EXP gets one
+// jobd_reply_t, not necessarily in order.
+//
+#ifndef JOBD_H_
+#define JOBD_H_
+
+#include <stdint.h>
+
+#define JOBD_SOCKET "/tmp/e_jobd.sock"
+#define JOBD_MAX_CLIENTS (16)
+#define JOBD_MAX_COUNT (4096) // floats per request
+
+enum {
+	JOBD_HELLO = 0,	   // memfd attached, size = its size in bytes
+	JOBD_EXP = 1,	   // out[i] = exp(in[i]), i < count
+	JOBD_SHUTDOWN = 2, // daemon prints its stats and exits
+};
+
+enum {
+	JOBD_OK = 0,
+	JOBD_EINVAL = -1, // bad op, count or offsets
+	JOBD_EFAIL = -2,  // the e-core job failed
+};
+
+typedef struct {
+	uint32_t op;
+	uint32_t id; // echoed in the reply
+	uint32_t count;
+	uint32_t in_off; // bytes into the memfd
+	uint32_t out_off;
+	uint32_t pad;
+	uint64_t size;
+} jobd_req_t; // 32 bytes
+
+typedef struct {
+	uint32_t id;
+	int32_t status;
+	uint32_t queue_usec; // arrival until posted to a core
+	uint32_t total_usec; // arrival until this reply
+} jobd_reply_t;
+
+#endif // JOBD_H_
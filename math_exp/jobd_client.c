@@ -0,0 +1,243 @@
+//
+// Load generator for the exp job daemon(host_jobd.c).
+//
+// Forks `-c` client processes. Each one shares a memfd with the daemon and
+// keeps `-d` requests of 16..`-m` random floats in flight until it has sent
+// `-n`. It checks every result against expf() and reports round trip and
+// daemon side queueing latency. The parent reports aggregate throughput.
+// `-s` shuts the daemon down afterwards, so it prints its own stats.
+//
+//   ./test_jobd_client [-c clients] [-n requests] [-d depth] [-m floats] [-s]
+//                      [socket]
+//
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <math.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+#include "jobd.h"
+
+#define MAX_DEPTH (64)
+
+typedef struct {
+	unsigned nclients, nreqs, depth, max_count;
+	const char *path;
+} opts_t;
+
+static double now_usec(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec * 1e-3;
+}
+
+static int connect_to(const char *path)
+{
+	struct sockaddr_un addr;
+	int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path);
+	if ((fd < 0) ||
+	    (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0)) {
+		perror("??? jobd connect");
+		return -1;
+	}
+	return fd;
+}
+
+static int send_hello(int fd, int memfd, size_t size)
+{
+	char cbuf[CMSG_SPACE(sizeof(int))];
+	struct iovec iov;
+	struct msghdr msg;
+	struct cmsghdr *cm;
+	jobd_req_t req;
+
+	memset(&req, 0, sizeof(req));
+	req.op = JOBD_HELLO;
+	req.size = size;
+	memset(&msg, 0, sizeof(msg));
+	memset(cbuf, 0, sizeof(cbuf));
+	iov.iov_base = &req;
+	iov.iov_len = sizeof(req);
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = cbuf;
+	msg.msg_controllen = sizeof(cbuf);
+	cm = CMSG_FIRSTHDR(&msg);
+	cm->cmsg_level = SOL_SOCKET;
+	cm->cmsg_type = SCM_RIGHTS;
+	cm->cmsg_len = CMSG_LEN(sizeof(int));
+	memcpy(CMSG_DATA(cm), &memfd, sizeof(int));
+
+	return (sendmsg(fd, &msg, 0) == sizeof(req)) ? 0 : -1;
+}
+
+// Slot `s` of the memfd: JOBD_MAX_COUNT floats in, then as many out.
+static float *slot_in(float *mem, unsigned s)
+{
+	return mem + s * 2 * JOBD_MAX_COUNT;
+}
+
+static void post(int fd, float *mem, unsigned s, unsigned id, unsigned count)
+{
+	jobd_req_t req;
+	unsigned i;
+
+	for (i = 0; i < count; i++) {
+		slot_in(mem, s)[i] = -30.0f + 60.0f * (float)rand() / (float)RAND_MAX;
+	}
+	memset(&req, 0, sizeof(req));
+	req.op = JOBD_EXP;
+	req.id = id;
+	req.count = count;
+	req.in_off = s * 2 * JOBD_MAX_COUNT * sizeof(float);
+	req.out_off = req.in_off + JOBD_MAX_COUNT * sizeof(float);
+	send(fd, &req, sizeof(req), 0);
+}
+
+static int run_client(const opts_t *o, unsigned index)
+{
+	const size_t size = o->depth * 2 * JOBD_MAX_COUNT * sizeof(float);
+	unsigned count[MAX_DEPTH];
+	double t_sent[MAX_DEPTH];
+	double rtt_sum = 0.0, rtt_max = 0.0, queue_sum = 0.0;
+	unsigned sent = 0, done = 0, errors = 0, s;
+	float max_diff = 0.0f;
+	float *mem;
+	int memfd, fd;
+
+	srand(index + 1);
+	memfd = memfd_create("jobd", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+	if ((memfd < 0) || (ftruncate(memfd, size) != 0) ||
+	    (fcntl(memfd, F_ADD_SEALS, F_SEAL_SHRINK) != 0)) {
+		perror("??? memfd");
+		return EXIT_FAILURE;
+	}
+	mem = (float *)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+			    memfd, 0);
+	if ((mem == MAP_FAILED) || ((fd = connect_to(o->path)) < 0) ||
+	    (send_hello(fd, memfd, size) != 0)) {
+		return EXIT_FAILURE;
+	}
+	close(memfd);
+
+	// The request id is its slot, every reply frees one.
+	for (s = 0; (s < o->depth) && (sent < o->nreqs); s++, sent++) {
+		count[s] = 16 + rand() % (o->max_count - 15);
+		t_sent[s] = now_usec();
+		post(fd, mem, s, s, count[s]);
+	}
+	while (done < sent) {
+		jobd_reply_t r;
+		const float *x, *y;
+		double rtt;
+		unsigned i;
+
+		if (recv(fd, &r, sizeof(r), 0) != sizeof(r)) {
+			fprintf(stderr, "??? client %u: daemon went away\n", index);
+			return EXIT_FAILURE;
+		}
+		s = r.id;
+		rtt = now_usec() - t_sent[s];
+		rtt_sum += rtt;
+		rtt_max = (rtt > rtt_max) ? rtt : rtt_max;
+		queue_sum += r.queue_usec;
+		done++;
+
+		x = slot_in(mem, s);
+		y = x + JOBD_MAX_COUNT;
+		errors += (r.status != JOBD_OK);
+		for (i = 0; (r.status == JOBD_OK) && (i < count[s]); i++) {
+			float ref = expf(x[i]);
+			float diff = fabsf(ref - y[i]) / ref;
+			max_diff = (diff > max_diff) ? diff : max_diff;
+		}
+
+		if (sent < o->nreqs) {
+			count[s] = 16 + rand() % (o->max_count - 15);
+			t_sent[s] = now_usec();
+			post(fd, mem, s, s, count[s]);
+			sent++;
+		}
+	}
+	close(fd);
+
+	fprintf(stderr, "[jobd_client] %u: %u requests, round trip ave = %.1f "
+			"us, max = %.1f us, daemon queueing ave = %.1f us, "
+			"max rel. diff = %e, %u failed\n",
+		index, done, rtt_sum / done, rtt_max, queue_sum / done, max_diff,
+		errors);
+	return (errors || (max_diff > 5e-6f)) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[])
+{
+	opts_t o = { 4, 1000, 4, 256, JOBD_SOCKET };
+	int shutdown = 0, failed = 0, status, i;
+	unsigned c;
+	double t0, usec;
+
+	for (i = 1; i < argc; i++) {
+		if ((strcmp(argv[i], "-c") == 0) && (i + 1 < argc)) {
+			o.nclients = (unsigned)atoi(argv[++i]);
+		} else if ((strcmp(argv[i], "-n") == 0) && (i + 1 < argc)) {
+			o.nreqs = (unsigned)atoi(argv[++i]);
+		} else if ((strcmp(argv[i], "-d") == 0) && (i + 1 < argc)) {
+			o.depth = (unsigned)atoi(argv[++i]);
+		} else if ((strcmp(argv[i], "-m") == 0) && (i + 1 < argc)) {
+			o.max_count = (unsigned)atoi(argv[++i]);
+		} else if (strcmp(argv[i], "-s") == 0) {
+			shutdown = 1;
+		} else {
+			o.path = argv[i];
+		}
+	}
+	o.nclients = (o.nclients > JOBD_MAX_CLIENTS) ? JOBD_MAX_CLIENTS
+						     : o.nclients;
+	o.depth = (o.depth < 1) ? 1 : (o.depth > MAX_DEPTH) ? MAX_DEPTH : o.depth;
+	o.max_count = (o.max_count < 16) ? 16
+		      : (o.max_count > JOBD_MAX_COUNT) ? JOBD_MAX_COUNT
+						       : o.max_count;
+
+	t0 = now_usec();
+	for (c = 0; c < o.nclients; c++) {
+		if (fork() == 0) {
+			exit(run_client(&o, c));
+		}
+	}
+	for (c = 0; c < o.nclients; c++) {
+		wait(&status);
+		failed += !WIFEXITED(status) || (WEXITSTATUS(status) != 0);
+	}
+	usec = now_usec() - t0;
+
+	fprintf(stderr, "[jobd_client] %u clients x %u requests of 16..%u "
+			"floats, depth %u: %.1f ms, %.1f requests/s, %d "
+			"clients failed\n",
+		o.nclients, o.nreqs, o.max_count, o.depth, usec * 1e-3,
+		o.nclients * o.nreqs * 1e6 / usec, failed);
+
+	if (shutdown) {
+		jobd_req_t req;
+		int fd = connect_to(o.path);
+
+		memset(&req, 0, sizeof(req));
+		req.op = JOBD_SHUTDOWN;
+		if (fd >= 0) {
+			send(fd, &req, sizeof(req), 0);
+			close(fd);
+		}
+	}
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,248 @@
+//
+// Memory hierarchy microbenchmark, e-core side. Runs on core (0, 0) only.
+//
+// For every transfer size in MEMBENCH_SIZES, the best of MEMBENCH_REPEAT runs
+// of a plain load/store loop or one e_dma_copy():
+//
+//   local  : word loads from each bank, 8 byte loads(ldrd), unaligned word
+//            loads(no hardware support, the compiler emits byte loads) and
+//            word stores
+//   remote : word loads and stores to bank 2 of the cores 1..N mesh hops
+//            away. Stores are posted, so they measure the issue rate.
+//   dram   : direct loads/stores vs. DMA to and from shared DRAM
+//
+// Latency is a chain of MEMBENCH_CHASE dependent loads(p = buf[p]) through
+// the same memory, loop overhead included. Results go to shared DRAM
+// (membench_result_t), host.c prints them next to e_read()/e_write().
+//
+#include <stdlib.h>
+#include <string.h>
+
+#include "e_lib.h"
+
+#include "e_banks.h"
+#include "e_shm.h"
+#include "membench.h"
+
+#define MEMBENCH_REPEAT (8)
+#define MEMBENCH_CHASE (64)
+#define MEMBENCH_STRIDE (37) // words between chained loads, odd
+
+enum {
+	MEMBENCH_LOAD = 0,
+	MEMBENCH_LOAD_DWORD,
+	MEMBENCH_LOAD_UNALIGNED,
+	MEMBENCH_STORE,
+	MEMBENCH_DMA_LOAD,  // from the buffer into local bank 1
+	MEMBENCH_DMA_STORE, // from local bank 1 into the buffer
+};
+
+typedef struct __attribute__((packed)) {
+	unsigned int v;
+} unaligned_t;
+
+// Bank 0 is shared with the code, its buffer goes wherever the linker puts
+// .data_bank0.
+static E_CORE_LOCAL unsigned long long bank0[MEMBENCH_BUF_BYTES / 8]
+	SECTION(".data_bank0");
+
+static const unsigned int gSizes[MEMBENCH_NUM_SIZES] = MEMBENCH_SIZES;
+static unsigned int gTimeCompare;
+static volatile unsigned int gSink;
+
+static unsigned int clock_start(void)
+{
+	e_ctimer_set(E_CTIMER_0, E_CTIMER_MAX);
+	e_ctimer_start(E_CTIMER_0, E_CTIMER_CLK);
+	return e_ctimer_get(E_CTIMER_0);
+}
+
+static unsigned int clock_stop(unsigned int time_p)
+{
+	const unsigned int time_c = e_ctimer_get(E_CTIMER_0);
+	e_ctimer_stop(E_CTIMER_0);
+	time_p -= time_c;
+	return (time_p > gTimeCompare) ? time_p - gTimeCompare : 0;
+}
+
+static unsigned int run_once(int kind, void *buf, unsigned int bytes)
+{
+	volatile unsigned int *w = (volatile unsigned int *)buf;
+	volatile unsigned long long *d = (volatile unsigned long long *)buf;
+	volatile unaligned_t *u = (volatile unaligned_t *)((char *)buf + 1);
+	void *local = E_LOCAL_PTR(MEMBENCH_BANK1_ADDR);
+	unsigned int sum = 0;
+	unsigned int i, time_p, clocks;
+
+	time_p = clock_start();
+	switch (kind) {
+	case MEMBENCH_LOAD:
+		for (i = 0; i < bytes / 4; i++) {
+			sum += w[i];
+		}
+		break;
+	case MEMBENCH_LOAD_DWORD:
+		for (i = 0; i < bytes / 8; i++) {
+			sum += (unsigned int)d[i];
+		}
+		break;
+	case MEMBENCH_LOAD_UNALIGNED:
+		for (i = 0; i < bytes / 4; i++) {
+			sum += u[i].v;
+		}
+		break;
+	case MEMBENCH_STORE:
+		for (i = 0; i < bytes / 4; i++) {
+			w[i] = i;
+		}
+		break;
+	case MEMBENCH_DMA_LOAD:
+		e_dma_copy(local, buf, bytes);
+		break;
+	case MEMBENCH_DMA_STORE:
+		e_dma_copy(buf, local, bytes);
+		break;
+	}
+	clocks = clock_stop(time_p);
+
+	gSink = sum;
+	return clocks;
+}
+
+static unsigned int chase(void *buf)
+{
+	volatile unsigned int *w = (volatile unsigned int *)buf;
+	const unsigned int n = MEMBENCH_MAX_BYTES / 4;
+	unsigned int best = E_CTIMER_MAX;
+	unsigned int i, r, p, time_p, clocks;
+
+	for (i = 0; i < n; i++) {
+		w[i] = (i + MEMBENCH_STRIDE) % n;
+	}
+	for (r = 0; r < MEMBENCH_REPEAT; r++) {
+		p = 0;
+		time_p = clock_start();
+		for (i = 0; i < MEMBENCH_CHASE; i++) {
+			p = w[p];
+		}
+		clocks = clock_stop(time_p);
+		gSink = p;
+		best = (clocks < best) ? clocks : best;
+	}
+	return best / MEMBENCH_CHASE;
+}
+
+// `name` plus an optional hop count, e.g. "remote h3 ldr".
+static membench_row_t *add_row(membench_result_t *res, const char *prefix,
+			       int hops, const char *name)
+{
+	membench_row_t *row = &res->rows[res->num_rows++];
+	char *s = row->name;
+
+	strcpy(s, prefix);
+	s += strlen(s);
+	if (hops >= 0) {
+		*s++ = ' ';
+		*s++ = 'h';
+		if (hops >= 10) {
+			*s++ = '0' + hops / 10;
+		}
+		*s++ = '0' + hops % 10;
+	}
+	*s++ = ' ';
+	strcpy(s, name);
+	row->latency = 0;
+	return row;
+}
+
+static void measure(membench_row_t *row, int kind, void *buf)
+{
+	unsigned int k, r, clocks;
+
+	for (k = 0; k < MEMBENCH_NUM_SIZES; k++) {
+		row->clocks[k] = E_CTIMER_MAX;
+		for (r = 0; r < MEMBENCH_REPEAT; r++) {
+			clocks = run_once(kind, buf, gSizes[k]);
+			row->clocks[k] =
+				(clocks < row->clocks[k]) ? clocks : row->clocks[k];
+		}
+	}
+}
+
+int main(void)
+{
+	membench_result_t *res =
+		(membench_result_t *)E_SHM_PTR(E_SHM_MSG_OFFSET);
+	void *bank[4];
+	unsigned int time_p, time_c, rows, cols, h;
+	int b;
+
+	if ((e_group_config.core_row != 0) || (e_group_config.core_col != 0)) {
+		return EXIT_SUCCESS;
+	}
+	rows = e_group_config.group_rows;
+	cols = e_group_config.group_cols;
+
+	res->num_rows = 0;
+	res->done = 0;
+
+	// Get time waste on functions
+	e_ctimer_set(E_CTIMER_0, E_CTIMER_MAX);
+	time_p = e_ctimer_start(E_CTIMER_0, E_CTIMER_CLK);
+	time_c = e_ctimer_get(E_CTIMER_0);
+	e_ctimer_stop(E_CTIMER_0);
+	gTimeCompare = time_p - time_c;
+
+	bank[0] = bank0;
+	bank[1] = E_LOCAL_PTR(MEMBENCH_BANK1_ADDR);
+	bank[2] = E_LOCAL_PTR(MEMBENCH_BANK2_ADDR);
+	bank[3] = E_LOCAL_PTR(MEMBENCH_BANK3_ADDR);
+
+	for (b = 0; b < 4; b++) {
+		static const char *names[4] = {"local b0", "local b1",
+					       "local b2", "local b3"};
+		membench_row_t *row = add_row(res, names[b], -1, "ldr");
+		measure(row, MEMBENCH_LOAD, bank[b]);
+		row->latency = chase(bank[b]);
+	}
+	measure(add_row(res, "local b2", -1, "ldrd"), MEMBENCH_LOAD_DWORD,
+		bank[2]);
+	measure(add_row(res, "local b2", -1, "unaligned"),
+		MEMBENCH_LOAD_UNALIGNED, bank[2]);
+	measure(add_row(res, "local b2", -1, "str"), MEMBENCH_STORE, bank[2]);
+
+	// Targets walk the diagonal, (h / 2, h - h / 2) is h hops away.
+	for (h = 1; h <= rows + cols - 2; h++) {
+		unsigned int r = h / 2;
+		unsigned int c = h - r;
+		void *remote;
+		membench_row_t *row;
+
+		if (c >= cols) {
+			c = cols - 1;
+			r = h - c;
+		}
+		remote = e_get_global_address(r, c, bank[2]);
+		row = add_row(res, "remote", h, "ldr");
+		measure(row, MEMBENCH_LOAD, remote);
+		row->latency = chase(remote);
+		measure(add_row(res, "remote", h, "str"), MEMBENCH_STORE,
+			remote);
+	}
+
+	{
+		void *dram = E_SHM_PTR(E_SHM_DATA_OFFSET);
+		membench_row_t *row = add_row(res, "dram", -1, "ldr");
+		measure(row, MEMBENCH_LOAD, dram);
+		row->latency = chase(dram);
+		measure(add_row(res, "dram", -1, "str"), MEMBENCH_STORE, dram);
+		measure(add_row(res, "dram", -1, "dma load"), MEMBENCH_DMA_LOAD,
+			dram);
+		measure(add_row(res, "dram", -1, "dma store"),
+			MEMBENCH_DMA_STORE, dram);
+	}
+
+	res->done = 1;
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,144 @@
+//
+// HOST side of the memory hierarchy microbenchmark(e_membench.c).
+//
+// Times e_read()/e_write() against core local memory and shared DRAM, runs
+// the e-core side on core (0, 0) and prints both as one table: clocks per
+// transfer and bytes/clock for the e-core rows, us per call and MB/s for the
+// host rows.
+//
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <e-hal.h>
+
+#include "e_shm.h"
+#include "membench.h"
+
+#define HOST_REPEAT (64)
+#define WAIT_DONE_MICROSECONDS (10000000)
+
+static double now_usec(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec * 1e-3;
+}
+
+static const unsigned gSizes[MEMBENCH_NUM_SIZES] = MEMBENCH_SIZES;
+
+// us per call, best of HOST_REPEAT.
+static double host_once(void *dev, unsigned row, unsigned col, off_t addr,
+			char *buf, unsigned bytes, int write)
+{
+	double best = 1e30;
+	unsigned r;
+
+	for (r = 0; r < HOST_REPEAT; r++) {
+		double t0 = now_usec();
+		if (write) {
+			e_write(dev, row, col, addr, buf, bytes);
+		} else {
+			e_read(dev, row, col, addr, buf, bytes);
+		}
+		t0 = now_usec() - t0;
+		best = (t0 < best) ? t0 : best;
+	}
+	return best;
+}
+
+static void host_row(const char *name, void *dev, unsigned row, unsigned col,
+		     off_t addr, int write)
+{
+	static char buf[MEMBENCH_MAX_BYTES];
+	unsigned k;
+
+	fprintf(stderr, "%-20s %8s |", name, "-");
+	for (k = 0; k < MEMBENCH_NUM_SIZES; k++) {
+		const double us =
+			host_once(dev, row, col, addr, buf, gSizes[k], write);
+		fprintf(stderr, " %7.2fus(%6.1f)", us,
+			(us > 0.0) ? gSizes[k] / us : 0.0);
+	}
+	fprintf(stderr, "\n");
+}
+
+static void core_row(const membench_row_t *row)
+{
+	unsigned k;
+
+	if (row->latency) {
+		fprintf(stderr, "%-20s %8u |", row->name, row->latency);
+	} else {
+		fprintf(stderr, "%-20s %8s |", row->name, "-");
+	}
+	for (k = 0; k < MEMBENCH_NUM_SIZES; k++) {
+		const unsigned c = row->clocks[k];
+		fprintf(stderr, " %9u(%6.2f)", c,
+			c ? (double)gSizes[k] / c : 0.0);
+	}
+	fprintf(stderr, "\n");
+}
+
+int main(int argc, char *argv[])
+{
+	e_platform_t platform;
+	e_epiphany_t dev;
+	e_mem_t msg, data;
+	membench_result_t *res;
+	const unsigned tr = 1, tc = 1; // host target core
+	double t0;
+	unsigned i, k;
+
+	e_init(NULL);
+	e_reset_system();
+	e_get_platform_info(&platform);
+
+	e_alloc(&msg, E_SHM_MSG_OFFSET, sizeof(membench_result_t));
+	e_alloc(&data, E_SHM_DATA_OFFSET, MEMBENCH_BUF_BYTES);
+	res = (membench_result_t *)msg.base;
+	memset(res, 0, sizeof(*res));
+
+	e_open(&dev, 0, 0, platform.rows, platform.cols);
+
+	fprintf(stderr, "[membench] %u x %u cores\n", platform.rows,
+		platform.cols);
+	fprintf(stderr, "%-20s %8s |", "host", "");
+	for (k = 0; k < MEMBENCH_NUM_SIZES; k++) {
+		fprintf(stderr, " %8u B(  MB/s)", gSizes[k]);
+	}
+	fprintf(stderr, "\n");
+	host_row("e_write core", &dev, tr, tc, MEMBENCH_BANK2_ADDR, 1);
+	host_row("e_read core", &dev, tr, tc, MEMBENCH_BANK2_ADDR, 0);
+	host_row("e_write dram", &data, 0, 0, 0, 1);
+	host_row("e_read dram", &data, 0, 0, 0, 0);
+
+	e_load((argc > 1) ? argv[1] : "e_membench.srec", &dev, 0, 0, E_TRUE);
+
+	t0 = now_usec();
+	while (!res->done) {
+		if (now_usec() - t0 > WAIT_DONE_MICROSECONDS) {
+			fprintf(stderr, "??? core (0, 0) did not finish\n");
+			return EXIT_FAILURE;
+		}
+		usleep(1000);
+	}
+
+	fprintf(stderr, "%-20s %8s |", "e-core (0, 0)", "latency");
+	for (k = 0; k < MEMBENCH_NUM_SIZES; k++) {
+		fprintf(stderr, " %8u B( B/clk)", gSizes[k]);
+	}
+	fprintf(stderr, "\n");
+	for (i = 0; (i < res->num_rows) && (i < MEMBENCH_MAX_ROWS); i++) {
+		core_row(&res->rows[i]);
+	}
+
+	e_close(&dev);
+	e_free(&data);
+	e_free(&msg);
+	e_finalize();
+
+	return 0;
+}
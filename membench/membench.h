@@ -0,0 +1,38 @@
+//
+// Memory hierarchy microbenchmark, shared by the e-core program
+// (e_membench.c) and host.c.
+//
+#ifndef MEMBENCH_H_
+#define MEMBENCH_H_
+
+// Transfer sizes in bytes, one table column each.
+#define MEMBENCH_NUM_SIZES (4)
+#define MEMBENCH_SIZES {8, 64, 512, 2048}
+#define MEMBENCH_MAX_BYTES (2048)
+#define MEMBENCH_BUF_BYTES (MEMBENCH_MAX_BYTES + 8) // room for unaligned reads
+
+// Local buffers at fixed addresses, so the host(e_read()/e_write()) and
+// other cores(e_get_global_address()) find them at the same place. The
+// program keeps nothing else in banks 1-3; bank 3 leaves the mailbox below
+// and the stack above.
+#define MEMBENCH_BANK1_ADDR (0x2000)
+#define MEMBENCH_BANK2_ADDR (0x4000)
+#define MEMBENCH_BANK3_ADDR (0x6400)
+
+#define MEMBENCH_MAX_ROWS (48) // 2 * 14 hops on a 64 core chip + 11
+#define MEMBENCH_NAME_LEN (20)
+
+typedef struct {
+	char name[MEMBENCH_NAME_LEN];
+	unsigned int latency; // clocks per dependent load, 0 if not measured
+	unsigned int clocks[MEMBENCH_NUM_SIZES]; // per transfer, best of runs
+} membench_row_t;
+
+// Written by core (0, 0) at E_SHM_MSG_OFFSET, `done` last.
+typedef struct {
+	unsigned int num_rows;
+	unsigned int done;
+	membench_row_t rows[MEMBENCH_MAX_ROWS];
+} membench_result_t;
+
+#endif // MEMBENCH_H_
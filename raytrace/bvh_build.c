@@ -0,0 +1,219 @@
+//
+// Binary BVH builder, host side.
+//
+// Binned SAH over triangle centroids on the widest centroid axis, median
+// split when all centroids fall into one bin. Nodes are emitted in
+// breadth-first order: node i keeps its triangle range in first/count until
+// it is visited, children are appended to the end of the array.
+//
+#include <float.h>
+#include <string.h>
+
+#include "raytrace.h"
+
+#define BVH_NUM_BINS (16)
+
+typedef struct {
+	float bbox[2][3];
+	unsigned int count;
+} bvh_bin_t;
+
+static void bbox_empty(float bbox[2][3])
+{
+	int k;
+	for (k = 0; k < 3; k++) {
+		bbox[0][k] = FLT_MAX;
+		bbox[1][k] = -FLT_MAX;
+	}
+}
+
+static void bbox_grow(float bbox[2][3], const float p[3])
+{
+	int k;
+	for (k = 0; k < 3; k++) {
+		bbox[0][k] = (p[k] < bbox[0][k]) ? p[k] : bbox[0][k];
+		bbox[1][k] = (p[k] > bbox[1][k]) ? p[k] : bbox[1][k];
+	}
+}
+
+static void bbox_merge(float bbox[2][3], const float other[2][3])
+{
+	bbox_grow(bbox, other[0]);
+	bbox_grow(bbox, other[1]);
+}
+
+static float bbox_area(const float bbox[2][3])
+{
+	float dx = bbox[1][0] - bbox[0][0];
+	float dy = bbox[1][1] - bbox[0][1];
+	float dz = bbox[1][2] - bbox[0][2];
+	if (dx < 0.0f) {
+		return 0.0f;
+	}
+	return dx * dy + dy * dz + dz * dx;
+}
+
+static void tri_bbox(float bbox[2][3], const triangle_t *tri)
+{
+	float p[3];
+	int k;
+
+	bbox_empty(bbox);
+	bbox_grow(bbox, tri->v0);
+	for (k = 0; k < 3; k++) {
+		p[k] = tri->v0[k] + tri->e1[k];
+	}
+	bbox_grow(bbox, p);
+	for (k = 0; k < 3; k++) {
+		p[k] = tri->v0[k] + tri->e2[k];
+	}
+	bbox_grow(bbox, p);
+}
+
+static float tri_centroid(const triangle_t *tri, int axis)
+{
+	return tri->v0[axis] + (tri->e1[axis] + tri->e2[axis]) * (1.0f / 3.0f);
+}
+
+static void swap_tris(triangle_t *a, triangle_t *b)
+{
+	triangle_t t = *a;
+	*a = *b;
+	*b = t;
+}
+
+// Returns the number of triangles in the left half, 0 if the range should
+// stay a leaf.
+static unsigned int split(triangle_t *tris, unsigned int count)
+{
+	float cbox[2][3];
+	bvh_bin_t bins[BVH_NUM_BINS];
+	float right_area[BVH_NUM_BINS];
+	unsigned int right_count[BVH_NUM_BINS];
+	float box[2][3], extent, scale, best_cost, leaf_cost;
+	unsigned int i, n, left, best_bin;
+	int axis, b;
+
+	bbox_empty(cbox);
+	for (i = 0; i < count; i++) {
+		float c[3];
+		for (axis = 0; axis < 3; axis++) {
+			c[axis] = tri_centroid(&tris[i], axis);
+		}
+		bbox_grow(cbox, c);
+	}
+	axis = 0;
+	for (b = 1; b < 3; b++) {
+		if (cbox[1][b] - cbox[0][b] > cbox[1][axis] - cbox[0][axis]) {
+			axis = b;
+		}
+	}
+	extent = cbox[1][axis] - cbox[0][axis];
+
+	if (extent > 0.0f) {
+		scale = BVH_NUM_BINS * (1.0f - 1.0e-6f) / extent;
+		for (b = 0; b < BVH_NUM_BINS; b++) {
+			bbox_empty(bins[b].bbox);
+			bins[b].count = 0;
+		}
+		for (i = 0; i < count; i++) {
+			float tb[2][3];
+			b = (int)((tri_centroid(&tris[i], axis) - cbox[0][axis]) *
+				  scale);
+			tri_bbox(tb, &tris[i]);
+			bbox_merge(bins[b].bbox, tb);
+			bins[b].count++;
+		}
+
+		// Sweep from the right, then from the left.
+		bbox_empty(box);
+		n = 0;
+		for (b = BVH_NUM_BINS - 1; b > 0; b--) {
+			bbox_merge(box, bins[b].bbox);
+			n += bins[b].count;
+			right_area[b] = bbox_area(box);
+			right_count[b] = n;
+		}
+		bbox_empty(box);
+		n = 0;
+		best_cost = FLT_MAX;
+		best_bin = 0;
+		for (b = 1; b < BVH_NUM_BINS; b++) {
+			float cost;
+			bbox_merge(box, bins[b - 1].bbox);
+			n += bins[b - 1].count;
+			if ((n == 0) || (right_count[b] == 0)) {
+				continue;
+			}
+			cost = bbox_area(box) * n + right_area[b] * right_count[b];
+			if (cost < best_cost) {
+				best_cost = cost;
+				best_bin = b;
+			}
+		}
+
+		if (best_bin != 0) {
+			// Small ranges stay leaves unless the split pays off.
+			bbox_merge(box, bins[BVH_NUM_BINS - 1].bbox);
+			leaf_cost = bbox_area(box) * count;
+			if ((count <= BVH_MAX_LEAF_SIZE) &&
+			    (best_cost + bbox_area(box) >= leaf_cost)) {
+				return 0;
+			}
+
+			left = 0;
+			for (i = 0; i < count; i++) {
+				b = (int)((tri_centroid(&tris[i], axis) -
+					   cbox[0][axis]) *
+					  scale);
+				if ((unsigned int)b < best_bin) {
+					swap_tris(&tris[left++], &tris[i]);
+				}
+			}
+			return left;
+		}
+	}
+
+	// Coincident centroids: the SAH can't separate them.
+	return (count <= BVH_MAX_LEAF_SIZE) ? 0 : count / 2;
+}
+
+unsigned int bvh_build(bvh_node_t *nodes, triangle_t *tris,
+		       unsigned int num_tris)
+{
+	unsigned int num_nodes = 1;
+	unsigned int i, k;
+
+	memset(nodes, 0, sizeof(bvh_node_t));
+	nodes[0].first = 0;
+	nodes[0].count = num_tris;
+
+	for (i = 0; i < num_nodes; i++) {
+		bvh_node_t *node = &nodes[i];
+		const unsigned int first = node->first;
+		const unsigned int count = node->count;
+		unsigned int left;
+
+		bbox_empty(node->bbox);
+		for (k = first; k < first + count; k++) {
+			float tb[2][3];
+			tri_bbox(tb, &tris[k]);
+			bbox_merge(node->bbox, tb);
+		}
+
+		left = (count > 1) ? split(tris + first, count) : 0;
+		if (left == 0) {
+			continue;
+		}
+
+		nodes[num_nodes].first = first;
+		nodes[num_nodes].count = left;
+		nodes[num_nodes + 1].first = first + left;
+		nodes[num_nodes + 1].count = count - left;
+		node->first = num_nodes;
+		node->count = 0;
+		num_nodes += 2;
+	}
+
+	return num_nodes;
+}
@@ -0,0 +1,113 @@
+//
+// Collapses a binary BVH(bvh_build.c) into 4 or 8 wide nodes, host side.
+//
+// Each wide node takes the children of one binary node and keeps opening the
+// inner child with the largest surface area until `width` children are
+// gathered or only leaves remain, so every fetch on the e-core brings in up
+// to `width` boxes for one ray_aabb4() per 4 of them.
+//
+// Wide nodes are emitted in breadth-first order with the same trick as
+// bvh_build(): a wide node is allocated with its binary node index parked in
+// child[0] and filled in when visited.
+//
+#include <float.h>
+
+#include "raytrace.h"
+
+#define BVH_WIDE_MAX (8)
+
+static float bbox_area(const float bbox[2][3])
+{
+	float dx = bbox[1][0] - bbox[0][0];
+	float dy = bbox[1][1] - bbox[0][1];
+	float dz = bbox[1][2] - bbox[0][2];
+	return dx * dy + dy * dz + dz * dx;
+}
+
+// bvh4_node_t and bvh8_node_t are float bbox[2][3][width] followed by
+// unsigned int child[width].
+static float *wide_bbox(void *out, unsigned int width, unsigned int i)
+{
+	return (float *)out + i * 7 * width;
+}
+
+static unsigned int *wide_child(void *out, unsigned int width, unsigned int i)
+{
+	return (unsigned int *)out + i * 7 * width + 6 * width;
+}
+
+unsigned int bvh_collapse(void *out, unsigned int width,
+			  const bvh_node_t *nodes)
+{
+	unsigned int num_wide = 1;
+	unsigned int i;
+
+	*wide_child(out, width, 0) = 0;
+
+	for (i = 0; i < num_wide; i++) {
+		float *bbox = wide_bbox(out, width, i);
+		unsigned int *child = wide_child(out, width, i);
+		const bvh_node_t *root = &nodes[child[0]];
+		unsigned int open[BVH_WIDE_MAX];
+		unsigned int n, k, a;
+
+		// A leaf root(tiny scene) becomes the only child.
+		if (root->count) {
+			open[0] = child[0];
+			n = 1;
+		} else {
+			open[0] = root->first;
+			open[1] = root->first + 1;
+			n = 2;
+		}
+
+		while (n < width) {
+			int best = -1;
+			float best_area = -1.0f;
+			for (k = 0; k < n; k++) {
+				const bvh_node_t *c = &nodes[open[k]];
+				if ((c->count == 0) &&
+				    (bbox_area(c->bbox) > best_area)) {
+					best_area = bbox_area(c->bbox);
+					best = (int)k;
+				}
+			}
+			if (best < 0) {
+				break;
+			}
+			{
+				const unsigned int first = nodes[open[best]].first;
+				open[best] = first;
+				open[n++] = first + 1;
+			}
+		}
+
+		for (k = 0; k < width; k++) {
+			if (k >= n) {
+				for (a = 0; a < 3; a++) {
+					bbox[(0 * 3 + a) * width + k] = FLT_MAX;
+					bbox[(1 * 3 + a) * width + k] = -FLT_MAX;
+				}
+				child[k] = BVH_WIDE_EMPTY;
+				continue;
+			}
+			{
+				const bvh_node_t *c = &nodes[open[k]];
+				for (a = 0; a < 3; a++) {
+					bbox[(0 * 3 + a) * width + k] = c->bbox[0][a];
+					bbox[(1 * 3 + a) * width + k] = c->bbox[1][a];
+				}
+				if (c->count) {
+					child[k] = BVH_WIDE_LEAF |
+						   (c->count << 24) | c->first;
+				} else {
+					*wide_child(out, width, num_wide) =
+						open[k];
+					child[k] = num_wide++;
+				}
+			}
+		}
+	}
+
+	return num_wide;
+}
@@ -0,0 +1,94 @@
+//
+// Quantized leaf encoder, host side. See qleaf_t in raytrace.h.
+//
+// Vertices are rounded to 16 bits inside the leaf bounds, so the decoded
+// triangles stay inside the boxes the BVH was built with. Vertices which
+// round to the same point are stored once per leaf, which is what makes
+// meshes(a grid: ~1 unique vertex per triangle) cheaper than triangle soup.
+//
+#include <string.h>
+
+#include "raytrace.h"
+
+static unsigned short quantize(float x, float org, float scale)
+{
+	float q = (scale > 0.0f) ? (x - org) / scale + 0.5f : 0.0f;
+	q = (q < 0.0f) ? 0.0f : q;
+	q = (q > 65535.0f) ? 65535.0f : q;
+	return (unsigned short)q;
+}
+
+// Index of vertex q in vert[0, *nv), appended if new.
+static unsigned int find_vert(unsigned short (*vert)[3], unsigned int *nv,
+			      const unsigned short q[3])
+{
+	unsigned int i;
+
+	for (i = 0; i < *nv; i++) {
+		if ((vert[i][0] == q[0]) && (vert[i][1] == q[1]) &&
+		    (vert[i][2] == q[2])) {
+			return i;
+		}
+	}
+	memcpy(vert[i], q, sizeof(vert[i]));
+	(*nv)++;
+	return i;
+}
+
+unsigned int bvh_quantize(void *out, bvh_node_t *nodes,
+			  unsigned int num_nodes, const triangle_t *tris)
+{
+	unsigned char *base = (unsigned char *)out;
+	unsigned int bytes = 0;
+	unsigned int i, k, j;
+
+	for (i = 0; i < num_nodes; i++) {
+		bvh_node_t *node = &nodes[i];
+		qleaf_t *leaf = (qleaf_t *)(base + bytes);
+		unsigned short vert[QLEAF_MAX_VERTS][3];
+		unsigned short *idx;
+		unsigned int nv = 0;
+
+		if (node->count == 0) {
+			continue;
+		}
+
+		for (k = 0; k < 3; k++) {
+			leaf->org[k] = node->bbox[0][k];
+			leaf->scale[k] =
+				(node->bbox[1][k] - node->bbox[0][k]) / 65535.0f;
+		}
+
+		idx = (unsigned short *)(leaf + 1) + 3 * QLEAF_MAX_VERTS;
+		for (j = 0; j < node->count; j++) {
+			const triangle_t *tri = &tris[node->first + j];
+			unsigned int t = 0;
+			for (k = 0; k < 3; k++) {
+				unsigned short q[3];
+				int a;
+				for (a = 0; a < 3; a++) {
+					float x = tri->v0[a];
+					x += (k == 1) ? tri->e1[a] : 0.0f;
+					x += (k == 2) ? tri->e2[a] : 0.0f;
+					q[a] = quantize(x, leaf->org[a],
+							leaf->scale[a]);
+				}
+				t |= find_vert(vert, &nv, q) << (4 * k);
+			}
+			idx[j] = (unsigned short)t;
+		}
+
+		// Vertices go right after the header, then the indices which
+		// were staged past the largest vertex array.
+		leaf->num_verts = (unsigned short)nv;
+		leaf->num_tris = (unsigned short)node->count;
+		memcpy(leaf + 1, vert, 6 * nv);
+		memmove((unsigned short *)(leaf + 1) + 3 * nv, idx,
+			2 * node->count);
+
+		node->first = bytes / 4;
+		bytes += (sizeof(qleaf_t) + 6 * nv + 2 * node->count + 3) & ~3u;
+	}
+
+	return bytes;
+}
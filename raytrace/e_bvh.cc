@@ -0,0 +1,794 @@
+//
+// BVH traversal kernels.
+//
+// The top of the tree(nodes [0, num_local), see bvh_build.c) is read from
+// local memory, the rest and all triangles straight from shared DRAM.
+//
+// bvh_closest() keeps the nearest hit, visits the nearer child first and
+// skips boxes entered beyond it. bvh_occluded() is for shadow rays: it stops
+// at the first hit, pushes children in stored order and only uses the
+// yes/no tests(ray_aabb_hit(), ray_triangle_hit()).
+//
+// bvh4_*()/bvh8_*() walk the wide trees from bvh_collapse.c. One node fetch
+// brings in 4/8 child boxes, tested with one ray_aabb4() per 4. In every
+// closest hit kernel stack entries carry the entry distance, so they can be
+// dropped without refetching. Every shared DRAM node read goes through
+// dram_fetch(), so the cache and the fetch/byte counts cover all widths.
+//
+// Leaves are float triangles or quantized blocks(bvh_quantize.c), decoded on
+// every visit into local triangles for the same tests.
+//
+// scene_closest()/scene_occluded() pick the kernel for a scene's width and
+// leaf format. With a node cache in the view, children beyond the local top
+// go through it for the duration of the call, so rays traced one after the
+// other in the same part of the tree only fetch what the previous ones
+// didn't leave behind.
+//
+// SCENE_INSTANCES runs the same kernels over the top level tree with instance
+// leaves: each one moves the ray into object space and calls the bottom level
+// kernel, with the hit distance so far as its maxT.
+//
+#include <string.h>
+
+#include "e_banks.h"
+#include "raytrace.h"
+
+// Cache of the scene_*() call in progress, NULL otherwise.
+static E_CORE_LOCAL bvh_cache_t *cur_cache;
+
+void bvh_cache_clear(bvh_cache_t *cache)
+{
+	memset(cache->tag, 0, sizeof(cache->tag));
+}
+
+// Lines are a power of 2, so no division.
+template <class Node> static inline unsigned int cache_lines()
+{
+	return (sizeof(Node) <= BVH_CACHE_BYTES / 64)	? 64
+	       : (sizeof(Node) <= BVH_CACHE_BYTES / 16) ? 16
+							: 8;
+}
+
+// Node i >= num_local, counting the shared DRAM reads. Two consecutive nodes
+// never share a line, so both children of a binary node stay valid.
+template <class Node>
+static inline const Node *dram_fetch(unsigned int i, const Node *nodes,
+				     bvh_stats_t *st)
+{
+	bvh_cache_t *cache = cur_cache;
+	unsigned int l;
+	Node *line;
+
+	if (!cache) {
+		st->fetches++;
+		st->bytes += sizeof(Node);
+		return &nodes[i];
+	}
+	l = i & (cache_lines<Node>() - 1);
+	line = (Node *)cache->line + l;
+	if (cache->tag[l] != i + 1) {
+		memcpy(line, &nodes[i], sizeof(Node));
+		cache->tag[l] = i + 1;
+		st->fetches++;
+		st->bytes += sizeof(Node);
+	}
+	return line;
+}
+
+template <class Node>
+static inline const Node *node_fetch(unsigned int i, const Node *local,
+				     unsigned int num_local, const Node *nodes,
+				     bvh_stats_t *st)
+{
+	return (i < num_local) ? &local[i] : dram_fetch(i, nodes, st);
+}
+
+typedef struct {
+	unsigned int child; // node index or BVH_WIDE_LEAF code
+	float t;	    // entry distance
+} bvh_entry_t;
+
+static inline void bvh_stats_add(bvh_stats_t *stats, const bvh_stats_t *st)
+{
+	if (stats) {
+		stats->rays++;
+		stats->steps += st->steps;
+		stats->box_tests += st->box_tests;
+		stats->tri_tests += st->tri_tests;
+		stats->bytes += st->bytes;
+		stats->fetches += st->fetches;
+	}
+}
+
+static inline void tri_normal(float *normal, const triangle_t *tri)
+{
+	if (normal) {
+		normal[0] = tri->e1[1] * tri->e2[2] - tri->e1[2] * tri->e2[1];
+		normal[1] = tri->e1[2] * tri->e2[0] - tri->e1[0] * tri->e2[2];
+		normal[2] = tri->e1[0] * tri->e2[1] - tri->e1[1] * tri->e2[0];
+	}
+}
+
+// Leaf triangles, float. `normal` is set on every closer hit.
+struct FloatLeaves {
+	const triangle_t *tris;
+	float *normal;
+
+	// Lowers *tnear to the nearest hit among [first, first + count).
+	inline char closest(float *tnear, unsigned int first,
+			    unsigned int count, const ray_pre_t *r,
+			    bvh_stats_t *st) const
+	{
+		char hit = 0;
+		st->tri_tests += count;
+		st->bytes += count * sizeof(triangle_t);
+		for (unsigned int k = first; k < first + count; k++) {
+			float t;
+			if (ray_triangle(&t, *tnear, &tris[k], r)) {
+				*tnear = t;
+				tri_normal(normal, &tris[k]);
+				hit = 1;
+			}
+		}
+		return hit;
+	}
+
+	inline char any(float maxT, unsigned int first, unsigned int count,
+			const ray_pre_t *r, bvh_stats_t *st) const
+	{
+		for (unsigned int k = first; k < first + count; k++) {
+			st->tri_tests++;
+			st->bytes += sizeof(triangle_t);
+			if (ray_triangle_hit(maxT, &tris[k], r)) {
+				return 1;
+			}
+		}
+		return 0;
+	}
+};
+
+// Leaf triangles, quantized. `first` is the block offset in words.
+struct QuantLeaves {
+	const qleaf_t *leaves;
+	float *normal;
+
+	inline unsigned int decode(triangle_t *tri, unsigned int first,
+				   bvh_stats_t *st) const
+	{
+		const qleaf_t *leaf =
+			(const qleaf_t *)((const unsigned int *)leaves + first);
+		st->bytes += qleaf_decode(tri, leaf);
+		return leaf->num_tris;
+	}
+
+	inline char closest(float *tnear, unsigned int first,
+			    unsigned int count, const ray_pre_t *r,
+			    bvh_stats_t *st) const
+	{
+		triangle_t tri[BVH_MAX_LEAF_SIZE];
+		char hit = 0;
+		count = decode(tri, first, st);
+		st->tri_tests += count;
+		for (unsigned int k = 0; k < count; k++) {
+			float t;
+			if (ray_triangle(&t, *tnear, &tri[k], r)) {
+				*tnear = t;
+				tri_normal(normal, &tri[k]);
+				hit = 1;
+			}
+		}
+		return hit;
+	}
+
+	inline char any(float maxT, unsigned int first, unsigned int count,
+			const ray_pre_t *r, bvh_stats_t *st) const
+	{
+		triangle_t tri[BVH_MAX_LEAF_SIZE];
+		count = decode(tri, first, st);
+		for (unsigned int k = 0; k < count; k++) {
+			st->tri_tests++;
+			if (ray_triangle_hit(maxT, &tri[k], r)) {
+				return 1;
+			}
+		}
+		return 0;
+	}
+};
+
+static float blas_closest(const scene_view_t *s, const ray_pre_t *r,
+			  float maxT, float *normal, bvh_stats_t *st);
+static char blas_occluded(const scene_view_t *s, const ray_pre_t *r,
+			  float maxT, bvh_stats_t *st);
+
+// Ray moved into the object space of an instance.
+static inline void instance_ray(ray_pre_t *ro, const instance_t *in,
+				const ray_pre_t *r)
+{
+	ray_t ray;
+	for (int j = 0; j < 3; j++) {
+		const float *m = in->to_object[j];
+		ray.org[j] = m[0] * r->org[0] + m[1] * r->org[1] +
+			     m[2] * r->org[2] + m[3];
+		ray.dir[j] = m[0] * r->dir[0] + m[1] * r->dir[1] +
+			     m[2] * r->dir[2];
+	}
+	ray_setup(ro, &ray);
+}
+
+// Leaf instances(SCENE_INSTANCES). Every one traces its bottom level scene
+// with the ray in object space, `normal` is moved back to world space by the
+// transpose of to_object.
+struct InstanceLeaves {
+	const instance_t *inst;
+	const scene_view_t *blas;
+	float *normal;
+
+	inline char closest(float *tnear, unsigned int first,
+			    unsigned int count, const ray_pre_t *r,
+			    bvh_stats_t *st) const
+	{
+		char hit = 0;
+		for (unsigned int k = first; k < first + count; k++) {
+			const instance_t *in = &inst[k];
+			ray_pre_t ro;
+			float n[3];
+
+			st->bytes += sizeof(instance_t);
+			instance_ray(&ro, in, r);
+			const float t = blas_closest(&blas[in->blas], &ro, *tnear,
+						     normal ? n : 0, st);
+			if (t < 0.0f) {
+				continue;
+			}
+			*tnear = t;
+			hit = 1;
+			for (int j = 0; normal && (j < 3); j++) {
+				normal[j] = in->to_object[0][j] * n[0] +
+					    in->to_object[1][j] * n[1] +
+					    in->to_object[2][j] * n[2];
+			}
+		}
+		return hit;
+	}
+
+	inline char any(float maxT, unsigned int first, unsigned int count,
+			const ray_pre_t *r, bvh_stats_t *st) const
+	{
+		for (unsigned int k = first; k < first + count; k++) {
+			ray_pre_t ro;
+			st->bytes += sizeof(instance_t);
+			instance_ray(&ro, &inst[k], r);
+			if (blas_occluded(&blas[inst[k].blas], &ro, maxT, st)) {
+				return 1;
+			}
+		}
+		return 0;
+	}
+};
+
+// Children of an inner node, counting the shared DRAM reads.
+static inline void bvh_fetch_children(const bvh_node_t **n0,
+				      const bvh_node_t **n1, unsigned int c,
+				      const bvh_node_t *local,
+				      unsigned int num_local,
+				      const bvh_node_t *nodes, bvh_stats_t *st)
+{
+	*n0 = node_fetch(c, local, num_local, nodes, st);
+	*n1 = node_fetch(c + 1, local, num_local, nodes, st);
+	st->steps++;
+	st->box_tests += 2;
+}
+
+template <class Leaves>
+static float binary_closest(const ray_pre_t *r, float maxT,
+			    const bvh_node_t *local, unsigned int num_local,
+			    const bvh_node_t *nodes, const Leaves &leaves,
+			    bvh_stats_t *stats)
+{
+	bvh_entry_t stack[BVH_MAX_DEPTH];
+	int sp = 0;
+	float tnear = maxT;
+	char hit = 0;
+	float outT[2];
+	bvh_stats_t st = {};
+	const bvh_node_t *node = node_fetch(0U, local, num_local, nodes, &st);
+
+	if (!ray_aabb(outT, tnear, node->bbox, r->ov, r->invdir,
+		      r->dirsign)) {
+		bvh_stats_add(stats, &st);
+		return -1.0f;
+	}
+
+	// The child pointers stay valid until the next fetch, so the nearer
+	// one is walked into without fetching it again.
+	for (;;) {
+		if (node->count == 0) {
+			const unsigned int c = node->first;
+			const bvh_node_t *n0, *n1;
+			float t0[2], t1[2];
+
+			bvh_fetch_children(&n0, &n1, c, local, num_local, nodes,
+					   &st);
+			const char h0 = ray_aabb(t0, tnear, n0->bbox, r->ov,
+						 r->invdir, r->dirsign);
+			const char h1 = ray_aabb(t1, tnear, n1->bbox, r->ov,
+						 r->invdir, r->dirsign);
+
+			if (h0 && h1) {
+				const char swap = (t1[0] < t0[0]);
+				stack[sp].child = swap ? c : c + 1;
+				stack[sp++].t = swap ? t0[0] : t1[0];
+				node = swap ? n1 : n0;
+				continue;
+			}
+			if (h0 | h1) {
+				node = h0 ? n0 : n1;
+				continue;
+			}
+		} else {
+			hit |= leaves.closest(&tnear, node->first, node->count,
+					      r, &st);
+		}
+
+		// Pop, dropping boxes the nearest hit has moved in front of.
+		do {
+			if (sp == 0) {
+				bvh_stats_add(stats, &st);
+				return hit ? tnear : -1.0f;
+			}
+			sp--;
+		} while (stack[sp].t > tnear);
+		node = node_fetch(stack[sp].child, local, num_local, nodes, &st);
+	}
+}
+
+template <class Leaves>
+static char binary_occluded(const ray_pre_t *r, float maxT,
+			    const bvh_node_t *local, unsigned int num_local,
+			    const bvh_node_t *nodes, const Leaves &leaves,
+			    bvh_stats_t *stats)
+{
+	unsigned int stack[BVH_MAX_DEPTH];
+	int sp = 0;
+	bvh_stats_t st = {};
+	const bvh_node_t *node = node_fetch(0U, local, num_local, nodes, &st);
+
+	if (!ray_aabb_hit(maxT, node->bbox, r->ov, r->invdir, r->dirsign)) {
+		bvh_stats_add(stats, &st);
+		return 0;
+	}
+
+	for (;;) {
+		if (node->count == 0) {
+			const unsigned int c = node->first;
+			const bvh_node_t *n0, *n1;
+
+			bvh_fetch_children(&n0, &n1, c, local, num_local, nodes,
+					   &st);
+			const char h0 = ray_aabb_hit(maxT, n0->bbox, r->ov,
+						     r->invdir, r->dirsign);
+			const char h1 = ray_aabb_hit(maxT, n1->bbox, r->ov,
+						     r->invdir, r->dirsign);
+
+			if (h0 && h1) {
+				stack[sp++] = c + 1;
+			}
+			if (h0 | h1) {
+				node = h0 ? n0 : n1;
+				continue;
+			}
+		} else if (leaves.any(maxT, node->first, node->count, r,
+				      &st)) {
+			bvh_stats_add(stats, &st);
+			return 1;
+		}
+
+		if (sp == 0) {
+			bvh_stats_add(stats, &st);
+			return 0;
+		}
+		node = node_fetch(stack[--sp], local, num_local, nodes, &st);
+	}
+}
+
+//
+// Wide BVH
+//
+
+// Up to W - 1 entries per level are left on the stack.
+#define BVH_WIDE_STACK (2 * BVH_MAX_DEPTH)
+
+// Hit mask and entry distances of all W children of `node`.
+template <int W, class Node>
+static inline unsigned int wide_test(float t[W], float maxT, const Node *node,
+				     const ray_pre_t *r)
+{
+	unsigned int mask = 0;
+	for (int k = 0; k < W; k += 4) {
+		mask |= ray_aabb4(t + k, maxT, &node->bbox[0][0][k], W, r->ov,
+				  r->invdir, r->dirsign)
+			<< k;
+	}
+	return mask;
+}
+
+template <int W, class Node>
+static inline const Node *wide_fetch(unsigned int i, const Node *local,
+				     unsigned int num_local, const Node *nodes,
+				     bvh_stats_t *st)
+{
+	st->steps++;
+	st->box_tests += W;
+	return node_fetch(i, local, num_local, nodes, st);
+}
+
+template <int W, class Node, class Leaves>
+static float wide_closest(const ray_pre_t *r, float maxT, const Node *local,
+			  unsigned int num_local, const Node *nodes,
+			  const Leaves &leaves, bvh_stats_t *stats)
+{
+	bvh_entry_t stack[BVH_WIDE_STACK];
+	int sp = 0;
+	float tnear = maxT;
+	char hit = 0;
+	bvh_stats_t st = {};
+
+	stack[sp].child = 0;
+	stack[sp++].t = 0.0f;
+
+	while (sp > 0) {
+		const bvh_entry_t e = stack[--sp];
+		if (e.t > tnear) {
+			continue;
+		}
+
+		if (e.child & BVH_WIDE_LEAF) {
+			hit |= leaves.closest(&tnear, e.child & 0xffffff,
+					      (e.child >> 24) & 0x7f, r, &st);
+			continue;
+		}
+
+		const Node *node =
+			wide_fetch<W>(e.child, local, num_local, nodes, &st);
+		float t[W];
+		unsigned int mask = wide_test<W>(t, tnear, node, r);
+
+		// Push hits far to near, insertion sort on the stack top.
+		const int base = sp;
+		for (int k = 0; k < W; k++, mask >>= 1) {
+			if (!(mask & 1)) {
+				continue;
+			}
+			int j = sp++;
+			while ((j > base) && (stack[j - 1].t < t[k])) {
+				stack[j] = stack[j - 1];
+				j--;
+			}
+			stack[j].child = node->child[k];
+			stack[j].t = t[k];
+		}
+	}
+
+	bvh_stats_add(stats, &st);
+	return hit ? tnear : -1.0f;
+}
+
+template <int W, class Node, class Leaves>
+static char wide_occluded(const ray_pre_t *r, float maxT, const Node *local,
+			  unsigned int num_local, const Node *nodes,
+			  const Leaves &leaves, bvh_stats_t *stats)
+{
+	unsigned int stack[BVH_WIDE_STACK];
+	int sp = 0;
+	bvh_stats_t st = {};
+
+	stack[sp++] = 0;
+
+	while (sp > 0) {
+		const Node *node =
+			wide_fetch<W>(stack[--sp], local, num_local, nodes, &st);
+		float t[W];
+		unsigned int mask = wide_test<W>(t, maxT, node, r);
+
+		for (int k = 0; k < W; k++, mask >>= 1) {
+			if (!(mask & 1)) {
+				continue;
+			}
+			const unsigned int c = node->child[k];
+			if (!(c & BVH_WIDE_LEAF)) {
+				stack[sp++] = c;
+				continue;
+			}
+			if (leaves.any(maxT, c & 0xffffff, (c >> 24) & 0x7f, r,
+				       &st)) {
+				bvh_stats_add(stats, &st);
+				return 1;
+			}
+		}
+	}
+
+	bvh_stats_add(stats, &st);
+	return 0;
+}
+
+float bvh_closest(const ray_pre_t *r, float maxT, const bvh_node_t *local,
+		  unsigned int num_local, const bvh_node_t *nodes,
+		  const triangle_t *tris, bvh_stats_t *stats,
+		  float *normal)
+{
+	const FloatLeaves l = {tris, normal};
+	return binary_closest(r, maxT, local, num_local, nodes, l, stats);
+}
+
+char bvh_occluded(const ray_pre_t *r, float maxT, const bvh_node_t *local,
+		  unsigned int num_local, const bvh_node_t *nodes,
+		  const triangle_t *tris, bvh_stats_t *stats)
+{
+	const FloatLeaves l = {tris, 0};
+	return binary_occluded(r, maxT, local, num_local, nodes, l, stats);
+}
+
+float bvh_closest(const ray_pre_t *r, float maxT, const bvh_node_t *local,
+		  unsigned int num_local, const bvh_node_t *nodes,
+		  const qleaf_t *leaves, bvh_stats_t *stats,
+		  float *normal)
+{
+	const QuantLeaves l = {leaves, normal};
+	return binary_closest(r, maxT, local, num_local, nodes, l, stats);
+}
+
+char bvh_occluded(const ray_pre_t *r, float maxT, const bvh_node_t *local,
+		  unsigned int num_local, const bvh_node_t *nodes,
+		  const qleaf_t *leaves, bvh_stats_t *stats)
+{
+	const QuantLeaves l = {leaves, 0};
+	return binary_occluded(r, maxT, local, num_local, nodes, l, stats);
+}
+
+float bvh4_closest(const ray_pre_t *r, float maxT, const bvh4_node_t *local,
+		   unsigned int num_local, const bvh4_node_t *nodes,
+		   const triangle_t *tris, bvh_stats_t *stats,
+		   float *normal)
+{
+	const FloatLeaves l = {tris, normal};
+	return wide_closest<4>(r, maxT, local, num_local, nodes, l, stats);
+}
+
+char bvh4_occluded(const ray_pre_t *r, float maxT, const bvh4_node_t *local,
+		   unsigned int num_local, const bvh4_node_t *nodes,
+		   const triangle_t *tris, bvh_stats_t *stats)
+{
+	const FloatLeaves l = {tris, 0};
+	return wide_occluded<4>(r, maxT, local, num_local, nodes, l, stats);
+}
+
+float bvh4_closest(const ray_pre_t *r, float maxT, const bvh4_node_t *local,
+		   unsigned int num_local, const bvh4_node_t *nodes,
+		   const qleaf_t *leaves, bvh_stats_t *stats,
+		   float *normal)
+{
+	const QuantLeaves l = {leaves, normal};
+	return wide_closest<4>(r, maxT, local, num_local, nodes, l, stats);
+}
+
+char bvh4_occluded(const ray_pre_t *r, float maxT, const bvh4_node_t *local,
+		   unsigned int num_local, const bvh4_node_t *nodes,
+		   const qleaf_t *leaves, bvh_stats_t *stats)
+{
+	const QuantLeaves l = {leaves, 0};
+	return wide_occluded<4>(r, maxT, local, num_local, nodes, l, stats);
+}
+
+float bvh8_closest(const ray_pre_t *r, float maxT, const bvh8_node_t *local,
+		   unsigned int num_local, const bvh8_node_t *nodes,
+		   const triangle_t *tris, bvh_stats_t *stats,
+		   float *normal)
+{
+	const FloatLeaves l = {tris, normal};
+	return wide_closest<8>(r, maxT, local, num_local, nodes, l, stats);
+}
+
+char bvh8_occluded(const ray_pre_t *r, float maxT, const bvh8_node_t *local,
+		   unsigned int num_local, const bvh8_node_t *nodes,
+		   const triangle_t *tris, bvh_stats_t *stats)
+{
+	const FloatLeaves l = {tris, 0};
+	return wide_occluded<8>(r, maxT, local, num_local, nodes, l, stats);
+}
+
+float bvh8_closest(const ray_pre_t *r, float maxT, const bvh8_node_t *local,
+		   unsigned int num_local, const bvh8_node_t *nodes,
+		   const qleaf_t *leaves, bvh_stats_t *stats,
+		   float *normal)
+{
+	const QuantLeaves l = {leaves, normal};
+	return wide_closest<8>(r, maxT, local, num_local, nodes, l, stats);
+}
+
+char bvh8_occluded(const ray_pre_t *r, float maxT, const bvh8_node_t *local,
+		   unsigned int num_local, const bvh8_node_t *nodes,
+		   const qleaf_t *leaves, bvh_stats_t *stats)
+{
+	const QuantLeaves l = {leaves, 0};
+	return wide_occluded<8>(r, maxT, local, num_local, nodes, l, stats);
+}
+
+template <class Leaves>
+static float scene_closest_t(const scene_view_t *s, const ray_pre_t *r,
+			     float maxT, const Leaves *tris, float *normal)
+{
+	switch (s->width) {
+	case 4:
+		return bvh4_closest(r, maxT, (const bvh4_node_t *)s->local,
+				    s->num_local, (const bvh4_node_t *)s->nodes,
+				    tris, s->stats, normal);
+	case 8:
+		return bvh8_closest(r, maxT, (const bvh8_node_t *)s->local,
+				    s->num_local, (const bvh8_node_t *)s->nodes,
+				    tris, s->stats, normal);
+	default:
+		return bvh_closest(r, maxT, (const bvh_node_t *)s->local,
+				   s->num_local, (const bvh_node_t *)s->nodes,
+				   tris, s->stats, normal);
+	}
+}
+
+template <class Leaves>
+static char scene_occluded_t(const scene_view_t *s, const ray_pre_t *r,
+			     float maxT, const Leaves *tris)
+{
+	switch (s->width) {
+	case 4:
+		return bvh4_occluded(r, maxT, (const bvh4_node_t *)s->local,
+				     s->num_local, (const bvh4_node_t *)s->nodes,
+				     tris, s->stats);
+	case 8:
+		return bvh8_occluded(r, maxT, (const bvh8_node_t *)s->local,
+				     s->num_local, (const bvh8_node_t *)s->nodes,
+				     tris, s->stats);
+	default:
+		return bvh_occluded(r, maxT, (const bvh_node_t *)s->local,
+				    s->num_local, (const bvh_node_t *)s->nodes,
+				    tris, s->stats);
+	}
+}
+
+// Bottom level of an instance. It has its own nodes, so the cache of the top
+// level is put aside, and its steps and bytes go to the top level ray.
+static void blas_stats(bvh_stats_t *st, const bvh_stats_t *b)
+{
+	st->steps += b->steps;
+	st->box_tests += b->box_tests;
+	st->tri_tests += b->tri_tests;
+	st->bytes += b->bytes;
+	st->fetches += b->fetches;
+}
+
+static float blas_closest(const scene_view_t *s, const ray_pre_t *r,
+			  float maxT, float *normal, bvh_stats_t *st)
+{
+	bvh_cache_t *cache = cur_cache;
+	bvh_stats_t b = {};
+	scene_view_t v = *s;
+	float t;
+
+	cur_cache = 0;
+	v.stats = &b;
+	if (v.format == SCENE_TRIS_QUANT) {
+		t = scene_closest_t(&v, r, maxT, (const qleaf_t *)v.tris,
+				    normal);
+	} else {
+		t = scene_closest_t(&v, r, maxT, (const triangle_t *)v.tris,
+				    normal);
+	}
+	cur_cache = cache;
+	blas_stats(st, &b);
+	return t;
+}
+
+static char blas_occluded(const scene_view_t *s, const ray_pre_t *r,
+			  float maxT, bvh_stats_t *st)
+{
+	bvh_cache_t *cache = cur_cache;
+	bvh_stats_t b = {};
+	scene_view_t v = *s;
+	char hit;
+
+	cur_cache = 0;
+	v.stats = &b;
+	if (v.format == SCENE_TRIS_QUANT) {
+		hit = scene_occluded_t(&v, r, maxT, (const qleaf_t *)v.tris);
+	} else {
+		hit = scene_occluded_t(&v, r, maxT,
+				       (const triangle_t *)v.tris);
+	}
+	cur_cache = cache;
+	blas_stats(st, &b);
+	return hit;
+}
+
+// Top level of SCENE_INSTANCES, the kernels above with instance leaves.
+static float instances_closest(const scene_view_t *s, const ray_pre_t *r,
+			       float maxT, float *normal)
+{
+	const InstanceLeaves l = {(const instance_t *)s->tris, s->blas,
+				  normal};
+
+	switch (s->width) {
+	case 4:
+		return wide_closest<4>(r, maxT, (const bvh4_node_t *)s->local,
+				       s->num_local,
+				       (const bvh4_node_t *)s->nodes, l,
+				       s->stats);
+	case 8:
+		return wide_closest<8>(r, maxT, (const bvh8_node_t *)s->local,
+				       s->num_local,
+				       (const bvh8_node_t *)s->nodes, l,
+				       s->stats);
+	default:
+		return binary_closest(r, maxT, (const bvh_node_t *)s->local,
+				      s->num_local,
+				      (const bvh_node_t *)s->nodes, l,
+				      s->stats);
+	}
+}
+
+static char instances_occluded(const scene_view_t *s, const ray_pre_t *r,
+			       float maxT)
+{
+	const InstanceLeaves l = {(const instance_t *)s->tris, s->blas, 0};
+
+	switch (s->width) {
+	case 4:
+		return wide_occluded<4>(r, maxT, (const bvh4_node_t *)s->local,
+					s->num_local,
+					(const bvh4_node_t *)s->nodes, l,
+					s->stats);
+	case 8:
+		return wide_occluded<8>(r, maxT, (const bvh8_node_t *)s->local,
+					s->num_local,
+					(const bvh8_node_t *)s->nodes, l,
+					s->stats);
+	default:
+		return binary_occluded(r, maxT, (const bvh_node_t *)s->local,
+				       s->num_local,
+				       (const bvh_node_t *)s->nodes, l,
+				       s->stats);
+	}
+}
+
+float scene_closest(const scene_view_t *s, const ray_pre_t *r, float maxT,
+		    float *normal)
+{
+	float t;
+
+	cur_cache = s->cache;
+	if (s->format == SCENE_INSTANCES) {
+		t = instances_closest(s, r, maxT, normal);
+	} else if (s->format == SCENE_TRIS_QUANT) {
+		t = scene_closest_t(s, r, maxT, (const qleaf_t *)s->tris,
+				    normal);
+	} else {
+		t = scene_closest_t(s, r, maxT, (const triangle_t *)s->tris,
+				    normal);
+	}
+	cur_cache = 0;
+	return t;
+}
+
+char scene_occluded(const scene_view_t *s, const ray_pre_t *r, float maxT)
+{
+	char hit;
+
+	cur_cache = s->cache;
+	if (s->format == SCENE_INSTANCES) {
+		hit = instances_occluded(s, r, maxT);
+	} else if (s->format == SCENE_TRIS_QUANT) {
+		hit = scene_occluded_t(s, r, maxT, (const qleaf_t *)s->tris);
+	} else {
+		hit = scene_occluded_t(s, r, maxT,
+				       (const triangle_t *)s->tris);
+	}
+	cur_cache = 0;
+	return hit;
+}
@@ -0,0 +1,462 @@
+//
+// Progressive path tracer(RAYTRACE_MODE_PATH) on the BVH kernels.
+//
+// Diffuse surfaces lit by one point light(next event estimation with a shadow
+// ray per bounce) inside a homogeneous medium. A segment of length d is
+// attenuated by T = exp(-sigma * d) and picks up fog * (1 - T) from the
+// medium(single scattering of a constant in-scattered radiance).
+//
+// Paths run in packets of PATH_PACKET: the transmittances of one bounce, for
+// the path segments and then for the shadow segments, are one fmath_exp4()
+// call each instead of a libm expf() per ray.
+//
+// Samples are seeded from(pixel, frame, sample), so the image doesn't depend
+// on how pixels are split over cores and every frame adds new samples.
+//
+// path_wavefront() runs the same paths a stage at a time over a whole chunk,
+// with the path state as SoA in local memory. Paths that ended are dropped
+// after every bounce, so later bounces only loop over live paths instead of
+// carrying dead lanes.
+//
+#include <math.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include "e_lib.h"
+#ifdef __cplusplus
+}
+#endif
+
+#include "e_banks.h"
+#include "e_trace.h"
+#include "fast_exp.h"
+#include "raytrace.h"
+
+#define PATH_PACKET (4)	      // fmath_exp4() width
+#define PATH_EPS (1.0e-3f)    // offset of new rays from the surface
+#define PATH_EXP_MIN (-80.0f) // fmath_exp4() has no range check
+#define PATH_INV_PI (0.318309886f)
+
+typedef struct {
+	ray_t ray;
+	float thr; // throughput
+	float L;   // radiance gathered so far
+	unsigned int rng;
+	unsigned int alive;
+} path_t;
+
+// Wavefront path state. Live paths are [0, n) of every array.
+typedef struct {
+	float org[3][PATH_WAVE];
+	float dir[3][PATH_WAVE];
+	float n[3][PATH_WAVE]; // hit normal
+	float t[PATH_WAVE];    // hit distance, < 0 once the path ended
+	float thr[PATH_WAVE];
+	float L[PATH_WAVE];
+	unsigned int rng[PATH_WAVE];
+	unsigned int pixel[PATH_WAVE]; // index into accum
+} path_wave_t; // 4.25KB
+
+static E_CORE_LOCAL path_wave_t wave E_BANK_WORK;
+
+// Integer hash(lowbias32) for seeding.
+static inline unsigned int path_hash(unsigned int x)
+{
+	x ^= x >> 16;
+	x *= 0x7feb352d;
+	x ^= x >> 15;
+	x *= 0x846ca68b;
+	x ^= x >> 16;
+	return x;
+}
+
+// xorshift32, uniform in [0, 1).
+static inline float path_rand(unsigned int *s)
+{
+	unsigned int x = *s;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*s = x;
+	return (x >> 8) * (1.0f / 16777216.0f);
+}
+
+static inline void normalize3(float v[3])
+{
+	const float s = 1.0f / sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+	v[0] *= s;
+	v[1] *= s;
+	v[2] *= s;
+}
+
+static void camera_ray(ray_t *ray, unsigned int pixel, const path_params_t *p,
+		       unsigned int *rng)
+{
+	const float aspect = (float)p->width / p->height;
+	const float u = 2.0f * ((pixel % p->width) + path_rand(rng)) / p->width -
+			1.0f;
+	const float v =
+		2.0f * ((pixel / p->width) + path_rand(rng)) / p->height - 1.0f;
+
+	ray->org[0] = p->eye[0];
+	ray->org[1] = p->eye[1];
+	ray->org[2] = p->eye[2];
+	ray->dir[0] = u * p->fov * aspect;
+	ray->dir[1] = v * p->fov;
+	ray->dir[2] = 1.0f;
+	normalize3(ray->dir); // t is a distance, for the transmittance
+}
+
+// Cosine weighted direction around the unit normal n: a point in the unit
+// disk lifted onto the hemisphere, in the tangent frame of Duff et al.
+static void sample_cosine(float d[3], const float n[3], unsigned int *rng)
+{
+	const float s = (n[2] >= 0.0f) ? 1.0f : -1.0f;
+	const float a = -1.0f / (s + n[2]);
+	const float b = n[0] * n[1] * a;
+	float x, y, r2, z;
+	int k;
+
+	do {
+		x = 2.0f * path_rand(rng) - 1.0f;
+		y = 2.0f * path_rand(rng) - 1.0f;
+		r2 = x * x + y * y;
+	} while (r2 >= 1.0f);
+	z = sqrtf(1.0f - r2);
+
+	const float t[3] = {1.0f + s * n[0] * n[0] * a, s * b, -s * n[0]};
+	const float bt[3] = {b, s + n[1] * n[1] * a, -n[1]};
+	for (k = 0; k < 3; k++) {
+		d[k] = x * t[k] + y * bt[k] + z * n[k];
+	}
+}
+
+static inline float path_exp_arg(float sigma, float d)
+{
+	const float x = -sigma * d;
+	return (x < PATH_EXP_MIN) ? PATH_EXP_MIN : x;
+}
+
+// Surface interaction at distance t along(org, dir). Turns n into the unit
+// normal facing the ray, writes the hit point(off the surface) to pos and
+// returns the direct light times thr. *x gets the exponent of its
+// transmittance, 0 when the light is hidden.
+static float path_direct(float pos[3], float n[3], const float org[3],
+			 const float dir[3], float t, float thr,
+			 const path_params_t *p, const scene_view_t *s, float *x)
+{
+	float to[3], d2, cosl;
+	ray_pre_t r;
+	ray_t shadow;
+	int k;
+
+	*x = 0.0f;
+	normalize3(n);
+	if (n[0] * dir[0] + n[1] * dir[1] + n[2] * dir[2] > 0.0f) {
+		for (k = 0; k < 3; k++) {
+			n[k] = -n[k];
+		}
+	}
+	for (k = 0; k < 3; k++) {
+		pos[k] = org[k] + dir[k] * t + n[k] * PATH_EPS;
+		to[k] = p->light[k] - pos[k];
+	}
+
+	d2 = to[0] * to[0] + to[1] * to[1] + to[2] * to[2];
+	cosl = (n[0] * to[0] + n[1] * to[1] + n[2] * to[2]) / sqrtf(d2);
+	if (cosl <= 0.0f) {
+		return 0.0f;
+	}
+	const float d = sqrtf(d2);
+	for (k = 0; k < 3; k++) {
+		shadow.org[k] = pos[k];
+		shadow.dir[k] = to[k] / d;
+	}
+	ray_setup(&r, &shadow);
+	if (scene_occluded(s, &r, d)) {
+		return 0.0f;
+	}
+	*x = path_exp_arg(p->sigma, d);
+	return thr * p->albedo * PATH_INV_PI * cosl * p->power / d2;
+}
+
+// One segment and one surface interaction of every live path. `last` ends
+// the paths after their direct light.
+static void path_bounce(path_t *path, const path_params_t *p,
+			const scene_view_t *s, char last)
+{
+	float x[PATH_PACKET], T[PATH_PACKET], t[PATH_PACKET];
+	float n[PATH_PACKET][3], direct[PATH_PACKET];
+	unsigned int l;
+	int k;
+
+	for (l = 0; l < PATH_PACKET; l++) {
+		ray_pre_t r;
+		x[l] = 0.0f;
+		if (!path[l].alive) {
+			continue;
+		}
+		ray_setup(&r, &path[l].ray);
+		t[l] = scene_closest(s, &r, p->far, n[l]);
+		x[l] = path_exp_arg(p->sigma, (t[l] < 0.0f) ? p->far : t[l]);
+	}
+	fmath_exp4(T, x);
+
+	for (l = 0; l < PATH_PACKET; l++) {
+		path_t *q = &path[l];
+		float pos[3];
+
+		direct[l] = 0.0f;
+		x[l] = 0.0f;
+		if (!q->alive) {
+			continue;
+		}
+
+		q->L += q->thr * p->fog * (1.0f - T[l]);
+		q->thr *= T[l];
+		if (t[l] < 0.0f) {
+			q->L += q->thr * p->sky;
+			q->alive = 0;
+			continue;
+		}
+		direct[l] = path_direct(pos, n[l], q->ray.org, q->ray.dir, t[l],
+					q->thr, p, s, &x[l]);
+
+		// Next segment. Cosine sampling cancels the cosine and 1/pi
+		// of the diffuse BRDF, leaving the albedo.
+		q->thr *= p->albedo;
+		for (k = 0; k < 3; k++) {
+			q->ray.org[k] = pos[k];
+		}
+		sample_cosine(q->ray.dir, n[l], &q->rng);
+		q->alive = !last;
+	}
+	fmath_exp4(T, x);
+
+	for (l = 0; l < PATH_PACKET; l++) {
+		path[l].L += direct[l] * T[l];
+	}
+}
+
+void path_trace(float *accum, unsigned int first, unsigned int count,
+		const path_params_t *p, const scene_view_t *s)
+{
+	path_t path[PATH_PACKET];
+	unsigned int i, l, smp, depth;
+
+	for (i = 0; i < count; i += PATH_PACKET) {
+		for (smp = 0; smp < p->spp; smp++) {
+			const unsigned int seed =
+				path_hash(p->frame * p->spp + smp);
+
+			for (l = 0; l < PATH_PACKET; l++) {
+				path_t *q = &path[l];
+				q->alive = (i + l < count);
+				q->thr = 1.0f;
+				q->L = 0.0f;
+				q->rng = path_hash((first + i + l) ^ seed) | 1;
+				if (q->alive) {
+					camera_ray(&q->ray, first + i + l, p,
+						   &q->rng);
+				}
+			}
+			for (depth = 0; depth <= p->depth; depth++) {
+				path_bounce(path, p, s, depth == p->depth);
+			}
+			for (l = 0; (l < PATH_PACKET) && (i + l < count); l++) {
+				accum[i + l] += path[l].L;
+			}
+		}
+	}
+}
+
+// Clocks since the job started, ctimer 1 is run by e_cmdq_serve().
+static inline unsigned int path_clock(void)
+{
+#if E_TRACE
+	return e_trace_clock();
+#else
+	return E_CTIMER_MAX - e_ctimer_get(E_CTIMER_1);
+#endif
+}
+
+// Closest hit of paths [0, n).
+static void wave_extend(path_wave_t *w, unsigned int n,
+			const path_params_t *p, const scene_view_t *s)
+{
+	unsigned int i;
+	int k;
+
+	for (i = 0; i < n; i++) {
+		ray_pre_t r;
+		ray_t ray;
+		float nrm[3];
+
+		for (k = 0; k < 3; k++) {
+			ray.org[k] = w->org[k][i];
+			ray.dir[k] = w->dir[k][i];
+		}
+		ray_setup(&r, &ray);
+		w->t[i] = scene_closest(s, &r, p->far, nrm);
+		for (k = 0; k < 3; k++) {
+			w->n[k][i] = nrm[k];
+		}
+	}
+}
+
+// path_bounce() after the traversal, PATH_PACKET paths per fmath_exp4().
+// Ended paths get t < 0.
+static void wave_shade(path_wave_t *w, unsigned int n, const path_params_t *p,
+		       const scene_view_t *s, char last)
+{
+	unsigned int i, l;
+	int k;
+
+	for (i = 0; i < n; i += PATH_PACKET) {
+		const unsigned int m =
+			(n - i < PATH_PACKET) ? n - i : PATH_PACKET;
+		float x[PATH_PACKET], T[PATH_PACKET], direct[PATH_PACKET];
+
+		for (l = 0; l < PATH_PACKET; l++) {
+			const float t = (l < m) ? w->t[i + l] : 0.0f;
+			x[l] = (l < m) ? path_exp_arg(p->sigma,
+						      (t < 0.0f) ? p->far : t)
+				       : 0.0f;
+		}
+		fmath_exp4(T, x);
+
+		for (l = 0; l < PATH_PACKET; l++) {
+			const unsigned int j = i + l;
+			float org[3], dir[3], nrm[3], pos[3];
+
+			direct[l] = 0.0f;
+			x[l] = 0.0f;
+			if (l >= m) {
+				continue;
+			}
+
+			w->L[j] += w->thr[j] * p->fog * (1.0f - T[l]);
+			w->thr[j] *= T[l];
+			if (w->t[j] < 0.0f) {
+				w->L[j] += w->thr[j] * p->sky;
+				continue;
+			}
+			for (k = 0; k < 3; k++) {
+				org[k] = w->org[k][j];
+				dir[k] = w->dir[k][j];
+				nrm[k] = w->n[k][j];
+			}
+			direct[l] = path_direct(pos, nrm, org, dir, w->t[j],
+						w->thr[j], p, s, &x[l]);
+
+			w->thr[j] *= p->albedo;
+			sample_cosine(dir, nrm, &w->rng[j]);
+			for (k = 0; k < 3; k++) {
+				w->org[k][j] = pos[k];
+				w->dir[k][j] = dir[k];
+			}
+			w->t[j] = last ? -1.0f : w->t[j];
+		}
+		fmath_exp4(T, x);
+
+		for (l = 0; l < m; l++) {
+			w->L[i + l] += direct[l] * T[l];
+		}
+	}
+}
+
+// Adds the radiance of ended paths to accum and moves the live ones to the
+// front. Returns their number.
+static unsigned int wave_compact(path_wave_t *w, unsigned int n, float *accum)
+{
+	unsigned int i, live = 0;
+	int k;
+
+	for (i = 0; i < n; i++) {
+		if (w->t[i] < 0.0f) {
+			accum[w->pixel[i]] += w->L[i];
+			continue;
+		}
+		if (live != i) {
+			for (k = 0; k < 3; k++) {
+				w->org[k][live] = w->org[k][i];
+				w->dir[k][live] = w->dir[k][i];
+			}
+			w->thr[live] = w->thr[i];
+			w->L[live] = w->L[i];
+			w->rng[live] = w->rng[i];
+			w->pixel[live] = w->pixel[i];
+		}
+		live++;
+	}
+	return live;
+}
+
+void path_wavefront(float *accum, unsigned int first, unsigned int count,
+		    const path_params_t *p, const scene_view_t *s,
+		    path_stats_t *stats)
+{
+	path_wave_t *w = &wave;
+	path_stats_t st;
+	unsigned int i, n, smp, depth, t0, t1;
+	int k;
+
+	memset(&st, 0, sizeof(st));
+	count = (count > PATH_WAVE) ? PATH_WAVE : count;
+	for (smp = 0; smp < p->spp; smp++) {
+		const unsigned int seed = path_hash(p->frame * p->spp + smp);
+
+		// Generate
+		t0 = path_clock();
+		for (i = 0; i < count; i++) {
+			unsigned int rng = path_hash((first + i) ^ seed) | 1;
+			ray_t ray;
+
+			camera_ray(&ray, first + i, p, &rng);
+			for (k = 0; k < 3; k++) {
+				w->org[k][i] = ray.org[k];
+				w->dir[k][i] = ray.dir[k];
+			}
+			w->thr[i] = 1.0f;
+			w->L[i] = 0.0f;
+			w->rng[i] = rng;
+			w->pixel[i] = i;
+		}
+		n = count;
+		st.paths += count;
+		t1 = path_clock();
+		st.clocks[PATH_STAGE_GENERATE] += t1 - t0;
+
+		for (depth = 0; (depth <= p->depth) && n; depth++) {
+			const unsigned int b = (depth < PATH_STATS_BOUNCES)
+						       ? depth
+						       : PATH_STATS_BOUNCES - 1;
+			st.active[b] += n;
+
+			wave_extend(w, n, p, s);
+			t0 = path_clock();
+			st.clocks[PATH_STAGE_EXTEND] += t0 - t1;
+
+			wave_shade(w, n, p, s, depth == p->depth);
+			t1 = path_clock();
+			st.clocks[PATH_STAGE_SHADE] += t1 - t0;
+
+			n = wave_compact(w, n, accum);
+			t0 = path_clock();
+			st.clocks[PATH_STAGE_COMPACT] += t0 - t1;
+			t1 = t0;
+		}
+	}
+
+	if (stats) {
+		for (k = 0; k < PATH_NUM_STAGES; k++) {
+			stats->clocks[k] += st.clocks[k];
+		}
+		stats->paths += st.paths;
+		for (k = 0; k < PATH_STATS_BOUNCES; k++) {
+			stats->active[k] += st.active[k];
+		}
+	}
+}
@@ -11,9 +11,8 @@ extern "C" {
 }
 #endif
 
-
-// GCC
-#define RESTRICT __restrict__
+#include "e_prof.h"
+#include "raytrace.h"
 
 // rayov = rayorg * rayinvdir
 char ray_aabb(float outT[2], float maxT, const float bbox[2][3], const float rayov[3], const float rayinvdir[3], const char raydirsign[3]) {
@@ -48,7 +47,172 @@ char ray_aabb(float outT[2], float maxT, const float bbox[2][3], const float ray
 	char hit = (tmax > 0.0f) && (tmin <= tmax) && (tmin <= maxT);
 #endif
 
-	return 0; // false
+	return hit;
+}
+
+unsigned int ray_aabb4(float outT[4], float maxT, const float *bbox,
+		       unsigned int stride, const float rayov[3],
+		       const float rayinvdir[3], const char raydirsign[3])
+{
+	// Near/far planes are the same for all 4 boxes, only the rows change.
+	const float *lo_x = bbox + ((raydirsign[0] ^ 1) * 3 + 0) * stride;
+	const float *hi_x = bbox + (raydirsign[0] * 3 + 0) * stride;
+	const float *lo_y = bbox + ((raydirsign[1] ^ 1) * 3 + 1) * stride;
+	const float *hi_y = bbox + (raydirsign[1] * 3 + 1) * stride;
+	const float *lo_z = bbox + ((raydirsign[2] ^ 1) * 3 + 2) * stride;
+	const float *hi_z = bbox + (raydirsign[2] * 3 + 2) * stride;
+	unsigned int mask = 0;
+
+	for (int i = 0; i < 4; i++) {
+		const float tmin_x = lo_x[i] * rayinvdir[0] + rayov[0];
+		const float tmax_x = hi_x[i] * rayinvdir[0] + rayov[0];
+		const float tmin_y = lo_y[i] * rayinvdir[1] + rayov[1];
+		const float tmax_y = hi_y[i] * rayinvdir[1] + rayov[1];
+		const float tmin_z = lo_z[i] * rayinvdir[2] + rayov[2];
+		const float tmax_z = hi_z[i] * rayinvdir[2] + rayov[2];
+
+		float tmin = (tmin_x > tmin_y) ? tmin_x : tmin_y;
+		float tmax = (tmax_x < tmax_y) ? tmax_x : tmax_y;
+		tmin = (tmin > tmin_z) ? tmin : tmin_z;
+		tmax = (tmax < tmax_z) ? tmax : tmax_z;
+		tmax = (tmax < maxT) ? tmax : maxT;
+
+		outT[i] = tmin;
+		mask |= ((tmax > 0.0f) && (tmin <= tmax)) << i;
+	}
+
+	return mask;
+}
+
+char ray_aabb_hit(float maxT, const float bbox[2][3], const float rayov[3],
+		  const float rayinvdir[3], const char raydirsign[3])
+{
+	const float tmin_x = bbox[raydirsign[0] ^ 1][0] * rayinvdir[0] + rayov[0];
+	const float tmax_x = bbox[raydirsign[0]][0] * rayinvdir[0] + rayov[0];
+	const float tmin_y = bbox[raydirsign[1] ^ 1][1] * rayinvdir[1] + rayov[1];
+	const float tmax_y = bbox[raydirsign[1]][1] * rayinvdir[1] + rayov[1];
+	const float tmin_z = bbox[raydirsign[2] ^ 1][2] * rayinvdir[2] + rayov[2];
+	const float tmax_z = bbox[raydirsign[2]][2] * rayinvdir[2] + rayov[2];
+
+	float tmin = (tmin_x > tmin_y) ? tmin_x : tmin_y;
+	float tmax = (tmax_x < tmax_y) ? tmax_x : tmax_y;
+	tmin = (tmin > tmin_z) ? tmin : tmin_z;
+	tmax = (tmax < tmax_z) ? tmax : tmax_z;
+	tmax = (tmax < maxT) ? tmax : maxT;
+
+	return (tmax > 0.0f) && (tmin <= tmax);
+}
+
+void ray_setup(ray_pre_t *r, const ray_t *ray)
+{
+	for (int j = 0; j < 3; j++) {
+		r->org[j] = ray->org[j];
+		r->dir[j] = ray->dir[j];
+		r->invdir[j] = 1.0f / ray->dir[j];
+		r->ov[j] = -ray->org[j] * r->invdir[j];
+		r->dirsign[j] = (ray->dir[j] >= 0.0f) ? 1 : 0;
+	}
+}
+
+static inline void cross3(float c[3], const float a[3], const float b[3])
+{
+	c[0] = a[1] * b[2] - a[2] * b[1];
+	c[1] = a[2] * b[0] - a[0] * b[2];
+	c[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+static inline float dot3(const float a[3], const float b[3])
+{
+	return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+#define RAY_TRIANGLE_EPS (1.0e-8f)
+
+char ray_triangle(float *t, float maxT, const triangle_t *tri,
+		  const ray_pre_t *r)
+{
+	float p[3], s[3], q[3];
+
+	cross3(p, r->dir, tri->e2);
+	const float det = dot3(tri->e1, p);
+	if ((det > -RAY_TRIANGLE_EPS) && (det < RAY_TRIANGLE_EPS)) {
+		return 0;
+	}
+	const float inv_det = 1.0f / det;
+
+	s[0] = r->org[0] - tri->v0[0];
+	s[1] = r->org[1] - tri->v0[1];
+	s[2] = r->org[2] - tri->v0[2];
+	const float u = dot3(s, p) * inv_det;
+	if ((u < 0.0f) || (u > 1.0f)) {
+		return 0;
+	}
+
+	cross3(q, s, tri->e1);
+	const float v = dot3(r->dir, q) * inv_det;
+	if ((v < 0.0f) || (u + v > 1.0f)) {
+		return 0;
+	}
+
+	const float tt = dot3(tri->e2, q) * inv_det;
+	if ((tt <= 0.0f) || (tt >= maxT)) {
+		return 0;
+	}
+	*t = tt;
+	return 1;
+}
+
+// Same tests as ray_triangle(), scaled by |det| instead of divided by det.
+char ray_triangle_hit(float maxT, const triangle_t *tri, const ray_pre_t *r)
+{
+	float p[3], s[3], q[3];
+
+	cross3(p, r->dir, tri->e2);
+	float det = dot3(tri->e1, p);
+	const float sign = (det < 0.0f) ? -1.0f : 1.0f;
+	det *= sign;
+	if (det < RAY_TRIANGLE_EPS) {
+		return 0;
+	}
+
+	s[0] = r->org[0] - tri->v0[0];
+	s[1] = r->org[1] - tri->v0[1];
+	s[2] = r->org[2] - tri->v0[2];
+	const float u = dot3(s, p) * sign;
+	cross3(q, s, tri->e1);
+	const float v = dot3(r->dir, q) * sign;
+	const float t = dot3(tri->e2, q) * sign;
+
+	return (u >= 0.0f) && (v >= 0.0f) && (u + v <= det) && (t > 0.0f) &&
+	       (t < maxT * det);
+}
+
+unsigned int qleaf_decode(triangle_t *tris, const qleaf_t *leaf)
+{
+	const unsigned short *vert = (const unsigned short *)(leaf + 1);
+	const unsigned short *tri = vert + 3 * leaf->num_verts;
+	const unsigned int nv = leaf->num_verts;
+	const unsigned int nt = leaf->num_tris;
+	float v[QLEAF_MAX_VERTS][3];
+
+	for (unsigned int i = 0; i < nv; i++) {
+		for (int j = 0; j < 3; j++) {
+			v[i][j] = leaf->org[j] +
+				  (float)vert[3 * i + j] * leaf->scale[j];
+		}
+	}
+	for (unsigned int i = 0; i < nt; i++) {
+		const float *a = v[tri[i] & 0xf];
+		const float *b = v[(tri[i] >> 4) & 0xf];
+		const float *c = v[(tri[i] >> 8) & 0xf];
+		for (int j = 0; j < 3; j++) {
+			tris[i].v0[j] = a[j];
+			tris[i].e1[j] = b[j] - a[j];
+			tris[i].e2[j] = c[j] - a[j];
+		}
+	}
+
+	return (sizeof(qleaf_t) + 6 * nv + 2 * nt + 3) & ~3u;
 }
 
 #if RAYTRACE_TEST
@@ -62,6 +226,23 @@ char ray_aabb(float outT[2], float maxT, const float bbox[2][3], const float ray
 #include <stdio.h>
 
 char outbuf[4096] SECTION("shared_dram");
+
+typedef struct {
+	float maxT;
+	float bbox[2][3];
+	float rayov[3];
+	float rayinvdir[3];
+	char raydirsign[3];
+	volatile char hit;
+} prof_aabb_t;
+
+static void prof_ray_aabb(void *arg)
+{
+	prof_aabb_t *a = (prof_aabb_t *)arg;
+	float outT[2];
+	a->hit = ray_aabb(outT, a->maxT, a->bbox, a->rayov, a->rayinvdir,
+			  a->raydirsign);
+}
 int main(int argc, char **argv)
 {
 	e_coreid_t coreid;
@@ -141,10 +322,66 @@ int main(int argc, char **argv)
 						 "\"ray_aabb()\" is "
 						 "%d.\n",
 			code_clocks);
+	}
+	{
+		prof_aabb_t a;
+		e_prof_t prof;
+
+		memcpy(&a.bbox, bbox, sizeof(bbox));
+		memcpy(a.rayov, rayov, sizeof(rayov));
+		memcpy(a.rayinvdir, rayinvdir, sizeof(rayinvdir));
+		memcpy(a.raydirsign, raydirsign, sizeof(raydirsign));
+		a.maxT = maxT;
 
-		mailbox[0] = 1;
+		e_prof_run(&prof, prof_ray_aabb, &a, E_PROF_REPEAT);
+		e_prof_print(outbuf + strlen(outbuf), "ray_aabb()", &prof);
 	}
 
+	// Quantized leaf: one quad(2 triangles, 4 shared vertices).
+	{
+		static struct {
+			qleaf_t h;
+			unsigned short vert[4][3];
+			unsigned short tri[2];
+		} leaf = {{{-1.0f, -1.0f, 0.0f},
+			   {2.0f / 65535.0f, 2.0f / 65535.0f, 0.0f},
+			   4,
+			   2},
+			  {{0, 0, 0}, {65535, 0, 0}, {65535, 65535, 0}, {0, 65535, 0}},
+			  {0 | 1 << 4 | 2 << 8, 0 | 2 << 4 | 3 << 8}};
+		triangle_t tris[2];
+		ray_t ray = {{0.25f, 0.25f, -1.0f}, {0.0f, 0.0f, 1.0f}};
+		ray_pre_t r;
+		float t;
+
+		ray_setup(&r, &ray);
+
+		e_ctimer_set(E_CTIMER_1, E_CTIMER_MAX);
+		e_ctimer_start(E_CTIMER_1, E_CTIMER_CLK);
+		time_p = e_ctimer_get(E_CTIMER_1);
+
+		volatile unsigned int bytes = qleaf_decode(tris, &leaf.h);
+
+		time_c = e_ctimer_get(E_CTIMER_1);
+		code_clocks = time_p - time_c - time_compare;
+
+		time_p = e_ctimer_get(E_CTIMER_1);
+
+		volatile char hit = ray_triangle(&t, maxT, &tris[0], &r);
+
+		time_c = e_ctimer_get(E_CTIMER_1);
+		e_ctimer_stop(E_CTIMER_1);
+
+		sprintf(outbuf + strlen(outbuf),
+			"\"qleaf_decode()\": %d clocks for 2 triangles in %d "
+			"bytes(float: %d bytes), \"ray_triangle()\": %d "
+			"clocks, hit = %d.\n",
+			code_clocks, bytes, (int)(2 * sizeof(triangle_t)),
+			time_p - time_c - time_compare, hit);
+	}
+
+	mailbox[0] = 1;
+
 	return EXIT_SUCCESS;
 }
 #endif
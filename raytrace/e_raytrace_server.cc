@@ -0,0 +1,313 @@
+//
+// Persistent ray tracing kernel. Loaded once, then serves E_CMD_TRACE jobs
+// posted by host_server.c through the command queue(../common/e_cmdq.h)
+// until E_CMD_QUIT.
+//
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include "e_lib.h"
+#ifdef __cplusplus
+}
+#endif
+
+#include "e_banks.h"
+#include "e_cmdq.h"
+#include "raytrace.h"
+
+// Rays per chunk copied into local memory, also the pixels of one wavefront.
+#define TRACE_CHUNK (64)
+
+#if TRACE_CHUNK > PATH_WAVE
+#error "path_wavefront() takes at most PATH_WAVE pixels"
+#endif
+
+// Top BVH nodes kept in local memory, 6KB of bank 2 next to the ray buffers
+// (e_banks.h): 192 binary, 54 4-wide or 27 8-wide nodes.
+#define TRACE_LOCAL_BYTES (6144)
+
+typedef union {
+	bvh_node_t n2[TRACE_LOCAL_BYTES / sizeof(bvh_node_t)];
+	bvh4_node_t n4[TRACE_LOCAL_BYTES / sizeof(bvh4_node_t)];
+	bvh8_node_t n8[TRACE_LOCAL_BYTES / sizeof(bvh8_node_t)];
+} local_nodes_t;
+
+static E_CORE_LOCAL ray_t rays[TRACE_CHUNK] E_BANK_DATA;
+static E_CORE_LOCAL float hits[TRACE_CHUNK] E_BANK_DATA;
+static E_CORE_LOCAL local_nodes_t local_nodes E_BANK_NODES;
+static E_CORE_LOCAL bvh_cache_t node_cache E_BANK_WORK;
+// Bottom level scenes of SCENE_INSTANCES, all their nodes stay in DRAM.
+static E_CORE_LOCAL scene_view_t blas_views[SCENE_MAX_BLAS];
+
+static unsigned int node_size(unsigned int width)
+{
+	switch (width) {
+	case 4:
+		return sizeof(bvh4_node_t);
+	case 8:
+		return sizeof(bvh8_node_t);
+	default:
+		return sizeof(bvh_node_t);
+	}
+}
+
+static char valid_width(unsigned int width)
+{
+	return (width == 2) || (width == 4) || (width == 8);
+}
+
+// Views of the scene_t[num_blas] at `blas`. Returns 0 when one of them is
+// empty, instanced itself or has no kernel.
+static char blas_setup(unsigned int blas, unsigned int num_blas)
+{
+	scene_t scene;
+	unsigned int i;
+
+	if ((num_blas == 0) || (num_blas > SCENE_MAX_BLAS)) {
+		return 0;
+	}
+	for (i = 0; i < num_blas; i++) {
+		scene_view_t *v = &blas_views[i];
+
+		e_dma_copy(&scene, (scene_t *)E_SHM_PTR(blas) + i,
+			   sizeof(scene));
+		if ((scene.num_nodes == 0) || !valid_width(scene.width) ||
+		    (scene.format > SCENE_TRIS_QUANT)) {
+			return 0;
+		}
+		v->width = scene.width;
+		v->format = scene.format;
+		v->num_local = 0;
+		v->local = 0;
+		v->nodes = E_SHM_PTR(scene.nodes);
+		v->tris = E_SHM_PTR(scene.tris);
+		v->stats = 0;
+		v->cache = 0;
+		v->blas = 0;
+	}
+	return 1;
+}
+
+// RAYTRACE_SORT: order of rays[0, n) by ray_sort_key() in the bounds of
+// their origins. LSD radix sort of the top 12 key bits(octant and 3 Morton
+// bits per axis), 4 bits per pass.
+static void sort_chunk(unsigned char *order, unsigned int n)
+{
+	float bounds[2][3];
+	unsigned short key[TRACE_CHUNK];
+	unsigned char tmp[TRACE_CHUNK];
+	unsigned int count[16], i, d, sum, shift;
+	int k;
+
+	for (k = 0; k < 3; k++) {
+		bounds[0][k] = bounds[1][k] = rays[0].org[k];
+	}
+	for (i = 1; i < n; i++) {
+		for (k = 0; k < 3; k++) {
+			const float o = rays[i].org[k];
+			bounds[0][k] = (o < bounds[0][k]) ? o : bounds[0][k];
+			bounds[1][k] = (o > bounds[1][k]) ? o : bounds[1][k];
+		}
+	}
+	for (i = 0; i < n; i++) {
+		key[i] = ray_sort_key(&rays[i], bounds) >> 18;
+		order[i] = i;
+	}
+
+	for (shift = 0; shift < 12; shift += 4) {
+		memset(count, 0, sizeof(count));
+		for (i = 0; i < n; i++) {
+			count[(key[order[i]] >> shift) & 15]++;
+		}
+		for (d = 0, sum = 0; d < 16; d++) {
+			const unsigned int c = count[d];
+			count[d] = sum;
+			sum += c;
+		}
+		for (i = 0; i < n; i++) {
+			tmp[count[(key[order[i]] >> shift) & 15]++] = order[i];
+		}
+		memcpy(order, tmp, n);
+	}
+}
+
+// RAYTRACE_MODE_PATH/WAVEFRONT: adds samples to the framebuffer in place, a
+// chunk of pixels at a time.
+static int path_job(const e_cmd_t *cmd, const scene_view_t *view)
+{
+	path_params_t params;
+	path_stats_t st;
+	float *dst = (float *)E_SHM_PTR(cmd->dst);
+	unsigned int first, i, k;
+
+	memset(&st, 0, sizeof(st));
+	e_dma_copy(&params, E_SHM_PTR(cmd->src), sizeof(params));
+	first = (cmd->dst - params.fb) / sizeof(float);
+	if ((cmd->dst < params.fb) ||
+	    (first + cmd->count > params.width * params.height)) {
+		return E_CMD_EINVAL;
+	}
+
+	for (i = 0; i < cmd->count; i += TRACE_CHUNK) {
+		unsigned int n = cmd->count - i;
+		n = (n > TRACE_CHUNK) ? TRACE_CHUNK : n;
+
+		e_dma_copy(hits, dst + i, n * sizeof(float));
+		if ((cmd->arg[2] & RAYTRACE_MODE_MASK) ==
+		    RAYTRACE_MODE_WAVEFRONT) {
+			path_wavefront(hits, first + i, n, &params, view, &st);
+		} else {
+			path_trace(hits, first + i, n, &params, view);
+		}
+		e_dma_copy(dst + i, hits, n * sizeof(float));
+	}
+
+	// Summed into this core's slot like bvh_stats_t.
+	if (((cmd->arg[2] & RAYTRACE_MODE_MASK) == RAYTRACE_MODE_WAVEFRONT) &&
+	    params.stats) {
+		path_stats_t *slot = (path_stats_t *)E_SHM_PTR(params.stats) +
+				     e_group_config.core_row *
+					     e_group_config.group_cols +
+				     e_group_config.core_col;
+		for (k = 0; k < PATH_NUM_STAGES; k++) {
+			slot->clocks[k] += st.clocks[k];
+		}
+		slot->paths += st.paths;
+		for (k = 0; k < PATH_STATS_BOUNCES; k++) {
+			slot->active[k] += st.active[k];
+		}
+	}
+
+	return E_CMD_OK;
+}
+
+static int trace_job(const e_cmd_t *cmd)
+{
+	float bbox[2][3];
+	scene_t scene;
+	scene_view_t view;
+	bvh_stats_t st;
+	union {
+		unsigned int i;
+		float f;
+	} maxT;
+	const unsigned int mode = cmd->arg[2] & RAYTRACE_MODE_MASK;
+	const char sort = (cmd->arg[2] & RAYTRACE_SORT) != 0;
+	const ray_t *src = (const ray_t *)E_SHM_PTR(cmd->src);
+	float *dst = (float *)E_SHM_PTR(cmd->dst);
+	unsigned char order[TRACE_CHUNK];
+	unsigned int i, k, nrays;
+
+	memset(&st, 0, sizeof(st));
+	maxT.i = cmd->arg[1];
+	if (mode == RAYTRACE_MODE_AABB) {
+		e_dma_copy(bbox, E_SHM_PTR(cmd->arg[0]), sizeof(bbox));
+	} else if (mode <= RAYTRACE_MODE_WAVEFRONT) {
+		e_dma_copy(&scene, E_SHM_PTR(cmd->arg[0]), sizeof(scene));
+		if ((scene.num_nodes == 0) || !valid_width(scene.width) ||
+		    (scene.format > SCENE_INSTANCES) ||
+		    ((scene.format == SCENE_INSTANCES) &&
+		     !blas_setup(scene.blas, scene.num_blas))) {
+			return E_CMD_EINVAL;
+		}
+		view.width = scene.width;
+		view.format = scene.format;
+		view.local = &local_nodes;
+		view.nodes = E_SHM_PTR(scene.nodes);
+		view.tris = E_SHM_PTR(scene.tris);
+		view.stats = scene.stats ? &st : 0;
+		view.cache = scene.cache ? &node_cache : 0;
+		view.blas = (scene.format == SCENE_INSTANCES) ? blas_views : 0;
+		if (view.cache) {
+			bvh_cache_clear(view.cache);
+		}
+		view.num_local = TRACE_LOCAL_BYTES / node_size(scene.width);
+		view.num_local = (scene.num_nodes < view.num_local)
+					 ? scene.num_nodes
+					 : view.num_local;
+		e_dma_copy(&local_nodes, (void *)view.nodes,
+			   view.num_local * node_size(scene.width));
+	} else {
+		return E_CMD_EINVAL;
+	}
+
+	if ((mode == RAYTRACE_MODE_PATH) || (mode == RAYTRACE_MODE_WAVEFRONT)) {
+		const int status = path_job(cmd, &view);
+		if (status != E_CMD_OK) {
+			return status;
+		}
+	}
+
+	// Path jobs have no rays in src.
+	nrays = ((mode == RAYTRACE_MODE_PATH) ||
+		 (mode == RAYTRACE_MODE_WAVEFRONT))
+			? 0
+			: cmd->count;
+	for (i = 0; i < nrays; i += TRACE_CHUNK) {
+		unsigned int n = nrays - i;
+		n = (n > TRACE_CHUNK) ? TRACE_CHUNK : n;
+
+		e_dma_copy(rays, (void *)(src + i), n * sizeof(ray_t));
+		if (sort) {
+			sort_chunk(order, n);
+		}
+		for (k = 0; k < n; k++) {
+			const unsigned int j = sort ? order[k] : k;
+			ray_pre_t r;
+			ray_setup(&r, &rays[j]);
+
+			if (mode == RAYTRACE_MODE_AABB) {
+				float outT[2];
+				char hit = ray_aabb(outT, maxT.f, bbox, r.ov,
+						    r.invdir, r.dirsign);
+				hits[j] = hit ? outT[0] : -1.0f;
+			} else if (mode == RAYTRACE_MODE_CLOSEST) {
+				hits[j] = scene_closest(&view, &r, maxT.f, 0);
+			} else {
+				hits[j] = scene_occluded(&view, &r, maxT.f)
+						  ? 0.0f
+						  : -1.0f;
+			}
+		}
+		e_dma_copy(dst + i, hits, n * sizeof(float));
+	}
+
+	// Counters are summed into this core's slot, the host clears them.
+	if ((mode != RAYTRACE_MODE_AABB) && scene.stats) {
+		bvh_stats_t *slot = (bvh_stats_t *)E_SHM_PTR(scene.stats) +
+				    e_group_config.core_row *
+					    e_group_config.group_cols +
+				    e_group_config.core_col;
+		slot->rays += st.rays;
+		slot->steps += st.steps;
+		slot->box_tests += st.box_tests;
+		slot->tri_tests += st.tri_tests;
+		slot->bytes += st.bytes;
+		slot->fetches += st.fetches;
+	}
+
+	return E_CMD_OK;
+}
+
+static int raytrace_server_handler(const e_cmd_t *cmd)
+{
+	switch (cmd->op) {
+	case E_CMD_TRACE:
+		return trace_job(cmd);
+	default:
+		return E_CMD_EUNKNOWN;
+	}
+}
+
+#ifdef E_HOST_SHIM
+extern "C"
+#endif
+int main(void)
+{
+	e_cmdq_serve(e_cmdq_self(), raytrace_server_handler);
+
+	return EXIT_SUCCESS;
+}
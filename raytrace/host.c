@@ -71,9 +71,10 @@ int main(int argc, char *argv[])
 	// platform.cols,
 	// E_FALSE);
 
-	// To test
-	e_load_group("e_raytrace.srec", &dev, 0, 0, platform.rows,
-		     platform.cols, E_FALSE);
+	// To test. Optionally pass another build of the test program,
+	// e.g. one built with different bank placement.
+	e_load_group((argc > 1) ? argv[1] : "e_raytrace.srec", &dev, 0, 0,
+		     platform.rows, platform.cols, E_FALSE);
 
 	for (i = 0; i < platform.rows; i++) {
 		for (j = 0; j < platform.cols; j++) {
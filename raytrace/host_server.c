@@ -0,0 +1,1178 @@
+//
+// HOST side of the persistent ray tracing kernel(e_raytrace_server.cc).
+//
+// Loads the program once, then dispatches primary-ray jobs through the
+// command queue(../common/e_cmdq.h) and reports program load cost, per-job
+// dispatch latency and rays/second.
+//
+// Then traces a random triangle scene(BVH built by bvh_build.c): primary rays
+// with closest hit, and shadow rays from every hit point with both closest
+// hit and the any-hit occlusion kernel, then renders it progressively with
+// the fog path tracer(e_path.cc) into PATH_IMAGE.
+//
+// Last, INST_GRID^3 placed copies of one sphere mesh are traced as a
+// two-level scene(SCENE_INSTANCES, tlas_build.c) and as the same triangles
+// flattened into one BVH, for memory and traversal cost.
+//
+#include <math.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <e-hal.h>
+
+#include "e_arena.h"
+#include "e_cmdq.h"
+#include "raytrace.h"
+
+#define IMAGE_SIZE (128) // IMAGE_SIZE x IMAGE_SIZE primary rays
+#define NUM_FRAMES (16)
+#define NUM_LATENCY_JOBS (256)
+#define WAIT_READY_MICROSECONDS (1000000)
+#define SCENE_NUM_TRIS (1024) // random triangles
+#define SCENE_GROUND_N (16)   // ground grid, 2 * 16^2 triangles
+#define TRI_BUDGET_BYTES (16384) // local memory a core could give triangles
+#define PATH_FRAMES (16)	 // progressive frames
+#define PATH_SPP (1)		 // samples per pixel per frame
+#define PATH_IMAGE "path.pgm"
+#define INST_GRID (4)		 // INST_GRID^3 instances
+#define INST_LAT (8)		 // sphere mesh rings
+#define INST_LON (12)		 // sphere mesh segments
+#define TRACE_JSON "raytrace_server.trace.json" // with E_TRACE, see e_trace.h
+
+static double now_usec(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec * 1e-3;
+}
+
+static void wait_one(e_cmdq_t *q, e_cmpl_t *cmpl)
+{
+	while (!e_cmdq_reap(q, cmpl)) {
+	}
+}
+
+typedef union {
+	float f;
+	unsigned int i;
+} bits_t;
+
+// NUM_FRAMES passes over rays[0, nrays), split evenly over the cores.
+// Returns the wall time in us, *clocks gets the e-core clocks summed over all
+// jobs of one frame.
+static double run_frames(e_cmdq_t *queues, unsigned ncores, const e_buf_t *ray_buf,
+			 const e_buf_t *hit_buf, unsigned nrays,
+			 uint32_t scene_off, float maxT, uint32_t mode,
+			 unsigned long long *clocks)
+{
+	const unsigned rays_per_core = (nrays + ncores - 1) / ncores;
+	bits_t t;
+	double t0;
+	unsigned i, k;
+
+	t.f = maxT;
+	*clocks = 0;
+	t0 = now_usec();
+	for (i = 0; i < NUM_FRAMES; i++) {
+		for (k = 0; k < ncores; k++) {
+			e_cmd_t cmd;
+			unsigned first = k * rays_per_core;
+
+			if (first >= nrays) {
+				break;
+			}
+			memset(&cmd, 0, sizeof(cmd));
+			cmd.op = E_CMD_TRACE;
+			cmd.seq = i;
+			cmd.src = ray_buf->off + first * sizeof(ray_t);
+			cmd.dst = hit_buf->off + first * sizeof(float);
+			cmd.count = (first + rays_per_core > nrays)
+					? nrays - first
+					: rays_per_core;
+			cmd.arg[0] = scene_off;
+			cmd.arg[1] = t.i;
+			cmd.arg[2] = mode;
+			while (e_cmdq_post(&queues[k], &cmd) != 0) {
+			}
+		}
+		for (k = 0; k < ncores && k * rays_per_core < nrays; k++) {
+			e_cmpl_t cmpl;
+			wait_one(&queues[k], &cmpl);
+			if (cmpl.status != E_CMD_OK) {
+				fprintf(stderr, "??? trace job failed(%d)\n",
+					cmpl.status);
+			}
+			*clocks += (i == 0) ? cmpl.clocks : 0;
+		}
+	}
+	return now_usec() - t0;
+}
+
+// One progressive path tracing frame over pixels [0, npixels), `mode` is
+// RAYTRACE_MODE_PATH or RAYTRACE_MODE_WAVEFRONT. Adds the e-core clocks of
+// all jobs to *clocks.
+static void run_path_frame(e_cmdq_t *queues, unsigned ncores,
+			   uint32_t param_off, const e_buf_t *fb_buf,
+			   unsigned npixels, uint32_t scene_off, uint32_t mode,
+			   unsigned long long *clocks)
+{
+	const unsigned per_core = (npixels + ncores - 1) / ncores;
+	unsigned k;
+
+	for (k = 0; k < ncores && k * per_core < npixels; k++) {
+		e_cmd_t cmd;
+		const unsigned first = k * per_core;
+
+		memset(&cmd, 0, sizeof(cmd));
+		cmd.op = E_CMD_TRACE;
+		cmd.src = param_off;
+		cmd.dst = fb_buf->off + first * sizeof(float);
+		cmd.count = (first + per_core > npixels) ? npixels - first
+							 : per_core;
+		cmd.arg[0] = scene_off;
+		cmd.arg[2] = mode;
+		while (e_cmdq_post(&queues[k], &cmd) != 0) {
+		}
+	}
+	for (k = 0; k < ncores && k * per_core < npixels; k++) {
+		e_cmpl_t cmpl;
+		wait_one(&queues[k], &cmpl);
+		if (cmpl.status != E_CMD_OK) {
+			fprintf(stderr, "??? path job failed(%d)\n",
+				cmpl.status);
+		}
+		*clocks += cmpl.clocks;
+	}
+}
+
+// Average of `frames` frames, L / (1 + L) and gamma 2.2, as binary PGM.
+static void write_pgm(const char *filename, const float *fb, unsigned width,
+		      unsigned height, unsigned frames)
+{
+	FILE *fp = fopen(filename, "wb");
+	unsigned i;
+
+	if (!fp) {
+		fprintf(stderr, "??? can't write %s\n", filename);
+		return;
+	}
+	fprintf(fp, "P5\n%u %u\n255\n", width, height);
+	// Row 0 is the bottom of the image(v = -1).
+	for (i = 0; i < width * height; i++) {
+		const unsigned row = height - 1 - i / width;
+		const float L = fb[row * width + i % width] / frames;
+		fputc((int)(255.0f * powf(L / (1.0f + L), 1.0f / 2.2f) + 0.5f),
+		      fp);
+	}
+	fclose(fp);
+}
+
+// Traversal counters of one run_frames() pass, summed over the cores.
+static void sum_stats(bvh_stats_t *sum, e_buf_t *stats_buf, unsigned ncores,
+		      int clear)
+{
+	bvh_stats_t *st = (bvh_stats_t *)stats_buf->ptr;
+	unsigned k;
+
+	memset(sum, 0, sizeof(*sum));
+	for (k = 0; k < ncores; k++) {
+		sum->rays += st[k].rays;
+		sum->steps += st[k].steps;
+		sum->box_tests += st[k].box_tests;
+		sum->tri_tests += st[k].tri_tests;
+		sum->bytes += st[k].bytes;
+		sum->fetches += st[k].fetches;
+	}
+	if (clear) {
+		memset(st, 0, ncores * sizeof(bvh_stats_t));
+	}
+}
+
+static void print_stats(const char *name, unsigned width, unsigned num_nodes,
+			const bvh_stats_t *st, unsigned long long clocks,
+			unsigned nrays, unsigned mismatch)
+{
+	const double rays = st->rays ? st->rays : 1;
+	fprintf(stderr, "[raytrace_server] %-10s %u-wide %4u nodes | %6.1f "
+			"steps %6.1f boxes %5.1f tris %7.0f bytes %7llu "
+			"clocks /ray | %u mismatches\n",
+		name, width, num_nodes, st->steps / rays, st->box_tests / rays,
+		st->tri_tests / rays, st->bytes / rays,
+		nrays ? clocks / nrays : 0, mismatch);
+}
+
+static float frand(float lo, float hi)
+{
+	return lo + (hi - lo) * (float)rand() / (float)RAND_MAX;
+}
+
+// SCENE_NUM_TRIS random small triangles(soup) over a SCENE_GROUND_N^2 quad
+// grid at y = -1(mesh).
+static void make_scene(triangle_t *tris)
+{
+	const float cell = 20.0f / SCENE_GROUND_N;
+	unsigned i, k, x, z;
+
+	for (i = 0; i < SCENE_NUM_TRIS; i++) {
+		for (k = 0; k < 3; k++) {
+			tris[i].v0[k] = frand(-1.5f, 1.5f);
+			tris[i].e1[k] = frand(-0.25f, 0.25f);
+			tris[i].e2[k] = frand(-0.25f, 0.25f);
+		}
+	}
+	for (z = 0; z < SCENE_GROUND_N; z++) {
+		for (x = 0; x < SCENE_GROUND_N; x++) {
+			for (k = 0; k < 2; k++) {
+				triangle_t *g = &tris[i++];
+				g->v0[0] = -10.0f + (x + k) * cell;
+				g->v0[1] = -1.0f;
+				g->v0[2] = -10.0f + (z + k) * cell;
+				g->e1[0] = k ? -cell : cell;
+				g->e1[1] = 0.0f;
+				g->e1[2] = 0.0f;
+				g->e2[0] = 0.0f;
+				g->e2[1] = 0.0f;
+				g->e2[2] = k ? -cell : cell;
+			}
+		}
+	}
+}
+
+static void set_vertex(float v[3], unsigned lat, unsigned lon)
+{
+	const float theta = (float)M_PI * lat / INST_LAT;
+	const float phi = 2.0f * (float)M_PI * lon / INST_LON;
+	v[0] = sinf(theta) * cosf(phi);
+	v[1] = cosf(theta);
+	v[2] = sinf(theta) * sinf(phi);
+}
+
+static void set_tri(triangle_t *tri, const float a[3], const float b[3],
+		    const float c[3])
+{
+	unsigned k;
+	for (k = 0; k < 3; k++) {
+		tri->v0[k] = a[k];
+		tri->e1[k] = b[k] - a[k];
+		tri->e2[k] = c[k] - a[k];
+	}
+}
+
+// Unit sphere, INST_LAT x INST_LON quads with one triangle at the poles.
+// Returns the number of triangles.
+static unsigned make_sphere(triangle_t *tris)
+{
+	unsigned n = 0, lat, lon;
+
+	for (lat = 0; lat < INST_LAT; lat++) {
+		for (lon = 0; lon < INST_LON; lon++) {
+			float v00[3], v01[3], v10[3], v11[3];
+			set_vertex(v00, lat, lon);
+			set_vertex(v01, lat, lon + 1);
+			set_vertex(v10, lat + 1, lon);
+			set_vertex(v11, lat + 1, lon + 1);
+			if (lat != INST_LAT - 1) {
+				set_tri(&tris[n++], v00, v10, v11);
+			}
+			if (lat != 0) {
+				set_tri(&tris[n++], v00, v11, v01);
+			}
+		}
+	}
+	return n;
+}
+
+// Object to world: scale, rotation about y, then translation.
+static void make_transform(float m[3][4], const float scale[3], float angle,
+			   const float pos[3])
+{
+	const float c = cosf(angle), s = sinf(angle);
+
+	memset(m, 0, 12 * sizeof(float));
+	m[0][0] = c * scale[0];
+	m[0][2] = s * scale[2];
+	m[1][1] = scale[1];
+	m[2][0] = -s * scale[0];
+	m[2][2] = c * scale[2];
+	m[0][3] = pos[0];
+	m[1][3] = pos[1];
+	m[2][3] = pos[2];
+}
+
+static void transform_tri(triangle_t *out, const triangle_t *in,
+			  const float m[3][4])
+{
+	unsigned j;
+	for (j = 0; j < 3; j++) {
+		out->v0[j] = m[j][0] * in->v0[0] + m[j][1] * in->v0[1] +
+			     m[j][2] * in->v0[2] + m[j][3];
+		out->e1[j] = m[j][0] * in->e1[0] + m[j][1] * in->e1[1] +
+			     m[j][2] * in->e1[2];
+		out->e2[j] = m[j][0] * in->e2[0] + m[j][1] * in->e2[1] +
+			     m[j][2] * in->e2[2];
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned i, k, ncores, nrays;
+	e_platform_t platform;
+	e_epiphany_t dev;
+	e_mem_t qmem;
+#if E_TRACE
+	e_mem_t tmem;
+#endif
+	e_arena_t arena;
+	e_buf_t bbox_buf, ray_buf, hit_buf;
+	e_cmdq_t *queues;
+	float(*bbox)[3];
+	ray_t *rays;
+	float *hits;
+	double t0, t1, load_usec, lat_sum;
+	unsigned long long clocks;
+	bits_t maxT;
+	unsigned nhits;
+
+	e_init(NULL);
+	e_reset_system();
+	e_get_platform_info(&platform);
+
+	ncores = platform.rows * platform.cols;
+	nrays = IMAGE_SIZE * IMAGE_SIZE;
+
+	e_alloc(&qmem, E_SHM_CMDQ_OFFSET, ncores * sizeof(e_cmdq_t));
+#if E_TRACE
+	e_alloc(&tmem, E_SHM_TRACE_OFFSET, ncores * sizeof(e_trace_ring_t));
+	e_trace_clear(tmem.base, ncores);
+#endif
+	e_arena_init(&arena, E_SHM_DATA_OFFSET, E_SHM_DATA_SIZE);
+	queues = (e_cmdq_t *)qmem.base;
+	if ((e_arena_alloc(&arena, sizeof(float) * 6, 8, 0, &bbox_buf) !=
+	     E_OK) ||
+	    (e_arena_alloc(&arena, nrays * sizeof(ray_t), 64, 0, &ray_buf) !=
+	     E_OK) ||
+	    (e_arena_alloc(&arena, nrays * sizeof(float), 64, 0, &hit_buf) !=
+	     E_OK)) {
+		fprintf(stderr, "??? out of shared DRAM\n");
+		return EXIT_FAILURE;
+	}
+	bbox = (float(*)[3])bbox_buf.ptr;
+	rays = (ray_t *)ray_buf.ptr;
+	hits = (float *)hit_buf.ptr;
+
+	for (i = 0; i < ncores; i++) {
+		e_cmdq_init(&queues[i]);
+	}
+
+	for (k = 0; k < 3; k++) {
+		bbox[0][k] = -1.0f;
+		bbox[1][k] = 1.0f;
+	}
+	for (i = 0; i < nrays; i++) {
+		float u = 2.0f * ((i % IMAGE_SIZE) + 0.5f) / IMAGE_SIZE - 1.0f;
+		float v = 2.0f * ((i / IMAGE_SIZE) + 0.5f) / IMAGE_SIZE - 1.0f;
+		rays[i].org[0] = 0.0f;
+		rays[i].org[1] = 0.0f;
+		rays[i].org[2] = -5.0f;
+		rays[i].dir[0] = u * 0.5f;
+		rays[i].dir[1] = v * 0.5f;
+		rays[i].dir[2] = 1.0f;
+	}
+	maxT.f = 1.0e+30f;
+
+	e_open(&dev, 0, 0, platform.rows, platform.cols);
+
+	t0 = now_usec();
+	e_load_group("e_raytrace_server.srec", &dev, 0, 0, platform.rows,
+		     platform.cols, E_FALSE);
+	e_start_group(&dev);
+	for (i = 0; i < ncores; i++) {
+		while (!e_cmdq_ready(&queues[i])) {
+			if (now_usec() - t0 > WAIT_READY_MICROSECONDS) {
+				fprintf(stderr, "??? core %u did not start\n", i);
+				return EXIT_FAILURE;
+			}
+		}
+	}
+	load_usec = now_usec() - t0;
+
+	// Latency: single ray on core 0.
+	lat_sum = 0.0;
+	for (i = 0; i < NUM_LATENCY_JOBS; i++) {
+		e_cmd_t cmd;
+		e_cmpl_t cmpl;
+
+		memset(&cmd, 0, sizeof(cmd));
+		cmd.op = E_CMD_TRACE;
+		cmd.seq = i;
+		cmd.src = ray_buf.off;
+		cmd.dst = hit_buf.off;
+		cmd.count = 1;
+		cmd.arg[0] = bbox_buf.off;
+		cmd.arg[1] = maxT.i;
+		cmd.arg[2] = RAYTRACE_MODE_AABB;
+
+		t0 = now_usec();
+		e_cmdq_post(&queues[0], &cmd);
+		wait_one(&queues[0], &cmpl);
+		lat_sum += now_usec() - t0;
+	}
+
+	// Throughput: one frame = one job per core.
+	t1 = run_frames(queues, ncores, &ray_buf, &hit_buf, nrays, bbox_buf.off,
+			maxT.f, RAYTRACE_MODE_AABB, &clocks);
+
+	nhits = 0;
+	for (i = 0; i < nrays; i++) {
+		nhits += (hits[i] >= 0.0f);
+	}
+
+	fprintf(stderr, "[raytrace_server] cores = %u\n", ncores);
+	fprintf(stderr, "[raytrace_server] load + start = %.1f us\n", load_usec);
+	fprintf(stderr, "[raytrace_server] dispatch latency(1 ray) = %.2f us\n",
+		lat_sum / NUM_LATENCY_JOBS);
+	fprintf(stderr, "[raytrace_server] %d frames x %u rays: %.1f us, "
+			"%.2f Mrays/s, %u hits/frame\n",
+		NUM_FRAMES, nrays, t1, (double)NUM_FRAMES * nrays / t1, nhits);
+
+	// BVH scene. Shadow rays start at every primary hit and go towards a
+	// directional light.
+	{
+		const unsigned job = 1;
+		const float light[3] = {0.3f, 0.9f, -0.3f};
+		const unsigned ntris =
+			SCENE_NUM_TRIS + 2 * SCENE_GROUND_N * SCENE_GROUND_N;
+		e_buf_t scene_buf, node_buf, tri_buf, shadow_buf, occl_buf;
+		e_buf_t wide_buf[4], stats_buf, qnode_buf, qleaf_buf;
+		unsigned qbytes;
+		scene_t *scene;
+		ray_t *shadow;
+		float *occl;
+		unsigned nshadow, nclosest, noccluded, mismatch;
+		double tp, tc, to;
+		unsigned long long cp, cc, co;
+
+		if ((e_arena_alloc(&arena, 8 * sizeof(scene_t), 8, job,
+				   &scene_buf) != E_OK) ||
+		    (e_arena_alloc(&arena, ntris * sizeof(bvh4_node_t), 64,
+				   job, &wide_buf[0]) != E_OK) ||
+		    (e_arena_alloc(&arena, ntris * sizeof(bvh8_node_t), 64,
+				   job, &wide_buf[1]) != E_OK) ||
+		    (e_arena_alloc(&arena, ntris * sizeof(bvh4_node_t), 64,
+				   job, &wide_buf[2]) != E_OK) ||
+		    (e_arena_alloc(&arena, ntris * sizeof(bvh8_node_t), 64,
+				   job, &wide_buf[3]) != E_OK) ||
+		    (e_arena_alloc(&arena, (2 * ntris - 1) * sizeof(bvh_node_t),
+				   64, job, &qnode_buf) != E_OK) ||
+		    (e_arena_alloc(&arena, ntris * QLEAF_MAX_BYTES, 64, job,
+				   &qleaf_buf) != E_OK) ||
+		    (e_arena_alloc(&arena, ncores * sizeof(bvh_stats_t), 8, job,
+				   &stats_buf) != E_OK) ||
+		    (e_arena_alloc(&arena, (2 * ntris - 1) * sizeof(bvh_node_t),
+				   64, job, &node_buf) != E_OK) ||
+		    (e_arena_alloc(&arena, ntris * sizeof(triangle_t), 64, job,
+				   &tri_buf) != E_OK) ||
+		    (e_arena_alloc(&arena, nrays * sizeof(ray_t), 64, job,
+				   &shadow_buf) != E_OK) ||
+		    (e_arena_alloc(&arena, nrays * sizeof(float), 64, job,
+				   &occl_buf) != E_OK)) {
+			fprintf(stderr, "??? out of shared DRAM\n");
+			return EXIT_FAILURE;
+		}
+		scene = (scene_t *)scene_buf.ptr;
+		shadow = (ray_t *)shadow_buf.ptr;
+		occl = (float *)occl_buf.ptr;
+
+		srand(1);
+		make_scene((triangle_t *)tri_buf.ptr);
+		t0 = now_usec();
+		scene->num_nodes = bvh_build((bvh_node_t *)node_buf.ptr,
+					     (triangle_t *)tri_buf.ptr, ntris);
+		t0 = now_usec() - t0;
+		scene->num_tris = ntris;
+		scene->nodes = node_buf.off;
+		scene->tris = tri_buf.off;
+		scene->width = 2;
+		scene->stats = 0;
+		scene->format = SCENE_TRIS_FLOAT;
+		scene->cache = 0;
+
+		// Quantized copy of the same tree.
+		memcpy(qnode_buf.ptr, node_buf.ptr,
+		       scene->num_nodes * sizeof(bvh_node_t));
+		qbytes = bvh_quantize(qleaf_buf.ptr, (bvh_node_t *)qnode_buf.ptr,
+				      scene->num_nodes,
+				      (const triangle_t *)tri_buf.ptr);
+
+		tp = run_frames(queues, ncores, &ray_buf, &hit_buf, nrays,
+				scene_buf.off, maxT.f, RAYTRACE_MODE_CLOSEST,
+				&cp);
+
+		nshadow = 0;
+		for (i = 0; i < nrays; i++) {
+			if (hits[i] < 0.0f) {
+				continue;
+			}
+			for (k = 0; k < 3; k++) {
+				// Step back a little to stay off the surface.
+				shadow[nshadow].org[k] =
+					rays[i].org[k] +
+					rays[i].dir[k] * hits[i] * 0.9999f;
+				shadow[nshadow].dir[k] = light[k];
+			}
+			nshadow++;
+		}
+
+		tc = run_frames(queues, ncores, &shadow_buf, &hit_buf, nshadow,
+				scene_buf.off, maxT.f, RAYTRACE_MODE_CLOSEST,
+				&cc);
+		to = run_frames(queues, ncores, &shadow_buf, &occl_buf,
+				nshadow, scene_buf.off, maxT.f,
+				RAYTRACE_MODE_OCCLUDED, &co);
+
+		nclosest = noccluded = mismatch = 0;
+		for (i = 0; i < nshadow; i++) {
+			nclosest += (hits[i] >= 0.0f);
+			noccluded += (occl[i] >= 0.0f);
+			mismatch += ((hits[i] >= 0.0f) != (occl[i] >= 0.0f));
+		}
+
+		fprintf(stderr, "[raytrace_server] scene: %u triangles, "
+				"%u BVH nodes(%.1f ms to build)\n",
+			ntris, scene->num_nodes, t0 * 1e-3);
+		fprintf(stderr, "[raytrace_server] primary, closest hit: "
+				"%.2f Mrays/s, %llu clocks/ray\n",
+			(double)NUM_FRAMES * nrays / tp, cp / nrays);
+		if (nshadow > 0) {
+			fprintf(stderr,
+				"[raytrace_server] %u shadow rays, closest hit: "
+				"%.2f Mrays/s, %llu clocks/ray\n",
+				nshadow, (double)NUM_FRAMES * nshadow / tc,
+				cc / nshadow);
+			fprintf(stderr,
+				"[raytrace_server] %u shadow rays, occluded: "
+				"%.2f Mrays/s, %llu clocks/ray(%.2fx)\n",
+				nshadow, (double)NUM_FRAMES * nshadow / to,
+				co / nshadow, tc / to);
+		}
+		fprintf(stderr, "[raytrace_server] in shadow: %u(closest), "
+				"%u(occluded), %u mismatches\n",
+			nclosest, noccluded, mismatch);
+
+		// Binary vs. 4/8 wide, float vs. quantized triangles on the same
+		// scene and rays, with traversal counters. Results are checked
+		// against binary float; quantized vertices move by up to half a
+		// step(1/65535 of the leaf), so a few edge rays may differ.
+		{
+			float *ref_closest = malloc(nrays * sizeof(float));
+			float *ref_occluded = malloc(nshadow * sizeof(float));
+			unsigned c;
+
+			for (c = 0; c < 6; c++) {
+				const unsigned w = c % 3;
+				const unsigned width = 2 << w;
+				const unsigned quant = c / 3;
+				const char *name[2][2] = {
+					{"closest", "occluded"},
+					{"closest/q", "occluded/q"}};
+				scene_t *sc = &scene[c];
+				const uint32_t sc_off =
+					scene_buf.off + c * sizeof(scene_t);
+				const e_buf_t *nb = quant ? &qnode_buf : &node_buf;
+				bvh_stats_t st;
+
+				*sc = scene[0];
+				sc->width = width;
+				sc->stats = stats_buf.off;
+				sc->nodes = nb->off;
+				if (quant) {
+					sc->tris = qleaf_buf.off;
+					sc->format = SCENE_TRIS_QUANT;
+				}
+				if (w > 0) {
+					const e_buf_t *wb =
+						&wide_buf[quant * 2 + w - 1];
+					sc->nodes = wb->off;
+					sc->num_nodes = bvh_collapse(
+						wb->ptr, width,
+						(const bvh_node_t *)nb->ptr);
+				}
+				memset(stats_buf.ptr, 0,
+				       ncores * sizeof(bvh_stats_t));
+
+				run_frames(queues, ncores, &ray_buf, &hit_buf,
+					   nrays, sc_off, maxT.f,
+					   RAYTRACE_MODE_CLOSEST, &cp);
+				sum_stats(&st, &stats_buf, ncores, 1);
+				mismatch = 0;
+				for (i = 0; i < nrays; i++) {
+					if (c == 0) {
+						ref_closest[i] = hits[i];
+					}
+					mismatch += (fabsf(hits[i] -
+							   ref_closest[i]) >
+						     1.0e-3f);
+				}
+				print_stats(name[quant][0], width, sc->num_nodes,
+					    &st, cp, nrays, mismatch);
+
+				run_frames(queues, ncores, &shadow_buf,
+					   &occl_buf, nshadow, sc_off, maxT.f,
+					   RAYTRACE_MODE_OCCLUDED, &co);
+				sum_stats(&st, &stats_buf, ncores, 1);
+				mismatch = 0;
+				for (i = 0; i < nshadow; i++) {
+					if (c == 0) {
+						ref_occluded[i] = occl[i];
+					}
+					mismatch += (occl[i] != ref_occluded[i]);
+				}
+				print_stats(name[quant][1], width, sc->num_nodes,
+					    &st, co, nshadow, mismatch);
+			}
+
+			free(ref_closest);
+			free(ref_occluded);
+		}
+
+		fprintf(stderr, "[raytrace_server] triangles: float %u "
+				"bytes/tri, quantized %.1f bytes/tri(%u bytes), "
+				"%u vs. %u triangles in %u bytes per core\n",
+			(unsigned)sizeof(triangle_t), (double)qbytes / ntris,
+			qbytes, TRI_BUDGET_BYTES / (unsigned)sizeof(triangle_t),
+			(unsigned)((double)TRI_BUDGET_BYTES * ntris / qbytes),
+			TRI_BUDGET_BYTES);
+
+		// Ray reordering on incoherent secondary rays: random directions
+		// from the primary hits(hits still holds them), in random
+		// order. Traced with the node cache unsorted, sorted per chunk
+		// on the core(RAYTRACE_SORT) and sorted on the host
+		// (ray_sort()), against no cache as the reference.
+		{
+			const unsigned nthreads =
+				(unsigned)sysconf(_SC_NPROCESSORS_ONLN);
+			const char *name[4] = {"unsorted", "cached",
+					       "core sort", "host sort"};
+			e_buf_t sec_buf, sorted_buf;
+			ray_t *sec, *sorted;
+			float *ref = malloc(nrays * sizeof(float));
+			unsigned *perm = malloc(nrays * sizeof(unsigned));
+			unsigned nsec = 0, w, v;
+			double ts;
+
+			if ((e_arena_alloc(&arena, nrays * sizeof(ray_t), 64, job,
+					   &sec_buf) != E_OK) ||
+			    (e_arena_alloc(&arena, nrays * sizeof(ray_t), 64, job,
+					   &sorted_buf) != E_OK)) {
+				fprintf(stderr, "??? out of shared DRAM\n");
+				return EXIT_FAILURE;
+			}
+			sec = (ray_t *)sec_buf.ptr;
+			sorted = (ray_t *)sorted_buf.ptr;
+
+			for (i = 0; i < nrays; i++) {
+				float d[3], l2;
+
+				if (hits[i] < 0.0f) {
+					continue;
+				}
+				do {
+					for (k = 0; k < 3; k++) {
+						d[k] = frand(-1.0f, 1.0f);
+					}
+					l2 = d[0] * d[0] + d[1] * d[1] +
+					     d[2] * d[2];
+				} while ((l2 > 1.0f) || (l2 < 1.0e-4f));
+				for (k = 0; k < 3; k++) {
+					sec[nsec].org[k] =
+						rays[i].org[k] +
+						rays[i].dir[k] * hits[i] *
+							0.9999f;
+					sec[nsec].dir[k] = d[k];
+				}
+				nsec++;
+			}
+			for (i = nsec; i > 1; i--) {
+				const unsigned j = rand() % i;
+				const ray_t tmp = sec[i - 1];
+				sec[i - 1] = sec[j];
+				sec[j] = tmp;
+			}
+
+			memcpy(sorted, sec, nsec * sizeof(ray_t));
+			ts = now_usec();
+			ray_sort(sorted, perm, nsec,
+				 ((const bvh_node_t *)node_buf.ptr)->bbox,
+				 nthreads);
+			ts = now_usec() - ts;
+			fprintf(stderr, "[raytrace_server] reorder: %u secondary "
+					"rays, host sort %.2f ms(%u threads)\n",
+				nsec, ts * 1e-3, nthreads);
+
+			// Binary and 4-wide float trees.
+			for (w = 0; w < 2; w++) {
+				scene_t *sc = &scene[6 + w];
+				const uint32_t sc_off =
+					scene_buf.off + (6 + w) * sizeof(scene_t);
+
+				*sc = scene[w ? 1 : 0];
+				sc->stats = stats_buf.off;
+				for (v = 0; v < 4; v++) {
+					const int host = (v == 3);
+					bvh_stats_t st;
+					double tr;
+
+					sc->cache = (v > 0);
+					memset(stats_buf.ptr, 0,
+					       ncores * sizeof(bvh_stats_t));
+					tr = run_frames(
+						queues, ncores,
+						host ? &sorted_buf : &sec_buf,
+						&hit_buf, nsec, sc_off, maxT.f,
+						RAYTRACE_MODE_CLOSEST |
+							((v == 2) ? RAYTRACE_SORT
+								  : 0),
+						&cp);
+					sum_stats(&st, &stats_buf, ncores, 1);
+
+					mismatch = 0;
+					for (i = 0; i < nsec; i++) {
+						const unsigned j =
+							host ? perm[i] : i;
+						if (v == 0) {
+							ref[i] = hits[i];
+						}
+						mismatch += (hits[i] != ref[j]);
+					}
+					fprintf(stderr,
+						"[raytrace_server] reorder %u-wide "
+						"%-9s | %5.1f fetches %6.0f "
+						"bytes %7llu clocks /ray | %.3f "
+						"Mrays/s | %u mismatches\n",
+						sc->width, name[v],
+						(double)st.fetches / st.rays,
+						(double)st.bytes / st.rays,
+						cp / nsec,
+						(double)NUM_FRAMES * nsec / tr,
+						mismatch);
+				}
+			}
+
+			free(perm);
+			free(ref);
+		}
+
+		// Progressive path tracing in fog on the 4-wide float tree. Each
+		// frame adds PATH_SPP samples per pixel to the float framebuffer.
+		{
+			e_buf_t param_buf, fb_buf, wfb_buf, pstats_buf;
+			path_params_t *pp;
+			float *fb, *wfb;
+			double mean, tw;
+			unsigned long long pc = 0, wc = 0;
+
+			if ((e_arena_alloc(&arena, sizeof(path_params_t), 8, job,
+					   &param_buf) != E_OK) ||
+			    (e_arena_alloc(&arena, nrays * sizeof(float), 64,
+					   job, &fb_buf) != E_OK) ||
+			    (e_arena_alloc(&arena, nrays * sizeof(float), 64,
+					   job, &wfb_buf) != E_OK) ||
+			    (e_arena_alloc(&arena, ncores * sizeof(path_stats_t),
+					   8, job, &pstats_buf) != E_OK)) {
+				fprintf(stderr, "??? out of shared DRAM\n");
+				return EXIT_FAILURE;
+			}
+			pp = (path_params_t *)param_buf.ptr;
+			fb = (float *)fb_buf.ptr;
+			memset(fb, 0, nrays * sizeof(float));
+
+			memset(pp, 0, sizeof(*pp));
+			pp->eye[0] = 0.0f;
+			pp->eye[1] = 0.0f;
+			pp->eye[2] = -5.0f;
+			pp->fov = 0.5f;
+			pp->light[0] = 2.0f;
+			pp->light[1] = 4.0f;
+			pp->light[2] = -2.0f;
+			pp->power = 20.0f;
+			pp->sigma = 0.08f;
+			pp->fog = 0.3f;
+			pp->sky = 0.6f;
+			pp->far = 30.0f;
+			pp->albedo = 0.7f;
+			pp->width = IMAGE_SIZE;
+			pp->height = IMAGE_SIZE;
+			pp->spp = PATH_SPP;
+			pp->depth = 2;
+			pp->fb = fb_buf.off;
+			scene[1].stats = 0;
+
+			t0 = now_usec();
+			for (i = 0; i < PATH_FRAMES; i++) {
+				pp->frame = i;
+				run_path_frame(queues, ncores, param_buf.off,
+					       &fb_buf, nrays,
+					       scene_buf.off + sizeof(scene_t),
+					       RAYTRACE_MODE_PATH, &pc);
+			}
+			t1 = now_usec() - t0;
+
+			mean = 0.0;
+			for (i = 0; i < nrays; i++) {
+				mean += fb[i];
+			}
+			mean /= (double)nrays * PATH_FRAMES * PATH_SPP;
+
+			fprintf(stderr, "[raytrace_server] path: %u frames x %u "
+					"spp, %u bounces, sigma %.2f: %.3f "
+					"Msamples/s, %llu clocks/sample, "
+					"mean %.3f -> %s\n",
+				PATH_FRAMES, PATH_SPP, pp->depth, pp->sigma,
+				(double)PATH_FRAMES * PATH_SPP * nrays / t1,
+				pc / ((unsigned long long)PATH_FRAMES *
+				      PATH_SPP * nrays),
+				mean, PATH_IMAGE);
+			write_pgm(PATH_IMAGE, fb, IMAGE_SIZE, IMAGE_SIZE,
+				  PATH_FRAMES * PATH_SPP);
+
+			// The same frames as a wavefront, with clocks per stage
+			// and the paths still alive at every bounce. Samples
+			// are the same, so the image should be too.
+			{
+				const path_stats_t *pst =
+					(const path_stats_t *)pstats_buf.ptr;
+				path_stats_t sum;
+				unsigned long long stage_sum = 0;
+				float max_diff = 0.0f;
+				unsigned b;
+
+				wfb = (float *)wfb_buf.ptr;
+				memset(wfb, 0, nrays * sizeof(float));
+				memset(pstats_buf.ptr, 0,
+				       ncores * sizeof(path_stats_t));
+				pp->fb = wfb_buf.off;
+				pp->stats = pstats_buf.off;
+
+				t0 = now_usec();
+				for (i = 0; i < PATH_FRAMES; i++) {
+					pp->frame = i;
+					run_path_frame(queues, ncores,
+						       param_buf.off, &wfb_buf,
+						       nrays,
+						       scene_buf.off +
+							       sizeof(scene_t),
+						       RAYTRACE_MODE_WAVEFRONT,
+						       &wc);
+				}
+				tw = now_usec() - t0;
+
+				memset(&sum, 0, sizeof(sum));
+				for (k = 0; k < ncores; k++) {
+					for (b = 0; b < PATH_NUM_STAGES; b++) {
+						sum.clocks[b] += pst[k].clocks[b];
+					}
+					sum.paths += pst[k].paths;
+					for (b = 0; b < PATH_STATS_BOUNCES; b++) {
+						sum.active[b] += pst[k].active[b];
+					}
+				}
+				for (b = 0; b < PATH_NUM_STAGES; b++) {
+					stage_sum += sum.clocks[b];
+				}
+				for (i = 0; i < nrays; i++) {
+					const float d = fabsf(wfb[i] - fb[i]);
+					max_diff = (d > max_diff) ? d : max_diff;
+				}
+				sum.paths = sum.paths ? sum.paths : 1;
+				stage_sum = stage_sum ? stage_sum : 1;
+
+				fprintf(stderr, "[raytrace_server] wavefront: "
+						"%.3f Msamples/s(%.2fx), %llu "
+						"clocks/sample, max diff vs. "
+						"path = %e\n",
+					(double)PATH_FRAMES * PATH_SPP * nrays /
+						tw,
+					t1 / tw, wc / sum.paths, max_diff);
+				fprintf(stderr, "[raytrace_server] wavefront "
+						"clocks/sample: generate %llu"
+						"(%.1f%%), extend %llu(%.1f%%), "
+						"shade %llu(%.1f%%), compact "
+						"%llu(%.1f%%)\n",
+					sum.clocks[0] / sum.paths,
+					100.0 * sum.clocks[0] / stage_sum,
+					sum.clocks[1] / sum.paths,
+					100.0 * sum.clocks[1] / stage_sum,
+					sum.clocks[2] / sum.paths,
+					100.0 * sum.clocks[2] / stage_sum,
+					sum.clocks[3] / sum.paths,
+					100.0 * sum.clocks[3] / stage_sum);
+				fprintf(stderr, "[raytrace_server] wavefront "
+						"active paths per bounce:");
+				for (b = 0; (b <= pp->depth) &&
+					    (b < PATH_STATS_BOUNCES);
+				     b++) {
+					fprintf(stderr, " %.1f%%",
+						100.0 * sum.active[b] /
+							sum.paths);
+				}
+				fprintf(stderr, "\n");
+			}
+		}
+
+		// Instancing: one sphere mesh placed INST_GRID^3 times(scaled
+		// and rotated differently), as a two-level scene and flattened.
+		// Both trace the primary rays and shadow rays from their hits;
+		// the flattened scene is the reference.
+		{
+			const unsigned ninst = INST_GRID * INST_GRID * INST_GRID;
+			const unsigned nflat =
+				ninst * 2 * INST_LON * (INST_LAT - 1);
+			const char *name[2][2] = {{"flat", "flat/occl"},
+						  {"instanced", "inst/occl"}};
+			e_buf_t iscene_buf, bnode_buf, btri_buf, inst_buf;
+			e_buf_t tnode_buf, fnode_buf, ftri_buf, iwide_buf[3];
+			scene_t *isc;
+			instance_t *inst;
+			triangle_t *btris, *ftris;
+			float *ref_closest = malloc(nrays * sizeof(float));
+			float *ref_occluded = malloc(nrays * sizeof(float));
+			unsigned nbtris, nbnodes, ntnodes, nfnodes, w, c;
+			unsigned long long cl[2][2];
+			bvh_stats_t ist[2][2];
+			size_t flat_bytes, inst_bytes;
+
+			if ((e_arena_alloc(&arena, 3 * sizeof(scene_t), 8, job,
+					   &iscene_buf) != E_OK) ||
+			    (e_arena_alloc(&arena,
+					   2 * INST_LAT * INST_LON *
+						   sizeof(triangle_t),
+					   64, job, &btri_buf) != E_OK) ||
+			    (e_arena_alloc(&arena,
+					   4 * INST_LAT * INST_LON *
+						   sizeof(bvh_node_t),
+					   64, job, &bnode_buf) != E_OK) ||
+			    (e_arena_alloc(&arena, ninst * sizeof(instance_t),
+					   64, job, &inst_buf) != E_OK) ||
+			    (e_arena_alloc(&arena,
+					   (2 * ninst - 1) * sizeof(bvh_node_t),
+					   64, job, &tnode_buf) != E_OK) ||
+			    (e_arena_alloc(&arena, nflat * sizeof(triangle_t),
+					   64, job, &ftri_buf) != E_OK) ||
+			    (e_arena_alloc(&arena,
+					   (2 * nflat - 1) * sizeof(bvh_node_t),
+					   64, job, &fnode_buf) != E_OK) ||
+			    (e_arena_alloc(&arena,
+					   2 * INST_LAT * INST_LON *
+						   sizeof(bvh4_node_t),
+					   64, job, &iwide_buf[0]) != E_OK) ||
+			    (e_arena_alloc(&arena, ninst * sizeof(bvh4_node_t),
+					   64, job, &iwide_buf[1]) != E_OK) ||
+			    (e_arena_alloc(&arena, nflat * sizeof(bvh4_node_t),
+					   64, job, &iwide_buf[2]) != E_OK)) {
+				fprintf(stderr, "??? out of shared DRAM\n");
+				return EXIT_FAILURE;
+			}
+			isc = (scene_t *)iscene_buf.ptr;
+			inst = (instance_t *)inst_buf.ptr;
+			btris = (triangle_t *)btri_buf.ptr;
+			ftris = (triangle_t *)ftri_buf.ptr;
+
+			nbtris = make_sphere(btris);
+			nbnodes = bvh_build((bvh_node_t *)bnode_buf.ptr, btris,
+					    nbtris);
+			for (i = 0; i < ninst; i++) {
+				const float step = 3.0f / (INST_GRID - 1);
+				const float pos[3] = {
+					-1.5f + step * (i % INST_GRID),
+					-1.5f + step * (i / INST_GRID % INST_GRID),
+					-1.5f + step * (i / INST_GRID / INST_GRID)};
+				const float scale[3] = {frand(0.2f, 0.45f),
+							frand(0.2f, 0.45f),
+							frand(0.2f, 0.45f)};
+				float m[3][4];
+
+				make_transform(m, scale,
+					       frand(0.0f, 2.0f * (float)M_PI),
+					       pos);
+				instance_init(&inst[i], (const float(*)[4])m,
+					      ((const bvh_node_t *)
+						       bnode_buf.ptr)->bbox,
+					      0);
+				for (k = 0; k < nbtris; k++) {
+					transform_tri(&ftris[i * nbtris + k],
+						      &btris[k],
+						      (const float(*)[4])m);
+				}
+			}
+			ntnodes = tlas_build((bvh_node_t *)tnode_buf.ptr, inst,
+					     ninst);
+			nfnodes = bvh_build((bvh_node_t *)fnode_buf.ptr, ftris,
+					    ninst * nbtris);
+
+			// [0] sphere, [1] instances of [0], [2] flattened.
+			memset(isc, 0, 3 * sizeof(scene_t));
+			isc[0].num_nodes = nbnodes;
+			isc[0].num_tris = nbtris;
+			isc[0].nodes = bnode_buf.off;
+			isc[0].tris = btri_buf.off;
+			isc[0].format = SCENE_TRIS_FLOAT;
+			isc[1].num_nodes = ntnodes;
+			isc[1].num_tris = ninst;
+			isc[1].nodes = tnode_buf.off;
+			isc[1].tris = inst_buf.off;
+			isc[1].format = SCENE_INSTANCES;
+			isc[1].blas = iscene_buf.off;
+			isc[1].num_blas = 1;
+			isc[2].num_nodes = nfnodes;
+			isc[2].num_tris = ninst * nbtris;
+			isc[2].nodes = fnode_buf.off;
+			isc[2].tris = ftri_buf.off;
+			isc[2].format = SCENE_TRIS_FLOAT;
+			for (c = 0; c < 3; c++) {
+				isc[c].width = 2;
+				isc[c].stats = stats_buf.off;
+			}
+
+			flat_bytes = nfnodes * sizeof(bvh_node_t) +
+				     ninst * nbtris * sizeof(triangle_t);
+			inst_bytes = ntnodes * sizeof(bvh_node_t) +
+				     ninst * sizeof(instance_t) +
+				     sizeof(scene_t) +
+				     nbnodes * sizeof(bvh_node_t) +
+				     nbtris * sizeof(triangle_t);
+			fprintf(stderr, "[raytrace_server] instancing: %u x %u "
+					"triangles, flat %u nodes %zu bytes, "
+					"instanced %u + %u nodes %zu bytes"
+					"(%.1f%% saved)\n",
+				ninst, nbtris, nfnodes, flat_bytes, ntnodes,
+				nbnodes, inst_bytes,
+				100.0 * (1.0 - (double)inst_bytes / flat_bytes));
+
+			// Binary, then every tree collapsed to 4-wide.
+			for (w = 0; w < 2; w++) {
+				if (w) {
+					for (c = 0; c < 3; c++) {
+						const e_buf_t *nb =
+							(c == 0) ? &bnode_buf
+							: (c == 1) ? &tnode_buf
+								   : &fnode_buf;
+						isc[c].width = 4;
+						isc[c].nodes = iwide_buf[c].off;
+						isc[c].num_nodes = bvh_collapse(
+							iwide_buf[c].ptr, 4,
+							(const bvh_node_t *)
+								nb->ptr);
+					}
+				}
+				for (c = 0; c < 2; c++) {
+					const scene_t *sc = &isc[2 - c];
+					const uint32_t sc_off =
+						iscene_buf.off +
+						(2 - c) * sizeof(scene_t);
+					unsigned nsh = 0, mismatch = 0;
+
+					memset(stats_buf.ptr, 0,
+					       ncores * sizeof(bvh_stats_t));
+					run_frames(queues, ncores, &ray_buf,
+						   &hit_buf, nrays, sc_off,
+						   maxT.f, RAYTRACE_MODE_CLOSEST,
+						   &cl[c][0]);
+					sum_stats(&ist[c][0], &stats_buf,
+						  ncores, 1);
+					for (i = 0; i < nrays; i++) {
+						if (c == 0) {
+							ref_closest[i] = hits[i];
+						}
+						mismatch +=
+							(fabsf(hits[i] -
+							       ref_closest[i]) >
+							 1.0e-3f * (1.0f +
+								    fabsf(ref_closest[i])));
+					}
+					print_stats(name[c][0], sc->width,
+						    sc->num_nodes, &ist[c][0],
+						    cl[c][0], nrays, mismatch);
+
+					// Shadow rays from the flattened hits.
+					for (i = 0; i < nrays; i++) {
+						if (ref_closest[i] < 0.0f) {
+							continue;
+						}
+						for (k = 0; k < 3; k++) {
+							shadow[nsh].org[k] =
+								rays[i].org[k] +
+								rays[i].dir[k] *
+									ref_closest[i] *
+									0.9999f;
+							shadow[nsh].dir[k] =
+								light[k];
+						}
+						nsh++;
+					}
+					run_frames(queues, ncores, &shadow_buf,
+						   &occl_buf, nsh, sc_off,
+						   maxT.f, RAYTRACE_MODE_OCCLUDED,
+						   &cl[c][1]);
+					sum_stats(&ist[c][1], &stats_buf,
+						  ncores, 1);
+					mismatch = 0;
+					for (i = 0; i < nsh; i++) {
+						if (c == 0) {
+							ref_occluded[i] = occl[i];
+						}
+						mismatch += (occl[i] !=
+							     ref_occluded[i]);
+					}
+					print_stats(name[c][1], sc->width,
+						    sc->num_nodes, &ist[c][1],
+						    cl[c][1], nsh, mismatch);
+				}
+				fprintf(stderr, "[raytrace_server] instancing "
+						"%u-wide overhead: closest "
+						"%.2fx steps %.2fx bytes %.2fx "
+						"clocks, occluded %.2fx steps "
+						"%.2fx bytes %.2fx clocks\n",
+					isc[1].width,
+					(double)ist[1][0].steps / ist[0][0].steps,
+					(double)ist[1][0].bytes / ist[0][0].bytes,
+					(double)cl[1][0] / cl[0][0],
+					(double)ist[1][1].steps / ist[0][1].steps,
+					(double)ist[1][1].bytes / ist[0][1].bytes,
+					(double)cl[1][1] / cl[0][1]);
+			}
+
+			free(ref_closest);
+			free(ref_occluded);
+		}
+
+		e_arena_free_job(&arena, job);
+	}
+
+	for (i = 0; i < ncores; i++) {
+		e_cmd_t cmd;
+		e_cmpl_t cmpl;
+		memset(&cmd, 0, sizeof(cmd));
+		cmd.op = E_CMD_QUIT;
+		while (e_cmdq_post(&queues[i], &cmd) != 0) {
+		}
+		wait_one(&queues[i], &cmpl);
+	}
+
+#if E_TRACE
+	if (e_trace_write_json(TRACE_JSON, tmem.base, ncores, platform.cols,
+			       E_TRACE_CLOCK_MHZ) == 0) {
+		fprintf(stderr, "[raytrace_server] trace -> %s\n", TRACE_JSON);
+	}
+	e_free(&tmem);
+#endif
+	e_close(&dev);
+	e_arena_free_job(&arena, 0);
+	e_arena_destroy(&arena);
+	e_free(&qmem);
+	e_finalize();
+
+	return 0;
+}
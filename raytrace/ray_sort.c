@@ -0,0 +1,132 @@
+//
+// Ray reordering(host), see ray_sort() in raytrace.h.
+//
+// LSD radix sort of(key, index) pairs, 8 bits per pass over the 30 key bits.
+// Every thread owns a slice of the input: it counts its digits, waits for the
+// others, derives its own output offsets from all counts and scatters its
+// slice, so each pass is stable without any locking.
+//
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "raytrace.h"
+
+#define SORT_MAX_THREADS (16)
+#define SORT_BITS (8)
+#define SORT_BUCKETS (1 << SORT_BITS)
+#define SORT_KEY_BITS (30)
+
+typedef struct {
+	unsigned int key;
+	unsigned int index;
+} sort_item_t;
+
+typedef struct {
+	sort_item_t *src, *dst;
+	unsigned int n, nthreads;
+	unsigned int count[SORT_MAX_THREADS][SORT_BUCKETS];
+	pthread_barrier_t barrier;
+} sort_ctx_t;
+
+typedef struct {
+	sort_ctx_t *ctx;
+	unsigned int t;
+	const ray_t *rays;
+	const float (*bounds)[3];
+	pthread_t thread;
+} sort_worker_t;
+
+static void *sort_worker(void *arg)
+{
+	sort_worker_t *w = (sort_worker_t *)arg;
+	sort_ctx_t *c = w->ctx;
+	sort_item_t *src = c->src, *dst = c->dst;
+	const unsigned int begin = (unsigned long long)c->n * w->t / c->nthreads;
+	const unsigned int end =
+		(unsigned long long)c->n * (w->t + 1) / c->nthreads;
+	unsigned int shift, i, d, t;
+
+	for (i = begin; i < end; i++) {
+		src[i].key = ray_sort_key(&w->rays[i], w->bounds);
+		src[i].index = i;
+	}
+
+	for (shift = 0; shift < SORT_KEY_BITS; shift += SORT_BITS) {
+		unsigned int *count = c->count[w->t];
+		unsigned int offset[SORT_BUCKETS], sum = 0;
+		sort_item_t *tmp;
+
+		memset(count, 0, SORT_BUCKETS * sizeof(unsigned int));
+		for (i = begin; i < end; i++) {
+			count[(src[i].key >> shift) & (SORT_BUCKETS - 1)]++;
+		}
+		pthread_barrier_wait(&c->barrier);
+
+		// Digit d of thread t goes after all smaller digits and after
+		// digit d of threads before t.
+		for (d = 0; d < SORT_BUCKETS; d++) {
+			for (t = 0; t < c->nthreads; t++) {
+				if (t == w->t) {
+					offset[d] = sum;
+				}
+				sum += c->count[t][d];
+			}
+		}
+		for (i = begin; i < end; i++) {
+			const sort_item_t it = src[i];
+			dst[offset[(it.key >> shift) &
+				      (SORT_BUCKETS - 1)]++] = it;
+		}
+		pthread_barrier_wait(&c->barrier);
+
+		tmp = src;
+		src = dst;
+		dst = tmp;
+	}
+	return NULL;
+}
+
+void ray_sort(ray_t *rays, unsigned int *perm, unsigned int n,
+	      const float bounds[2][3], unsigned int nthreads)
+{
+	sort_worker_t workers[SORT_MAX_THREADS];
+	sort_item_t *a = malloc(n * sizeof(sort_item_t));
+	sort_item_t *b = malloc(n * sizeof(sort_item_t));
+	ray_t *tmp = malloc(n * sizeof(ray_t));
+	sort_ctx_t *c = malloc(sizeof(sort_ctx_t));
+	unsigned int i;
+
+	nthreads = (nthreads < 1) ? 1 : nthreads;
+	nthreads = (nthreads > SORT_MAX_THREADS) ? SORT_MAX_THREADS : nthreads;
+	c->src = a;
+	c->dst = b;
+	c->n = n;
+	c->nthreads = nthreads;
+	pthread_barrier_init(&c->barrier, NULL, nthreads);
+
+	for (i = 0; i < nthreads; i++) {
+		workers[i].ctx = c;
+		workers[i].t = i;
+		workers[i].rays = rays;
+		workers[i].bounds = bounds;
+		pthread_create(&workers[i].thread, NULL, sort_worker,
+			       &workers[i]);
+	}
+	for (i = 0; i < nthreads; i++) {
+		pthread_join(workers[i].thread, NULL);
+	}
+
+	// Even number of passes: the result is back in `a`.
+	memcpy(tmp, rays, n * sizeof(ray_t));
+	for (i = 0; i < n; i++) {
+		perm[i] = a[i].index;
+		rays[i] = tmp[a[i].index];
+	}
+
+	pthread_barrier_destroy(&c->barrier);
+	free(c);
+	free(tmp);
+	free(b);
+	free(a);
+}
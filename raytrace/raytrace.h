@@ -0,0 +1,406 @@
+//
+// Shared definitions for the ray tracing kernel and its host programs.
+//
+#ifndef RAYTRACE_H_
+#define RAYTRACE_H_
+
+// GCC
+#define RESTRICT __restrict__
+
+// Ray as stored in shared DRAM for E_CMD_TRACE jobs.
+typedef struct {
+	float org[3];
+	float dir[3];
+} ray_t;
+
+// Triangle with precomputed edges(v1 = v0 + e1, v2 = v0 + e2). 36 bytes.
+typedef struct {
+	float v0[3];
+	float e1[3];
+	float e2[3];
+} triangle_t;
+
+#define BVH_MAX_LEAF_SIZE (4)
+#define BVH_MAX_DEPTH (64) // traversal stack size
+
+// Binary BVH node, 32 bytes. Children of an inner node are stored next to
+// each other at `first` and `first + 1`, a leaf holds triangles
+// [first, first + count). Nodes are in breadth-first order, so the first N
+// nodes are the top levels of the tree.
+typedef struct {
+	float bbox[2][3];
+	unsigned int first;
+	unsigned int count; // 0 for inner nodes
+} bvh_node_t;
+
+// Quantized leaf(bvh_quantize.c), variable size, 4 byte aligned:
+//
+//   qleaf_t                        28 bytes
+//   unsigned short vert[nv][3]     6 bytes per unique vertex
+//   unsigned short tri[nt]         i0 | i1 << 4 | i2 << 8
+//
+// Vertices are 16 bit fractions of the leaf bounds(v = org + q * scale) and
+// shared by the triangles of the leaf. With quantized leaves the `first` of a
+// BVH leaf is the offset of its qleaf_t in 4 byte words.
+typedef struct {
+	float org[3];
+	float scale[3]; // (max - min) / 65535
+	unsigned short num_verts;
+	unsigned short num_tris;
+} qleaf_t;
+
+#define QLEAF_MAX_VERTS (3 * BVH_MAX_LEAF_SIZE) // must fit in 4 bits
+#define QLEAF_MAX_BYTES                                                   \
+	((sizeof(qleaf_t) + 6 * QLEAF_MAX_VERTS + 2 * BVH_MAX_LEAF_SIZE + 3) & \
+	 ~3u)
+
+// 4 and 8 wide BVH nodes(bvh_collapse()), child boxes as SoA for
+// ray_aabb4(). child[i] is a node index, or BVH_WIDE_LEAF | count << 24 |
+// first triangle. Unused slots have an inverted box, which never hits.
+#define BVH_WIDE_LEAF (0x80000000)
+#define BVH_WIDE_EMPTY (0xffffffff)
+
+typedef struct {
+	float bbox[2][3][4];
+	unsigned int child[4];
+} bvh4_node_t; // 112 bytes
+
+typedef struct {
+	float bbox[2][3][8];
+	unsigned int child[8];
+} bvh8_node_t; // 224 bytes
+
+// Traversal counters, summed over a job.
+typedef struct {
+	unsigned int rays;
+	unsigned int steps; // nodes visited
+	unsigned int box_tests;
+	unsigned int tri_tests;
+	unsigned int bytes; // node and triangle bytes read from shared DRAM
+	unsigned int fetches; // nodes read from shared DRAM
+	unsigned int pad[2];
+} bvh_stats_t;
+
+// Scene as stored in shared DRAM. Offsets are shared DRAM offsets.
+typedef struct {
+	unsigned int num_nodes;
+	unsigned int num_tris;
+	unsigned int nodes; // bvh_node_t/bvh4_node_t/bvh8_node_t[num_nodes]
+	unsigned int tris;  // triangle_t[num_tris], in BVH leaf order
+	unsigned int width; // 2, 4 or 8
+	unsigned int stats; // bvh_stats_t per core(group order) or 0
+	unsigned int format; // SCENE_TRIS_*
+	unsigned int cache; // 1: keep shared DRAM nodes in a local cache
+	unsigned int blas;  // SCENE_INSTANCES: scene_t[num_blas]
+	unsigned int num_blas;
+} scene_t;
+
+enum {
+	SCENE_TRIS_FLOAT = 0, // tris is triangle_t[]
+	SCENE_TRIS_QUANT = 1, // tris is qleaf_t blocks
+	// Two-level: nodes is a BVH over instances(tlas_build()), tris is
+	// instance_t[num_tris] and every instance traces one of the blas
+	// scenes, which must not be instanced themselves.
+	SCENE_INSTANCES = 2,
+};
+
+#define SCENE_MAX_BLAS (4)
+
+// Placed copy of a bottom level scene. The ray is moved into object space
+// (p' = M p + c, with c in column 3) and traced there, so distances carry
+// over as they are. 80 bytes.
+typedef struct {
+	float to_object[3][4]; // world to object
+	float bbox[2][3];      // world bounds, for tlas_build()
+	unsigned int blas;     // index into scene_t.blas
+	unsigned int pad;
+} instance_t;
+
+// E_CMD_TRACE job layout:
+//   src    : ray_t[count]
+//   dst    : float[count]
+//   arg[0] : shared DRAM offset of the scene, see arg[2]
+//   arg[1] : maxT as float bits
+//   arg[2] : RAYTRACE_MODE_* | RAYTRACE_SORT
+enum {
+	// arg[0] = float bbox[2][3]. dst = entry distance or -1.0 for miss.
+	RAYTRACE_MODE_AABB = 0,
+	// arg[0] = scene_t. dst = nearest hit distance or -1.0 for miss.
+	RAYTRACE_MODE_CLOSEST = 1,
+	// arg[0] = scene_t. Shadow rays, dst = 0.0 when anything is hit
+	// before maxT, -1.0 otherwise.
+	RAYTRACE_MODE_OCCLUDED = 2,
+	// arg[0] = scene_t, src = path_params_t. No rays: dst points into the
+	// framebuffer at pixel (dst - fb) / 4 and `count` pixels get spp new
+	// path samples added. arg[1] is unused.
+	RAYTRACE_MODE_PATH = 3,
+	// RAYTRACE_MODE_PATH run as a wavefront(path_wavefront()), same
+	// samples and image.
+	RAYTRACE_MODE_WAVEFRONT = 4,
+};
+
+// Traces every chunk of rays in ray_sort_key() order(bounds of the chunk),
+// results still go to the ray's own slot. For small batches, larger ones are
+// better sorted on the host with ray_sort().
+#define RAYTRACE_SORT (0x100)
+#define RAYTRACE_MODE_MASK (0xff)
+
+// Sort key: direction octant(raydirsign) in bits 27..29 above a 27 bit
+// Morton code of the origin in `bounds`, 9 bits per axis.
+static inline unsigned int ray_morton_bits(unsigned int x)
+{
+	x &= 0x1ff;
+	x = (x | (x << 16)) & 0x030000ff;
+	x = (x | (x << 8)) & 0x0300f00f;
+	x = (x | (x << 4)) & 0x030c30c3;
+	x = (x | (x << 2)) & 0x09249249;
+	return x;
+}
+
+static inline unsigned int ray_sort_key(const ray_t *ray,
+					const float bounds[2][3])
+{
+	unsigned int key = 0, q[3];
+	int k;
+
+	for (k = 0; k < 3; k++) {
+		const float ext = bounds[1][k] - bounds[0][k];
+		float f = (ext > 0.0f) ? (ray->org[k] - bounds[0][k]) / ext
+				       : 0.0f;
+		f = (f < 0.0f) ? 0.0f : (f > 1.0f) ? 1.0f : f;
+		q[k] = (unsigned int)(f * 511.0f);
+		key |= (ray->dir[k] >= 0.0f) ? (1u << (27 + k)) : 0;
+	}
+	return key | (ray_morton_bits(q[0]) << 2) |
+	       (ray_morton_bits(q[1]) << 1) | ray_morton_bits(q[2]);
+}
+
+// RAYTRACE_MODE_PATH parameters(e_path.cc), in shared DRAM. Pinhole camera
+// looking down +z, diffuse surfaces, one point light, homogeneous fog.
+typedef struct {
+	float eye[3];
+	float fov;	    // tan(vertical half angle)
+	float light[3];	    // point light position
+	float power;	    // light intensity
+	float sigma;	    // medium extinction, per unit length
+	float fog;	    // radiance scattered by the medium towards the ray
+	float sky;	    // radiance of rays leaving the scene
+	float far;	    // medium extent, length of escaping segments
+	float albedo;	    // surfaces
+	unsigned int width;
+	unsigned int height;
+	unsigned int frame; // progressive frame, seeds the samples
+	unsigned int spp;   // samples per pixel per job
+	unsigned int depth; // bounces
+	unsigned int fb;    // framebuffer offset, float[width * height] sums
+	unsigned int stats; // path_stats_t per core(group order) or 0
+} path_params_t;
+
+// Wavefront stages, see path_wavefront().
+enum {
+	PATH_STAGE_GENERATE = 0,
+	PATH_STAGE_EXTEND = 1,
+	PATH_STAGE_SHADE = 2,
+	PATH_STAGE_COMPACT = 3,
+	PATH_NUM_STAGES = 4,
+};
+
+#define PATH_STATS_BOUNCES (8) // deeper bounces count as the last one
+
+// RAYTRACE_MODE_WAVEFRONT counters, summed over jobs like bvh_stats_t.
+typedef struct {
+	unsigned long long clocks[PATH_NUM_STAGES];
+	unsigned int paths; // generated
+	unsigned int active[PATH_STATS_BOUNCES]; // paths entering bounce i
+	unsigned int pad[3];
+} path_stats_t;
+
+#ifdef __cplusplus
+
+// rayov = -rayorg * rayinvdir
+// raydirsign[i] = (raydir[i] >= 0.0f) ? 1 : 0
+char ray_aabb(float outT[2], float maxT, const float bbox[2][3],
+	      const float rayov[3], const float rayinvdir[3],
+	      const char raydirsign[3]);
+
+// Four boxes at once, bbox[(a * 3 + k) * stride + i] is bound a(0: min,
+// 1: max) on axis k of box i. Returns the hit mask, bit i for box i, and
+// the entry distances in outT.
+unsigned int ray_aabb4(float outT[4], float maxT, const float *bbox,
+		       unsigned int stride, const float rayov[3],
+		       const float rayinvdir[3], const char raydirsign[3]);
+
+// ray_aabb() without the entry/exit distances.
+char ray_aabb_hit(float maxT, const float bbox[2][3], const float rayov[3],
+		  const float rayinvdir[3], const char raydirsign[3]);
+
+// Ray with everything the box and triangle tests need.
+typedef struct {
+	float org[3];
+	float dir[3];
+	float invdir[3];
+	float ov[3];
+	char dirsign[3];
+} ray_pre_t;
+
+void ray_setup(ray_pre_t *r, const ray_t *ray);
+
+// Moller-Trumbore. Returns 1 and sets *t when hit in (0, maxT).
+char ray_triangle(float *t, float maxT, const triangle_t *tri,
+		  const ray_pre_t *r);
+
+// Division-free ray_triangle() without the distance.
+char ray_triangle_hit(float maxT, const triangle_t *tri, const ray_pre_t *r);
+
+// Expands a quantized leaf into tris[num_tris]. Returns the leaf size in
+// bytes.
+unsigned int qleaf_decode(triangle_t *tris, const qleaf_t *leaf);
+
+// e_bvh.cc. Nodes [0, num_local) are read from `local`, the rest from
+// `nodes`(usually shared DRAM). `stats` may be NULL. Every kernel also takes
+// quantized leaves(const qleaf_t *) in place of `tris`.
+//
+// Closest hit: front-to-back, returns the nearest distance or -1.0f. `normal`
+// (may be NULL) gets the unnormalized geometric normal(e1 x e2) of the hit
+// triangle.
+float bvh_closest(const ray_pre_t *r, float maxT, const bvh_node_t *local,
+		  unsigned int num_local, const bvh_node_t *nodes,
+		  const triangle_t *tris, bvh_stats_t *stats,
+		  float *normal = 0);
+
+// Any hit: returns 1 on the first hit found before maxT. Children are not
+// ordered and no distances are kept.
+char bvh_occluded(const ray_pre_t *r, float maxT, const bvh_node_t *local,
+		  unsigned int num_local, const bvh_node_t *nodes,
+		  const triangle_t *tris, bvh_stats_t *stats);
+
+// Same on 4/8 wide nodes.
+float bvh4_closest(const ray_pre_t *r, float maxT, const bvh4_node_t *local,
+		   unsigned int num_local, const bvh4_node_t *nodes,
+		   const triangle_t *tris, bvh_stats_t *stats,
+		   float *normal = 0);
+char bvh4_occluded(const ray_pre_t *r, float maxT, const bvh4_node_t *local,
+		   unsigned int num_local, const bvh4_node_t *nodes,
+		   const triangle_t *tris, bvh_stats_t *stats);
+float bvh8_closest(const ray_pre_t *r, float maxT, const bvh8_node_t *local,
+		   unsigned int num_local, const bvh8_node_t *nodes,
+		   const triangle_t *tris, bvh_stats_t *stats,
+		   float *normal = 0);
+char bvh8_occluded(const ray_pre_t *r, float maxT, const bvh8_node_t *local,
+		   unsigned int num_local, const bvh8_node_t *nodes,
+		   const triangle_t *tris, bvh_stats_t *stats);
+
+float bvh_closest(const ray_pre_t *r, float maxT, const bvh_node_t *local,
+		  unsigned int num_local, const bvh_node_t *nodes,
+		  const qleaf_t *leaves, bvh_stats_t *stats,
+		  float *normal = 0);
+char bvh_occluded(const ray_pre_t *r, float maxT, const bvh_node_t *local,
+		  unsigned int num_local, const bvh_node_t *nodes,
+		  const qleaf_t *leaves, bvh_stats_t *stats);
+float bvh4_closest(const ray_pre_t *r, float maxT, const bvh4_node_t *local,
+		   unsigned int num_local, const bvh4_node_t *nodes,
+		   const qleaf_t *leaves, bvh_stats_t *stats,
+		   float *normal = 0);
+char bvh4_occluded(const ray_pre_t *r, float maxT, const bvh4_node_t *local,
+		   unsigned int num_local, const bvh4_node_t *nodes,
+		   const qleaf_t *leaves, bvh_stats_t *stats);
+float bvh8_closest(const ray_pre_t *r, float maxT, const bvh8_node_t *local,
+		   unsigned int num_local, const bvh8_node_t *nodes,
+		   const qleaf_t *leaves, bvh_stats_t *stats,
+		   float *normal = 0);
+char bvh8_occluded(const ray_pre_t *r, float maxT, const bvh8_node_t *local,
+		   unsigned int num_local, const bvh8_node_t *nodes,
+		   const qleaf_t *leaves, bvh_stats_t *stats);
+
+// Direct mapped cache of shared DRAM nodes(scene_t.cache): 64 binary, 16
+// 4-wide or 8 8-wide nodes, by node index. bvh_cache_clear() before a scene
+// is traced with it. Leaves are not cached.
+#define BVH_CACHE_BYTES (2048)
+#define BVH_CACHE_LINES (64)
+
+typedef struct {
+	unsigned int tag[BVH_CACHE_LINES]; // node index + 1, 0 when empty
+	unsigned long long line[BVH_CACHE_BYTES / 8];
+} bvh_cache_t;
+
+void bvh_cache_clear(bvh_cache_t *cache);
+
+// scene_t as a kernel sees it: offsets resolved, nodes [0, num_local) copied
+// to `local`.
+typedef struct scene_view {
+	unsigned int width;  // 2, 4 or 8
+	unsigned int format; // SCENE_TRIS_*
+	unsigned int num_local;
+	const void *local;
+	const void *nodes;
+	const void *tris;
+	bvh_stats_t *stats; // may be NULL
+	bvh_cache_t *cache; // may be NULL
+	const struct scene_view *blas; // SCENE_INSTANCES, num_local = 0
+} scene_view_t;
+
+// The kernels above picked by width and format.
+float scene_closest(const scene_view_t *s, const ray_pre_t *r, float maxT,
+		    float *normal);
+char scene_occluded(const scene_view_t *s, const ray_pre_t *r, float maxT);
+
+// e_path.cc. Adds p->spp path samples of pixels [first, first + count) to
+// accum[0, count).
+void path_trace(float *accum, unsigned int first, unsigned int count,
+		const path_params_t *p, const scene_view_t *s);
+
+// Same samples as path_trace(), one stage at a time over all paths of the
+// chunk(count <= PATH_WAVE): generate camera rays, extend(closest hit),
+// shade(medium, direct light, next direction), compact the survivors to the
+// front of the SoA buffers. `stats` may be NULL.
+#define PATH_WAVE (64)
+void path_wavefront(float *accum, unsigned int first, unsigned int count,
+		    const path_params_t *p, const scene_view_t *s,
+		    path_stats_t *stats);
+
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// bvh_build.c(host). Reorders `tris` into leaf order and writes up to
+// 2 * num_tris - 1 nodes. Returns the number of nodes.
+unsigned int bvh_build(bvh_node_t *nodes, triangle_t *tris,
+		       unsigned int num_tris);
+
+// bvh_collapse.c(host). Collapses a binary BVH into `width`(4 or 8) wide
+// nodes, breadth-first like bvh_build(). `out` is bvh4_node_t[] or
+// bvh8_node_t[] with room for one node per inner binary node. Returns the
+// number of wide nodes.
+unsigned int bvh_collapse(void *out, unsigned int width,
+			  const bvh_node_t *nodes);
+
+// bvh_quantize.c(host). Writes one qleaf_t block per leaf of `nodes` to
+// `out`(room for QLEAF_MAX_BYTES per leaf) and points the leaves at them.
+// Collapse after quantizing to get wide trees over the same blocks. Returns
+// the bytes written.
+unsigned int bvh_quantize(void *out, bvh_node_t *nodes,
+			  unsigned int num_nodes, const triangle_t *tris);
+
+// tlas_build.c(host). Sets inst->to_object from the object to world
+// transform and inst->bbox from the bounds of the instanced scene.
+void instance_init(instance_t *inst, const float to_world[3][4],
+		   const float bounds[2][3], unsigned int blas);
+
+// Binary BVH over instances, one per leaf, laid out like bvh_build(). Reorders
+// `inst` into leaf order and writes up to 2 * num_inst - 1 nodes. Returns the
+// number of nodes.
+unsigned int tlas_build(bvh_node_t *nodes, instance_t *inst,
+			unsigned int num_inst);
+
+// ray_sort.c(host). Sorts rays[0, n) by ray_sort_key(), LSD radix sort over
+// `nthreads` threads. perm[i] gets the old index of rays[i].
+void ray_sort(ray_t *rays, unsigned int *perm, unsigned int n,
+	      const float bounds[2][3], unsigned int nthreads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RAYTRACE_H_
@@ -0,0 +1,144 @@
+//
+// Top level BVH over instances, host side.
+//
+// Instances are few and each leaf costs a whole bottom level traversal, so
+// every instance gets its own leaf and ranges are split at the median of the
+// widest centroid axis. Nodes are emitted breadth-first like bvh_build().
+//
+#include <float.h>
+#include <string.h>
+
+#include "raytrace.h"
+
+static float centroid(const instance_t *inst, int axis)
+{
+	return 0.5f * (inst->bbox[0][axis] + inst->bbox[1][axis]);
+}
+
+void instance_init(instance_t *inst, const float to_world[3][4],
+		   const float bounds[2][3], unsigned int blas)
+{
+	const float(*m)[4] = to_world;
+	float inv[3][3], det;
+	unsigned int c;
+	int j, k;
+
+	// Inverse of the 3x3 part by cofactors.
+	inv[0][0] = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+	inv[0][1] = m[0][2] * m[2][1] - m[0][1] * m[2][2];
+	inv[0][2] = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+	inv[1][0] = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+	inv[1][1] = m[0][0] * m[2][2] - m[0][2] * m[2][0];
+	inv[1][2] = m[0][2] * m[1][0] - m[0][0] * m[1][2];
+	inv[2][0] = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+	inv[2][1] = m[0][1] * m[2][0] - m[0][0] * m[2][1];
+	inv[2][2] = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+	det = m[0][0] * inv[0][0] + m[0][1] * inv[1][0] + m[0][2] * inv[2][0];
+
+	memset(inst, 0, sizeof(*inst));
+	for (j = 0; j < 3; j++) {
+		for (k = 0; k < 3; k++) {
+			inst->to_object[j][k] = inv[j][k] / det;
+		}
+	}
+	for (j = 0; j < 3; j++) {
+		inst->to_object[j][3] = -(inst->to_object[j][0] * m[0][3] +
+					  inst->to_object[j][1] * m[1][3] +
+					  inst->to_object[j][2] * m[2][3]);
+	}
+	inst->blas = blas;
+
+	// World bounds of the 8 transformed corners.
+	for (k = 0; k < 3; k++) {
+		inst->bbox[0][k] = FLT_MAX;
+		inst->bbox[1][k] = -FLT_MAX;
+	}
+	for (c = 0; c < 8; c++) {
+		const float p[3] = {bounds[c & 1][0], bounds[(c >> 1) & 1][1],
+				    bounds[c >> 2][2]};
+		for (j = 0; j < 3; j++) {
+			const float w = m[j][0] * p[0] + m[j][1] * p[1] +
+					m[j][2] * p[2] + m[j][3];
+			inst->bbox[0][j] = (w < inst->bbox[0][j]) ? w
+								  : inst->bbox[0][j];
+			inst->bbox[1][j] = (w > inst->bbox[1][j]) ? w
+								  : inst->bbox[1][j];
+		}
+	}
+}
+
+// Insertion sort on one axis, ranges are small.
+static void sort_axis(instance_t *inst, unsigned int count, int axis)
+{
+	unsigned int i, j;
+
+	for (i = 1; i < count; i++) {
+		const instance_t t = inst[i];
+		const float c = centroid(&t, axis);
+		for (j = i; (j > 0) && (centroid(&inst[j - 1], axis) > c); j--) {
+			inst[j] = inst[j - 1];
+		}
+		inst[j] = t;
+	}
+}
+
+unsigned int tlas_build(bvh_node_t *nodes, instance_t *inst,
+			unsigned int num_inst)
+{
+	unsigned int num_nodes = 1;
+	unsigned int i, k;
+	int j;
+
+	memset(nodes, 0, sizeof(bvh_node_t));
+	nodes[0].first = 0;
+	nodes[0].count = num_inst;
+
+	for (i = 0; i < num_nodes; i++) {
+		bvh_node_t *node = &nodes[i];
+		const unsigned int first = node->first;
+		const unsigned int count = node->count;
+		float cbox[2][3];
+		int axis = 0;
+
+		for (j = 0; j < 3; j++) {
+			node->bbox[0][j] = cbox[0][j] = FLT_MAX;
+			node->bbox[1][j] = cbox[1][j] = -FLT_MAX;
+		}
+		for (k = first; k < first + count; k++) {
+			for (j = 0; j < 3; j++) {
+				const float c = centroid(&inst[k], j);
+				node->bbox[0][j] = (inst[k].bbox[0][j] <
+						    node->bbox[0][j])
+							   ? inst[k].bbox[0][j]
+							   : node->bbox[0][j];
+				node->bbox[1][j] = (inst[k].bbox[1][j] >
+						    node->bbox[1][j])
+							   ? inst[k].bbox[1][j]
+							   : node->bbox[1][j];
+				cbox[0][j] = (c < cbox[0][j]) ? c : cbox[0][j];
+				cbox[1][j] = (c > cbox[1][j]) ? c : cbox[1][j];
+			}
+		}
+		if (count <= 1) {
+			continue;
+		}
+
+		for (j = 1; j < 3; j++) {
+			if (cbox[1][j] - cbox[0][j] >
+			    cbox[1][axis] - cbox[0][axis]) {
+				axis = j;
+			}
+		}
+		sort_axis(inst + first, count, axis);
+
+		nodes[num_nodes].first = first;
+		nodes[num_nodes].count = count / 2;
+		nodes[num_nodes + 1].first = first + count / 2;
+		nodes[num_nodes + 1].count = count - count / 2;
+		node->first = num_nodes;
+		node->count = 0;
+		num_nodes += 2;
+	}
+
+	return num_nodes;
+}